@@ -22,7 +22,7 @@ void ClangTidyCheckFactories::registerCheckFactory(StringRef Name,
 
 void ClangTidyCheckFactories::createChecks(
     ClangTidyContext *Context,
-    std::vector<std::unique_ptr<ClangTidyCheck>> &Checks) {
+    std::vector<std::unique_ptr<ClangTidyCheck>> &Checks) const {
   for (const auto &Factory : Factories) {
     if (Context->isCheckEnabled(Factory.first))
       Checks.emplace_back(Factory.second(Factory.first, Context));
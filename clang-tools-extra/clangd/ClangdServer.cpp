@@ -160,9 +160,13 @@ void ClangdServer::addDocument(PathRef File, llvm::StringRef Contents,
   Inputs.Opts = std::move(Opts);
   Inputs.Index = Index;
   bool NewFile = WorkScheduler.update(File, Inputs, WantDiags);
-  // If we loaded Foo.h, we want to make sure Foo.cpp is indexed.
-  if (NewFile && BackgroundIdx)
-    BackgroundIdx->boostRelated(File);
+  if (BackgroundIdx) {
+    // The user is editing, let the file be rebuilt before indexing more.
+    BackgroundIdx->pauseForUserActivity();
+    // If we loaded Foo.h, we want to make sure Foo.cpp is indexed.
+    if (NewFile)
+      BackgroundIdx->boostRelated(File);
+  }
 }
 
 void ClangdServer::removeDocument(PathRef File) { WorkScheduler.remove(File); }
@@ -174,6 +178,8 @@ llvm::StringRef ClangdServer::getDocument(PathRef File) const {
 void ClangdServer::codeComplete(PathRef File, Position Pos,
                                 const clangd::CodeCompleteOptions &Opts,
                                 Callback<CodeCompleteResult> CB) {
+  if (BackgroundIdx)
+    BackgroundIdx->pauseForUserActivity();
   // Copy completion options for passing them to async task handler.
   auto CodeCompleteOpts = Opts;
   if (!CodeCompleteOpts.Index) // Respect overridden index.
@@ -211,7 +217,12 @@ void ClangdServer::codeComplete(PathRef File, Position Pos,
         CodeCompleteOpts, SpecFuzzyFind ? SpecFuzzyFind.getPointer() : nullptr);
     {
       clang::clangd::trace::Span Tracer("Completion results callback");
-      CB(std::move(Result));
+      // The request may have been cancelled while we were running Sema, e.g.
+      // because the user kept typing. Don't send stale results in that case.
+      if (isCancelled())
+        CB(llvm::make_error<CancelledError>());
+      else
+        CB(std::move(Result));
     }
     if (SpecFuzzyFind && SpecFuzzyFind->NewReq.hasValue()) {
       std::lock_guard<std::mutex> Lock(CachedCompletionFuzzyFindRequestMutex);
@@ -283,6 +283,19 @@ void dumpAST(ParsedAST &AST, llvm::raw_ostream &OS) {
   AST.getASTContext().getTranslationUnitDecl()->dump(OS, true);
 }
 
+/// Returns the check factories of all the clang-tidy modules linked in. They
+/// don't depend on the file, so they are only collected once, rather than on
+/// every AST build.
+static const tidy::ClangTidyCheckFactories &getClangTidyCheckFactories() {
+  static const tidy::ClangTidyCheckFactories *Factories = [] {
+    auto *CTFactories = new tidy::ClangTidyCheckFactories;
+    for (const auto &E : tidy::ClangTidyModuleRegistry::entries())
+      E.instantiate()->addCheckFactories(*CTFactories);
+    return CTFactories;
+  }();
+  return *Factories;
+}
+
 llvm::Optional<ParsedAST>
 ParsedAST::build(std::unique_ptr<CompilerInvocation> CI,
                  std::shared_ptr<const PreambleData> Preamble,
@@ -325,15 +338,13 @@ ParsedAST::build(std::unique_ptr<CompilerInvocation> CI,
     trace::Span Tracer("ClangTidyInit");
     dlog("ClangTidy configuration for file {0}: {1}", MainInput.getFile(),
          tidy::configurationAsText(Opts.ClangTidyOpts));
-    tidy::ClangTidyCheckFactories CTFactories;
-    for (const auto &E : tidy::ClangTidyModuleRegistry::entries())
-      E.instantiate()->addCheckFactories(CTFactories);
     CTContext.emplace(llvm::make_unique<tidy::DefaultOptionsProvider>(
         tidy::ClangTidyGlobalOptions(), Opts.ClangTidyOpts));
     CTContext->setDiagnosticsEngine(&Clang->getDiagnostics());
     CTContext->setASTContext(&Clang->getASTContext());
     CTContext->setCurrentFile(MainInput.getFile());
-    CTFactories.createChecks(CTContext.getPointer(), CTChecks);
+    getClangTidyCheckFactories().createChecks(CTContext.getPointer(),
+                                              CTChecks);
     ASTDiags.setLevelAdjuster([&CTContext](DiagnosticsEngine::Level DiagLevel,
                                            const clang::Diagnostic &Info) {
       if (CTContext) {
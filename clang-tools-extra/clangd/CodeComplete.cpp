@@ -19,6 +19,7 @@
 
 #include "CodeComplete.h"
 #include "AST.h"
+#include "Cancellation.h"
 #include "ClangdUnit.h"
 #include "CodeCompletionStrings.h"
 #include "Compiler.h"
@@ -1437,6 +1438,10 @@ private:
     //        explicitly request symbols corresponding to Sema results.
     //        We can use their signals even if the index can't suggest them.
     // We must copy index results to preserve them, but there are at most Limit.
+    // Parsing may have taken long enough for the client to give up on this
+    // request; in that case nobody will see the results, so skip the index.
+    if (isCancelled())
+      return CodeCompleteResult();
     auto IndexResults = (Opts.Index && allowIndex(Recorder->CCContext))
                             ? queryIndex()
                             : SymbolSlab();
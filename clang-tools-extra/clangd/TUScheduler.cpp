@@ -142,6 +142,48 @@ private:
   std::vector<KVPair> LRU; /* GUARDED_BY(Mut) */
 };
 
+/// The preambles of recently closed files, with the compile command they were
+/// built with. When a file is opened again, its worker tries to reuse the
+/// preamble instead of building a new one, which is the common case of closing
+/// and reopening a file without changing its includes.
+/// Only accessed by TUScheduler::update() and TUScheduler::remove().
+class TUScheduler::ClosedFilePreambles {
+public:
+  using Entry =
+      std::pair<std::shared_ptr<const PreambleData>, tooling::CompileCommand>;
+
+  ClosedFilePreambles(unsigned MaxRetainedPreambles)
+      : MaxRetainedPreambles(MaxRetainedPreambles) {}
+
+  void put(PathRef File, Entry E) {
+    take(File);
+    if (!E.first || MaxRetainedPreambles == 0)
+      return;
+    LRU.insert(LRU.begin(), {File, std::move(E)});
+    if (LRU.size() > MaxRetainedPreambles)
+      LRU.pop_back();
+  }
+
+  /// Returns and forgets the preamble retained for \p File, if any.
+  llvm::Optional<Entry> take(PathRef File) {
+    auto It =
+        llvm::find_if(LRU, [&](const KVPair &P) { return P.first == File; });
+    if (It == LRU.end())
+      return None;
+    Entry E = std::move(It->second);
+    LRU.erase(It);
+    return std::move(E);
+  }
+
+private:
+  using KVPair = std::pair<std::string, Entry>;
+
+  unsigned MaxRetainedPreambles;
+  /// Items sorted in LRU order, i.e. first item is the most recently closed
+  /// file.
+  std::vector<KVPair> LRU;
+};
+
 namespace {
 class ASTWorkerHandle;
 
@@ -190,6 +232,12 @@ public:
   /// Returns compile command from the current file inputs.
   tooling::CompileCommand getCurrentCompileCommand() const;
 
+  /// Provide a preamble to try reusing on the first update, which was built
+  /// for the same file with \p Command, e.g. before the file was closed.
+  /// Must be called before the first update.
+  void setPreambleToReuse(std::shared_ptr<const PreambleData> Preamble,
+                          tooling::CompileCommand Command);
+
   /// Wait for the first build of preamble to finish. Preamble itself can be
   /// accessed via getPossiblyStalePreamble(). Note that this function will
   /// return after an unsuccessful build of the preamble too, i.e. result of
@@ -258,6 +306,10 @@ private:
   /// be consumed by clients of ASTWorker.
   std::shared_ptr<const ParseInputs> FileInputs;         /* GUARDED_BY(Mutex) */
   std::shared_ptr<const PreambleData> LastBuiltPreamble; /* GUARDED_BY(Mutex) */
+  /// Preamble and its compile command that may be reused by the first update.
+  /// Only accessed by the worker thread after the first update is scheduled.
+  std::shared_ptr<const PreambleData> PreambleToReuse;
+  tooling::CompileCommand PreambleToReuseCommand;
   /// Becomes ready when the first preamble build finishes.
   Notification PreambleWasBuilt;
   /// Set to true to signal run() to finish processing.
@@ -410,6 +462,13 @@ void ASTWorker::update(ParseInputs Inputs, WantDiagnostics WantDiags) {
 
     std::shared_ptr<const PreambleData> OldPreamble =
         getPossiblyStalePreamble();
+    if (PreambleToReuse) {
+      if (!OldPreamble) {
+        OldPreamble = std::move(PreambleToReuse);
+        OldCommand = std::move(PreambleToReuseCommand);
+      }
+      PreambleToReuse.reset();
+    }
     std::shared_ptr<const PreambleData> NewPreamble = buildPreamble(
         FileName, *Invocation, OldPreamble, OldCommand, Inputs,
         StorePreambleInMemory,
@@ -577,6 +636,13 @@ std::shared_ptr<const ParseInputs> ASTWorker::getCurrentFileInputs() const {
   return FileInputs;
 }
 
+void ASTWorker::setPreambleToReuse(
+    std::shared_ptr<const PreambleData> Preamble,
+    tooling::CompileCommand Command) {
+  PreambleToReuse = std::move(Preamble);
+  PreambleToReuseCommand = std::move(Command);
+}
+
 tooling::CompileCommand ASTWorker::getCurrentCompileCommand() const {
   std::unique_lock<std::mutex> Lock(Mutex);
   return FileInputs->CompileCommand;
@@ -834,6 +900,8 @@ TUScheduler::TUScheduler(const GlobalCompilationDatabase &CDB,
                           : llvm::make_unique<ParsingCallbacks>()),
       Barrier(AsyncThreadsCount),
       IdleASTs(llvm::make_unique<ASTCache>(RetentionPolicy.MaxRetainedASTs)),
+      ClosedPreambles(llvm::make_unique<ClosedFilePreambles>(
+          RetentionPolicy.MaxRetainedPreambles)),
       UpdateDebounce(UpdateDebounce) {
   if (0 < AsyncThreadsCount) {
     PreambleTasks.emplace();
@@ -872,6 +940,9 @@ bool TUScheduler::update(PathRef File, ParseInputs Inputs,
         File, CDB, *IdleASTs,
         WorkerThreads ? WorkerThreads.getPointer() : nullptr, Barrier,
         UpdateDebounce, StorePreamblesInMemory, *Callbacks);
+    if (auto Closed = ClosedPreambles->take(File))
+      Worker->setPreambleToReuse(std::move(Closed->first),
+                                 std::move(Closed->second));
     FD = std::unique_ptr<FileData>(
         new FileData{Inputs.Contents, std::move(Worker)});
   } else {
@@ -882,10 +953,16 @@ bool TUScheduler::update(PathRef File, ParseInputs Inputs,
 }
 
 void TUScheduler::remove(PathRef File) {
-  bool Removed = Files.erase(File);
-  if (!Removed)
+  auto It = Files.find(File);
+  if (It == Files.end()) {
     elog("Trying to remove file from TUScheduler that is not tracked: {0}",
          File);
+    return;
+  }
+  ASTWorker &Worker = *It->second->Worker;
+  ClosedPreambles->put(File, {Worker.getPossiblyStalePreamble(),
+                              Worker.getCurrentCompileCommand()});
+  Files.erase(It);
 }
 
 llvm::StringRef TUScheduler::getContents(PathRef File) const {
@@ -55,6 +55,9 @@ struct ASTRetentionPolicy {
   /// Maximum number of ASTs to be retained in memory when there are no pending
   /// requests for them.
   unsigned MaxRetainedASTs = 3;
+  /// Maximum number of preambles of closed files to be retained, so that they
+  /// can be reused if the files are opened again.
+  unsigned MaxRetainedPreambles = 3;
 };
 
 struct TUAction {
@@ -223,6 +226,8 @@ public:
 private:
   /// This class stores per-file data in the Files map.
   struct FileData;
+  /// LRU cache of the preambles of closed files.
+  class ClosedFilePreambles;
 
 public:
   /// Responsible for retaining and rebuilding idle ASTs. An implementation is
@@ -243,6 +248,7 @@ private:
   Semaphore Barrier;
   llvm::StringMap<std::unique_ptr<FileData>> Files;
   std::unique_ptr<ASTCache> IdleASTs;
+  std::unique_ptr<ClosedFilePreambles> ClosedPreambles;
   // None when running tasks synchronously and non-None when running tasks
   // asynchronously.
   llvm::Optional<AsyncTaskRunner> PreambleTasks;
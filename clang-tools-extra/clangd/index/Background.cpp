@@ -210,6 +210,8 @@ BackgroundIndex::indexFileTask(tooling::CompileCommand Cmd) {
   return T;
 }
 
+constexpr std::chrono::milliseconds BackgroundIndex::UserActivityPause;
+
 void BackgroundIndex::boostRelated(llvm::StringRef Path) {
   namespace types = clang::driver::types;
   auto Type =
@@ -23,6 +23,7 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Threading.h"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
@@ -85,6 +86,10 @@ public:
   // lower priority.
   // Reducing the boost of a tag affects future tasks but not current ones.
   void boost(llvm::StringRef Tag, unsigned NewPriority);
+  // Don't start tasks with background thread priority before Until, e.g.
+  // while the user is interacting with the editor. Running tasks are not
+  // interrupted, and other tasks (such as loading shards) are not delayed.
+  void pauseBackgroundTasks(std::chrono::steady_clock::time_point Until);
 
   // Process items on the queue until the queue is stopped.
   // If the queue becomes empty, OnIdle will be called (on one worker).
@@ -106,6 +111,7 @@ private:
   bool ShouldStop = false;
   std::vector<Task> Queue; // max-heap
   llvm::StringMap<unsigned> Boosts;
+  std::chrono::steady_clock::time_point PausedUntil;
 };
 
 // Builds an in-memory index by by running the static indexer action over
@@ -135,6 +141,13 @@ public:
   /// Typically used to index TUs when headers are opened.
   void boostRelated(llvm::StringRef Path);
 
+  /// Delays starting new indexing work for a short while. Called on user
+  /// activity, so that indexing doesn't compete with interactive requests.
+  void pauseForUserActivity() {
+    Queue.pauseBackgroundTasks(std::chrono::steady_clock::now() +
+                               UserActivityPause);
+  }
+
   // Cause background threads to stop after ther current task, any remaining
   // tasks will be discarded.
   void stop() {
@@ -189,6 +202,7 @@ private:
     IndexBoostedFile,
     LoadShards,
   };
+  static constexpr std::chrono::milliseconds UserActivityPause{500};
   BackgroundQueue Queue;
   AsyncTaskRunner ThreadPool;
   GlobalCompilationDatabase::CommandChanged::Subscription CommandsChanged;
@@ -22,11 +22,19 @@ void BackgroundQueue::work(std::function<void()> OnIdle) {
     llvm::Optional<Task> Task;
     {
       std::unique_lock<std::mutex> Lock(Mu);
-      CV.wait(Lock, [&] { return ShouldStop || !Queue.empty(); });
-      if (ShouldStop) {
-        Queue.clear();
-        CV.notify_all();
-        return;
+      while (true) {
+        CV.wait(Lock, [&] { return ShouldStop || !Queue.empty(); });
+        if (ShouldStop) {
+          Queue.clear();
+          CV.notify_all();
+          return;
+        }
+        // Queue.front() is the next task as Queue is a max-heap.
+        if (Queue.front().ThreadPri != llvm::ThreadPriority::Background ||
+            std::chrono::steady_clock::now() >= PausedUntil)
+          break;
+        // Wait for the pause to end, which may be extended meanwhile.
+        CV.wait_until(Lock, PausedUntil);
       }
       ++NumActiveTasks;
       std::pop_heap(Queue.begin(), Queue.end());
@@ -104,6 +112,13 @@ void BackgroundQueue::boost(llvm::StringRef Tag, unsigned NewPriority) {
   // No need to signal, only rearranged items in the queue.
 }
 
+void BackgroundQueue::pauseBackgroundTasks(
+    std::chrono::steady_clock::time_point Until) {
+  std::lock_guard<std::mutex> Lock(Mu);
+  PausedUntil = std::max(PausedUntil, Until);
+  // No need to signal, waiting workers recheck when the old pause ends.
+}
+
 bool BackgroundQueue::blockUntilIdleForTest(
     llvm::Optional<double> TimeoutSeconds) {
   std::unique_lock<std::mutex> Lock(Mu);
@@ -0,0 +1,118 @@
+//===--- CachingIndex.cpp - Cache results of a slow index --------*- C++-*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "CachingIndex.h"
+#include "Trace.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+
+namespace clang {
+namespace clangd {
+
+CachingIndex::CachingIndex(const SymbolIndex &Base, unsigned MaxCachedRequests,
+                           unsigned MaxCachedSymbols)
+    : Base(Base), Symbols(MaxCachedSymbols), FuzzyFinds(MaxCachedRequests) {}
+
+CachingIndex::CachingIndex(std::unique_ptr<SymbolIndex> OwnedBase,
+                           unsigned MaxCachedRequests,
+                           unsigned MaxCachedSymbols)
+    : OwnedBase(std::move(OwnedBase)), Base(*this->OwnedBase),
+      Symbols(MaxCachedSymbols), FuzzyFinds(MaxCachedRequests) {}
+
+bool CachingIndex::fuzzyFind(
+    const FuzzyFindRequest &Req,
+    llvm::function_ref<void(const Symbol &)> Callback) const {
+  trace::Span Tracer("CachingIndex fuzzyFind");
+  llvm::CachedHashString CachedKey(llvm::formatv("{0}", toJSON(Req)).str());
+
+  std::shared_ptr<const CachedFuzzyFind> Cached;
+  {
+    std::lock_guard<std::mutex> Lock(Mu);
+    if (auto *Hit = FuzzyFinds.get(CachedKey))
+      Cached = *Hit;
+  }
+  SPAN_ATTACH(Tracer, "cached", Cached != nullptr);
+  if (!Cached) {
+    SymbolSlab::Builder Builder;
+    std::vector<SymbolID> Order;
+    bool More = Base.fuzzyFind(Req, [&](const Symbol &S) {
+      Builder.insert(S);
+      Order.push_back(S.ID);
+    });
+    auto Result = std::make_shared<CachedFuzzyFind>();
+    Result->Symbols = std::move(Builder).build();
+    Result->More = More;
+    Result->Results.reserve(Order.size());
+    for (const SymbolID &ID : Order)
+      Result->Results.push_back(&*Result->Symbols.find(ID));
+    Cached = std::move(Result);
+
+    std::lock_guard<std::mutex> Lock(Mu);
+    FuzzyFinds.put(CachedKey, Cached);
+  }
+  // The shared_ptr keeps the results alive even if they're evicted meanwhile.
+  for (const Symbol *S : Cached->Results)
+    Callback(*S);
+  return Cached->More;
+}
+
+void CachingIndex::lookup(
+    const LookupRequest &Req,
+    llvm::function_ref<void(const Symbol &)> Callback) const {
+  trace::Span Tracer("CachingIndex lookup");
+  std::vector<CachedSymbol> Hits;
+  LookupRequest Misses;
+  {
+    std::lock_guard<std::mutex> Lock(Mu);
+    for (const SymbolID &ID : Req.IDs) {
+      if (auto *Hit = Symbols.get(ID))
+        Hits.push_back(*Hit);
+      else
+        Misses.IDs.insert(ID);
+    }
+  }
+  SPAN_ATTACH(Tracer, "hits", static_cast<int>(Hits.size()));
+  SPAN_ATTACH(Tracer, "misses", static_cast<int>(Misses.IDs.size()));
+  for (const CachedSymbol &Hit : Hits)
+    if (Hit.Sym)
+      Callback(*Hit.Sym);
+  if (Misses.IDs.empty())
+    return;
+
+  SymbolSlab::Builder Builder;
+  Base.lookup(Misses, [&](const Symbol &S) { Builder.insert(S); });
+  auto Slab = std::make_shared<const SymbolSlab>(std::move(Builder).build());
+  for (const Symbol &S : *Slab)
+    Callback(S);
+
+  std::lock_guard<std::mutex> Lock(Mu);
+  for (const SymbolID &ID : Misses.IDs) {
+    auto It = Slab->find(ID);
+    Symbols.put(ID, {Slab, It == Slab->end() ? nullptr : &*It});
+  }
+}
+
+void CachingIndex::refs(const RefsRequest &Req,
+                        llvm::function_ref<void(const Ref &)> Callback) const {
+  Base.refs(Req, Callback);
+}
+
+void CachingIndex::relations(
+    const RelationsRequest &Req,
+    llvm::function_ref<void(const SymbolID &, const Symbol &)> Callback) const {
+  Base.relations(Req, Callback);
+}
+
+void CachingIndex::clear() {
+  std::lock_guard<std::mutex> Lock(Mu);
+  Symbols.clear();
+  FuzzyFinds.clear();
+}
+
+} // namespace clangd
+} // namespace clang
@@ -0,0 +1,140 @@
+//===--- CachingIndex.h - Cache results of a slow index ----------*- C++-*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An index that wraps an expensive-to-query index (e.g. a large shared index
+// served by another process) and remembers recent answers, so that repeated
+// queries from a single editing session don't go back to the slow index.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_TOOLS_EXTRA_CLANGD_INDEX_CACHINGINDEX_H
+#define LLVM_CLANG_TOOLS_EXTRA_CLANGD_INDEX_CACHINGINDEX_H
+
+#include "Index.h"
+#include "llvm/ADT/CachedHashString.h"
+#include "llvm/ADT/DenseMap.h"
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace clang {
+namespace clangd {
+
+// CachingIndex keeps small LRU caches in front of another index:
+//  - lookup() results are cached per SymbolID, including IDs that were not
+//    found. Only the IDs missing from the cache are forwarded to the wrapped
+//    index, as a single batched lookup.
+//  - fuzzyFind() results are cached per request.
+//  - refs() and relations() are forwarded unchanged, their results are too
+//    large and too rarely repeated to be worth keeping.
+//
+// Cached results are never invalidated on their own: the wrapped index should
+// be an immutable snapshot, or clear() must be called after it changes.
+class CachingIndex : public SymbolIndex {
+public:
+  // The wrapped index must outlive this one.
+  CachingIndex(const SymbolIndex &Base, unsigned MaxCachedRequests = 128,
+               unsigned MaxCachedSymbols = 4096);
+  // Takes ownership of the wrapped index.
+  CachingIndex(std::unique_ptr<SymbolIndex> OwnedBase,
+               unsigned MaxCachedRequests = 128,
+               unsigned MaxCachedSymbols = 4096);
+
+  bool fuzzyFind(const FuzzyFindRequest &,
+                 llvm::function_ref<void(const Symbol &)>) const override;
+  void lookup(const LookupRequest &,
+              llvm::function_ref<void(const Symbol &)>) const override;
+  void refs(const RefsRequest &,
+            llvm::function_ref<void(const Ref &)>) const override;
+  void relations(const RelationsRequest &,
+                 llvm::function_ref<void(const SymbolID &, const Symbol &)>)
+      const override;
+
+  // The cached symbols are not counted, there are at most a few thousand.
+  size_t estimateMemoryUsage() const override {
+    return Base.estimateMemoryUsage();
+  }
+
+  // Drops all cached results.
+  void clear();
+
+private:
+  // A fixed-size map that evicts the least recently used entry when full.
+  template <typename KeyT, typename ValueT> class LRUCache {
+  public:
+    explicit LRUCache(unsigned Capacity) : Capacity(Capacity) {}
+
+    // Returns the cached value for K and marks it as most recently used, or
+    // returns nullptr. The pointer is valid until the next put().
+    const ValueT *get(const KeyT &K) {
+      auto It = Entries.find(K);
+      if (It == Entries.end())
+        return nullptr;
+      Order.splice(Order.begin(), Order, It->second.second);
+      return &It->second.first;
+    }
+
+    void put(const KeyT &K, ValueT V) {
+      auto It = Entries.find(K);
+      if (It != Entries.end()) {
+        It->second.first = std::move(V);
+        Order.splice(Order.begin(), Order, It->second.second);
+        return;
+      }
+      if (Capacity == 0)
+        return;
+      if (Entries.size() >= Capacity) {
+        Entries.erase(Order.back());
+        Order.pop_back();
+      }
+      Order.push_front(K);
+      Entries.try_emplace(K, std::move(V), Order.begin());
+    }
+
+    void clear() {
+      Entries.clear();
+      Order.clear();
+    }
+
+  private:
+    unsigned Capacity;
+    // Most recently used first.
+    std::list<KeyT> Order;
+    llvm::DenseMap<KeyT,
+                   std::pair<ValueT, typename std::list<KeyT>::iterator>>
+        Entries;
+  };
+
+  // The result of a single lookup. Sym is null if the symbol wasn't found.
+  // Slab owns Sym, and may be shared with other IDs from the same batch.
+  struct CachedSymbol {
+    std::shared_ptr<const SymbolSlab> Slab;
+    const Symbol *Sym;
+  };
+  struct CachedFuzzyFind {
+    SymbolSlab Symbols;
+    // Results in the order the wrapped index returned them.
+    std::vector<const Symbol *> Results;
+    bool More;
+  };
+
+  // Set if this index owns Base.
+  std::unique_ptr<SymbolIndex> OwnedBase;
+  const SymbolIndex &Base;
+  mutable std::mutex Mu;
+  mutable LRUCache<SymbolID, CachedSymbol> Symbols;
+  // Keyed by the JSON serialization of the request.
+  mutable LRUCache<llvm::CachedHashString,
+                   std::shared_ptr<const CachedFuzzyFind>>
+      FuzzyFinds;
+};
+
+} // namespace clangd
+} // namespace clang
+
+#endif // LLVM_CLANG_TOOLS_EXTRA_CLANGD_INDEX_CACHINGINDEX_H
@@ -177,24 +177,34 @@ FileSymbols::buildIndex(IndexType Type, DuplicateHandling DuplicateHandle) {
   std::vector<Ref> RefsStorage; // Contiguous ranges for each SymbolID.
   llvm::DenseMap<SymbolID, llvm::ArrayRef<Ref>> AllRefs;
   {
-    llvm::DenseMap<SymbolID, llvm::SmallVector<Ref, 4>> MergedRefs;
+    // Count the refs of each symbol first, so that they can be copied straight
+    // to their range in RefsStorage without intermediate per-symbol vectors.
+    // Values are the start of the range and the number of refs in it.
+    llvm::DenseMap<SymbolID, std::pair<size_t, size_t>> Ranges;
+    for (const auto &RefSlab : RefSlabs)
+      for (const auto &Sym : *RefSlab)
+        Ranges[Sym.first].second += Sym.second.size();
     size_t Count = 0;
+    for (auto &Range : Ranges) {
+      Range.second.first = Count;
+      Count += Range.second.second;
+      Range.second.second = 0;
+    }
+    RefsStorage.resize(Count);
     for (const auto &RefSlab : RefSlabs)
       for (const auto &Sym : *RefSlab) {
-        MergedRefs[Sym.first].append(Sym.second.begin(), Sym.second.end());
-        Count += Sym.second.size();
+        auto &Range = Ranges[Sym.first];
+        llvm::copy(Sym.second,
+                   RefsStorage.begin() + Range.first + Range.second);
+        Range.second += Sym.second.size();
       }
-    RefsStorage.reserve(Count);
-    AllRefs.reserve(MergedRefs.size());
-    for (auto &Sym : MergedRefs) {
-      auto &SymRefs = Sym.second;
+    AllRefs.reserve(Ranges.size());
+    for (const auto &Range : Ranges) {
+      llvm::MutableArrayRef<Ref> SymRefs(
+          RefsStorage.data() + Range.second.first, Range.second.second);
       // Sorting isn't required, but yields more stable results over rebuilds.
       llvm::sort(SymRefs);
-      llvm::copy(SymRefs, back_inserter(RefsStorage));
-      AllRefs.try_emplace(
-          Sym.first,
-          llvm::ArrayRef<Ref>(&RefsStorage[RefsStorage.size() - SymRefs.size()],
-                              SymRefs.size()));
+      AllRefs.try_emplace(Range.first, SymRefs);
     }
   }
 
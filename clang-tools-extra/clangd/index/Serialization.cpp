@@ -213,8 +213,11 @@ public:
   }
 };
 
+// The strings refer to the null-terminated entries of the table itself, either
+// in the uncompressed data or in the original input when not compressed.
+// They are only valid while reading the index file, as slabs copy them anyway.
 struct StringTableIn {
-  llvm::BumpPtrAllocator Arena;
+  std::unique_ptr<char[]> Uncompressed;
   std::vector<llvm::StringRef> Strings;
 };
 
@@ -224,25 +227,26 @@ llvm::Expected<StringTableIn> readStringTable(llvm::StringRef Data) {
   if (R.err())
     return makeError("Truncated string table");
 
+  StringTableIn Table;
   llvm::StringRef Uncompressed;
-  llvm::SmallString<1> UncompressedStorage;
   if (UncompressedSize == 0) // No compression
     Uncompressed = R.rest();
   else {
-    if (llvm::Error E = llvm::zlib::uncompress(R.rest(), UncompressedStorage,
-                                               UncompressedSize))
+    // Decompress directly into the buffer the strings will point into.
+    Table.Uncompressed.reset(new char[UncompressedSize]);
+    if (llvm::Error E = llvm::zlib::uncompress(
+            R.rest(), Table.Uncompressed.get(), UncompressedSize))
       return std::move(E);
-    Uncompressed = UncompressedStorage;
+    Uncompressed = llvm::StringRef(Table.Uncompressed.get(), UncompressedSize);
   }
 
-  StringTableIn Table;
-  llvm::StringSaver Saver(Table.Arena);
-  R = Reader(Uncompressed);
-  for (Reader R(Uncompressed); !R.eof();) {
+  // Each string is followed by its null terminator in the table, so the
+  // StringRefs can be used as C strings (e.g. SymbolLocation::FileURI).
+  for (R = Reader(Uncompressed); !R.eof();) {
     auto Len = R.rest().find(0);
     if (Len == llvm::StringRef::npos)
       return makeError("Bad string table: not null terminated");
-    Table.Strings.push_back(Saver.save(R.consume(Len)));
+    Table.Strings.push_back(R.consume(Len));
     R.consume8();
   }
   if (R.err())
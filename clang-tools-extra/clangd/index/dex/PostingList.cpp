@@ -10,6 +10,7 @@
 #include "Iterator.h"
 #include "Token.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MathExtras.h"
 
@@ -102,9 +103,21 @@ private:
   void advanceToChunk(DocID ID) {
     if ((CurrentChunk != Chunks.end() - 1) &&
         ((CurrentChunk + 1)->Head <= ID)) {
-      CurrentChunk =
-          std::partition_point(CurrentChunk + 1, Chunks.end(),
-                               [&](const Chunk &C) { return C.Head < ID; });
+      // When intersecting, the next ID is usually close to the current one, so
+      // gallop forward to bound the range before binary searching within it,
+      // rather than binary searching over all the remaining chunks.
+      auto Begin = CurrentChunk + 1;
+      size_t Step = 1;
+      while (static_cast<size_t>(Chunks.end() - Begin) > Step &&
+             (Begin + Step)->Head < ID) {
+        Begin += Step;
+        Step *= 2;
+      }
+      auto End = static_cast<size_t>(Chunks.end() - Begin) > Step
+                     ? Begin + Step
+                     : Chunks.end();
+      CurrentChunk = std::partition_point(
+          Begin, End, [&](const Chunk &C) { return C.Head < ID; });
       --CurrentChunk;
       DecompressedChunk = CurrentChunk->decompress();
       CurrentID = DecompressedChunk.begin();
@@ -185,7 +198,7 @@ std::vector<Chunk> encodeStream(llvm::ArrayRef<DocID> Documents) {
 /// Reads variable length DocID from the buffer and updates the buffer size. If
 /// the stream is terminated, return None.
 llvm::Optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
-  if (Bytes.front() == 0 || Bytes.empty())
+  if (Bytes.empty() || Bytes.front() == 0)
     return None;
   DocID Result = 0;
   bool HasNextByte = true;
@@ -202,18 +215,42 @@ llvm::Optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
 
 } // namespace
 
+/// Returns true if none of the 8 bytes of \p Word is a multi-byte VByte
+/// sequence or the terminating zero, i.e. they are 8 complete deltas.
+static bool isEightSingleByteDeltas(uint64_t Word) {
+  constexpr uint64_t LowBits = 0x0101010101010101;
+  constexpr uint64_t HighBits = 0x8080808080808080;
+  if (Word & HighBits)
+    return false;
+  // With the high bits clear, this is non-zero iff one of the bytes is zero.
+  return ((Word - LowBits) & ~Word & HighBits) == 0;
+}
+
 llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
   llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
   llvm::ArrayRef<uint8_t> Bytes(Payload);
-  DocID Delta;
-  for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
+  DocID Current = Head;
+  while (!Bytes.empty()) {
+    // Dense posting lists mostly have deltas below 128, which take one byte
+    // each: decode them 8 at a time instead of byte by byte.
+    if (Bytes.size() >= 8) {
+      uint64_t Word = llvm::support::endian::read64le(Bytes.data());
+      if (isEightSingleByteDeltas(Word)) {
+        for (unsigned I = 0; I < 8; ++I, Word >>= 8) {
+          Current += Word & 0xff;
+          Result.push_back(Current);
+        }
+        Bytes = Bytes.drop_front(8);
+        continue;
+      }
+    }
     auto MaybeDelta = readVByte(Bytes);
     if (!MaybeDelta)
       break;
-    Delta = *MaybeDelta;
-    Result.push_back(Current + Delta);
+    Current += *MaybeDelta;
+    Result.push_back(Current);
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
+  return Result;
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
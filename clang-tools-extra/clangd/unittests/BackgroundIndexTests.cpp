@@ -713,5 +713,23 @@ TEST(BackgroundQueueTest, Boost) {
   }
 }
 
+TEST(BackgroundQueueTest, Pause) {
+  std::string Sequence;
+  BackgroundQueue::Task Background([&] { Sequence.push_back('B'); });
+  BackgroundQueue::Task Foreground([&] { Sequence.push_back('F'); });
+  Foreground.ThreadPri = llvm::ThreadPriority::Default;
+  Foreground.QueuePri = 1;
+
+  BackgroundQueue Q;
+  auto Start = std::chrono::steady_clock::now();
+  auto Pause = std::chrono::milliseconds(100);
+  Q.pauseBackgroundTasks(Start + Pause);
+  Q.append({Background, Foreground});
+  Q.work([&] { Q.stop(); });
+  EXPECT_EQ("FB", Sequence);
+  EXPECT_GE(std::chrono::steady_clock::now() - Start, Pause)
+      << "background task ran during the pause";
+}
+
 } // namespace clangd
 } // namespace clang
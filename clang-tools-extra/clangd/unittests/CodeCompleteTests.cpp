@@ -7,7 +7,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "Annotations.h"
+#include "Cancellation.h"
 #include "ClangdServer.h"
+#include "ClangdUnit.h"
 #include "CodeComplete.h"
 #include "Compiler.h"
 #include "Matchers.h"
@@ -737,6 +739,41 @@ TEST(CompletionTest, CompletionInPreamble) {
   EXPECT_THAT(Results, ElementsAre(Named("ifndef")));
 }
 
+TEST(CompletionTest, CancelledRequestReturnsNoResults) {
+  auto FooCpp = testPath("foo.cpp");
+  auto FooH = testPath("foo.h");
+  ParseInputs PI;
+  PI.CompileCommand.Directory = testRoot();
+  PI.CompileCommand.Filename = FooCpp;
+  PI.CompileCommand.CommandLine = {"clang", "-xc++", FooCpp};
+  Annotations Test(R"cpp(
+    #include "foo.h"
+    int x = abc^;
+  )cpp");
+  PI.Contents = Test.code();
+  llvm::StringMap<std::string> Files;
+  Files[FooCpp] = "";
+  Files[FooH] = "int abcdef;";
+  PI.FS = buildTestFS(std::move(Files));
+
+  auto CI = buildCompilerInvocation(PI);
+  ASSERT_TRUE(CI);
+  auto Preamble = buildPreamble(FooCpp, *CI, /*OldPreamble=*/nullptr,
+                                PI.CompileCommand, PI, /*StoreInMemory=*/true,
+                                /*PreambleCallback=*/nullptr);
+  ASSERT_TRUE(Preamble);
+  auto Complete = [&] {
+    return codeComplete(FooCpp, PI.CompileCommand, Preamble.get(),
+                        PI.Contents, Test.point(), PI.FS, {});
+  };
+  EXPECT_THAT(Complete().Completions, Contains(Named("abcdef")));
+
+  auto Task = cancelableTask();
+  WithContext Cancelable(std::move(Task.first));
+  Task.second();
+  EXPECT_THAT(Complete().Completions, IsEmpty());
+}
+
 TEST(CompletionTest, DynamicIndexIncludeInsertion) {
   MockFSProvider FS;
   MockCompilationDatabase CDB;
@@ -68,6 +68,28 @@ TEST(DexIterators, DocumentIterator) {
   EXPECT_TRUE(DocIterator->reachedEnd());
 }
 
+TEST(DexIterators, LongPostingList) {
+  // Mix runs of single-byte deltas with larger gaps, spanning many chunks.
+  std::vector<DocID> Docs;
+  DocID Doc = 0;
+  for (unsigned I = 0; I < 1000; ++I) {
+    Doc += I % 100 == 99 ? 5000 : 1 + I % 3;
+    Docs.push_back(Doc);
+  }
+  const PostingList L(Docs);
+  EXPECT_EQ(consumeIDs(*L.iterator()), Docs);
+
+  auto DocIterator = L.iterator();
+  DocIterator->advanceTo(Docs[500]);
+  EXPECT_EQ(DocIterator->peek(), Docs[500]);
+  DocIterator->advanceTo(Docs[501] - 1);
+  EXPECT_EQ(DocIterator->peek(), Docs[501]);
+  DocIterator->advanceTo(Docs[900] + 1);
+  EXPECT_EQ(DocIterator->peek(), Docs[901]);
+  DocIterator->advanceTo(Docs.back() + 1);
+  EXPECT_TRUE(DocIterator->reachedEnd());
+}
+
 TEST(DexIterators, AndTwoLists) {
   Corpus C{10000};
   const PostingList L0({0, 5, 7, 10, 42, 320, 9000});
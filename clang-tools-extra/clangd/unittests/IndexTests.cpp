@@ -9,6 +9,7 @@
 #include "Annotations.h"
 #include "TestIndex.h"
 #include "TestTU.h"
+#include "index/CachingIndex.h"
 #include "index/FileIndex.h"
 #include "index/Index.h"
 #include "index/MemIndex.h"
@@ -293,6 +294,110 @@ TEST(MergeIndexTest, FuzzyFind) {
               UnorderedElementsAre("ns::A", "ns::B", "ns::C"));
 }
 
+// Forwards to another index, and records how often it was queried.
+class CountingIndex : public SymbolIndex {
+public:
+  CountingIndex(const SymbolIndex &Base) : Base(Base) {}
+
+  bool fuzzyFind(const FuzzyFindRequest &Req,
+                 llvm::function_ref<void(const Symbol &)> CB) const override {
+    ++FuzzyFinds;
+    return Base.fuzzyFind(Req, CB);
+  }
+  void lookup(const LookupRequest &Req,
+              llvm::function_ref<void(const Symbol &)> CB) const override {
+    LookedUp += Req.IDs.size();
+    Base.lookup(Req, CB);
+  }
+  void refs(const RefsRequest &Req,
+            llvm::function_ref<void(const Ref &)> CB) const override {
+    Base.refs(Req, CB);
+  }
+  void relations(const RelationsRequest &Req,
+                 llvm::function_ref<void(const SymbolID &, const Symbol &)> CB)
+      const override {
+    Base.relations(Req, CB);
+  }
+  size_t estimateMemoryUsage() const override {
+    return Base.estimateMemoryUsage();
+  }
+
+  const SymbolIndex &Base;
+  mutable unsigned FuzzyFinds = 0;
+  mutable unsigned LookedUp = 0;
+};
+
+TEST(CachingIndexTest, Lookup) {
+  auto I = MemIndex::build(generateSymbols({"ns::A", "ns::B"}), RefSlab(),
+                           RelationSlab());
+  CountingIndex Counter(*I);
+  CachingIndex C(Counter);
+  EXPECT_THAT(lookup(C, SymbolID("ns::A")), UnorderedElementsAre("ns::A"));
+  EXPECT_EQ(Counter.LookedUp, 1u);
+  // Only the IDs that aren't cached yet are forwarded, misses are cached too.
+  EXPECT_THAT(lookup(C, {SymbolID("ns::A"), SymbolID("ns::B"),
+                         SymbolID("ns::C")}),
+              UnorderedElementsAre("ns::A", "ns::B"));
+  EXPECT_EQ(Counter.LookedUp, 3u);
+  EXPECT_THAT(lookup(C, {SymbolID("ns::B"), SymbolID("ns::C")}),
+              UnorderedElementsAre("ns::B"));
+  EXPECT_EQ(Counter.LookedUp, 3u);
+
+  C.clear();
+  EXPECT_THAT(lookup(C, SymbolID("ns::A")), UnorderedElementsAre("ns::A"));
+  EXPECT_EQ(Counter.LookedUp, 4u);
+}
+
+TEST(CachingIndexTest, LookupEvictsLeastRecentlyUsed) {
+  auto I = MemIndex::build(generateSymbols({"ns::A", "ns::B", "ns::C"}),
+                           RefSlab(), RelationSlab());
+  CountingIndex Counter(*I);
+  CachingIndex C(Counter, /*MaxCachedRequests=*/1, /*MaxCachedSymbols=*/2);
+  lookup(C, SymbolID("ns::A"));
+  lookup(C, SymbolID("ns::B"));
+  lookup(C, SymbolID("ns::A"));
+  lookup(C, SymbolID("ns::C")); // Evicts B.
+  EXPECT_EQ(Counter.LookedUp, 3u);
+  EXPECT_THAT(lookup(C, SymbolID("ns::A")), UnorderedElementsAre("ns::A"));
+  EXPECT_EQ(Counter.LookedUp, 3u);
+  EXPECT_THAT(lookup(C, SymbolID("ns::B")), UnorderedElementsAre("ns::B"));
+  EXPECT_EQ(Counter.LookedUp, 4u);
+}
+
+TEST(CachingIndexTest, FuzzyFind) {
+  auto I = MemIndex::build(generateSymbols({"ns::ABC", "ns::ABD", "ns::X"}),
+                           RefSlab(), RelationSlab());
+  CountingIndex Counter(*I);
+  CachingIndex C(Counter);
+  FuzzyFindRequest Req;
+  Req.Query = "AB";
+  Req.Scopes = {"ns::"};
+  EXPECT_THAT(match(C, Req), UnorderedElementsAre("ns::ABC", "ns::ABD"));
+  EXPECT_THAT(match(C, Req), UnorderedElementsAre("ns::ABC", "ns::ABD"));
+  EXPECT_EQ(Counter.FuzzyFinds, 1u);
+
+  Req.Limit = 1;
+  bool Incomplete = false;
+  EXPECT_THAT(match(C, Req, &Incomplete), testing::SizeIs(1));
+  EXPECT_TRUE(Incomplete);
+  EXPECT_EQ(Counter.FuzzyFinds, 2u);
+  Incomplete = false;
+  EXPECT_THAT(match(C, Req, &Incomplete), testing::SizeIs(1));
+  EXPECT_TRUE(Incomplete);
+  EXPECT_EQ(Counter.FuzzyFinds, 2u);
+}
+
+// This is how clangd uses the cache for -index-file: swapped in once the
+// index has loaded, so the placeholder's empty results are never cached.
+TEST(CachingIndexTest, OwnedBehindSwapIndex) {
+  SwapIndex S(llvm::make_unique<MemIndex>());
+  EXPECT_THAT(lookup(S, SymbolID("ns::A")), UnorderedElementsAre());
+  S.reset(llvm::make_unique<CachingIndex>(MemIndex::build(
+      generateSymbols({"ns::A"}), RefSlab(), RelationSlab())));
+  EXPECT_THAT(lookup(S, SymbolID("ns::A")), UnorderedElementsAre("ns::A"));
+  EXPECT_THAT(lookup(S, SymbolID("ns::A")), UnorderedElementsAre("ns::A"));
+}
+
 TEST(MergeTest, Merge) {
   Symbol L, R;
   L.ID = R.ID = SymbolID("hello");
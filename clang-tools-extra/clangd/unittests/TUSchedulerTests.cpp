@@ -498,6 +498,56 @@ TEST_F(TUSchedulerTests, EvictedAST) {
               UnorderedElementsAre(Foo, AnyOf(Bar, Baz)));
 }
 
+TEST_F(TUSchedulerTests, ReusesPreambleOfClosedFile) {
+  class CountPreambles : public ParsingCallbacks {
+  public:
+    CountPreambles(std::atomic<int> &Count) : Count(Count) {}
+    void onPreambleAST(PathRef Path, ASTContext &Ctx,
+                       std::shared_ptr<clang::Preprocessor> PP,
+                       const CanonicalIncludes &) override {
+      ++Count;
+    }
+
+  private:
+    std::atomic<int> &Count;
+  };
+
+  auto Foo = testPath("foo.cpp");
+  auto Header = testPath("foo.h");
+  Files[Header] = "int a;";
+  Timestamps[Header] = time_t(0);
+  auto Contents = R"cpp(
+    #include "foo.h"
+    int b = a;
+  )cpp";
+
+  for (unsigned MaxRetainedPreambles : {0, 1}) {
+    std::atomic<int> PreambleBuilds(0);
+    ASTRetentionPolicy Policy;
+    Policy.MaxRetainedPreambles = MaxRetainedPreambles;
+    TUScheduler S(CDB,
+                  /*AsyncThreadsCount=*/getDefaultAsyncThreadsCount(),
+                  /*StorePreambleInMemory=*/true,
+                  llvm::make_unique<CountPreambles>(PreambleBuilds),
+                  /*UpdateDebounce=*/
+                  std::chrono::steady_clock::duration::zero(), Policy);
+
+    S.update(Foo, getInputs(Foo, Contents), WantDiagnostics::No);
+    ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(10)));
+    S.remove(Foo);
+    S.update(Foo, getInputs(Foo, Contents), WantDiagnostics::No);
+    ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(10)));
+    EXPECT_EQ(PreambleBuilds, MaxRetainedPreambles ? 1 : 2);
+
+    // A header change makes the retained preamble stale.
+    S.remove(Foo);
+    Timestamps[Header] = time_t(MaxRetainedPreambles + 1);
+    S.update(Foo, getInputs(Foo, Contents), WantDiagnostics::No);
+    ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(10)));
+    EXPECT_EQ(PreambleBuilds, MaxRetainedPreambles ? 2 : 3);
+  }
+}
+
 TEST_F(TUSchedulerTests, EmptyPreamble) {
   TUScheduler S(CDB,
                 /*AsyncThreadsCount=*/4, /*StorePreambleInMemory=*/true,
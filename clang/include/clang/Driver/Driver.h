@@ -199,6 +199,12 @@ public:
   /// Whether the driver is generating diagnostics for debugging purposes.
   unsigned CCGenDiagnostics : 1;
 
+  /// Entry point of the cc1 tool, used to run cc1 jobs in the driver process
+  /// with -fintegrated-cc1. \p ArgV holds the executable followed by the job
+  /// arguments. Null if the cc1 tool isn't linked into the driver.
+  typedef int (*CC1ToolFunc)(ArrayRef<const char *> ArgV);
+  CC1ToolFunc CC1Main = nullptr;
+
 private:
   /// Raw target triple.
   std::string TargetTriple;
@@ -130,6 +130,26 @@ public:
 
   /// Set whether to print the input filenames when executing.
   void setPrintInputFilenames(bool P) { PrintInputFilenames = P; }
+
+protected:
+  /// Optionally print the filenames to be compiled
+  void PrintFileNames() const;
+
+  /// Whether a custom environment was set with setEnvironment.
+  bool hasEnvironment() const { return !Environment.empty(); }
+};
+
+/// Like Command, but runs the cc1 tool inside the driver process through
+/// Driver::CC1Main instead of spawning a new process, when possible.
+class CC1Command : public Command {
+public:
+  CC1Command(const Action &Source_, const Tool &Creator_,
+             const char *Executable_,
+             const llvm::opt::ArgStringList &Arguments_,
+             ArrayRef<InputInfo> Inputs);
+
+  int Execute(ArrayRef<Optional<StringRef>> Redirects, std::string *ErrMsg,
+              bool *ExecutionFailed) const override;
 };
 
 /// Like Command, but with a fallback which is executed in case
@@ -454,6 +454,13 @@ public:
   /// Minimum time granularity (in microseconds) traced by time profiler.
   unsigned TimeTraceGranularity;
 
+  /// Number of most expensive templates and functions summarized for each
+  /// kind of time profiler section, or zero to disable summaries.
+  unsigned TimeTraceSummaryLimit;
+
+  /// Only write summaries and totals to the time profiler output.
+  bool TimeTraceSummaryOnly;
+
 public:
   FrontendOptions()
       : DisableFree(false), RelocatablePCH(false), ShowHelp(false),
@@ -464,7 +471,8 @@ public:
         UseGlobalModuleIndex(true), GenerateGlobalModuleIndex(true),
         ASTDumpDecls(false), ASTDumpLookups(false),
         BuildingImplicitModule(false), ModulesEmbedAllFiles(false),
-        IncludeTimestamps(true), TimeTraceGranularity(500) {}
+        IncludeTimestamps(true), TimeTraceGranularity(500),
+        TimeTraceSummaryLimit(0), TimeTraceSummaryOnly(false) {}
 
   /// getInputKindForExtension - Return the appropriate input kind for a file
   /// extension. For example, "c" would return InputKind::C.
@@ -24,6 +24,7 @@
 #include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/FileSystem.h"
 #include <cassert>
 #include <cstddef>
 #include <memory>
@@ -250,9 +251,25 @@ class HeaderSearch {
   /// Entity used to look up stored header file information.
   ExternalHeaderFileInfoSource *ExternalSource = nullptr;
 
+  /// A controlling macro recorded in the include guard cache
+  /// (see HeaderSearchOptions::IncludeGuardCachePath), together with the
+  /// identity of the file it was computed for.
+  struct CachedIncludeGuard {
+    llvm::sys::fs::UniqueID UniqueID;
+    time_t ModTime = 0;
+    off_t Size = 0;
+    std::string ControllingMacro;
+  };
+
+  /// The include guard cache, keyed by file name.  Loaded on first use.
+  llvm::StringMap<CachedIncludeGuard> IncludeGuardCache;
+  bool IncludeGuardCacheLoaded = false;
+  bool IncludeGuardCacheChanged = false;
+
   // Various statistics we track for performance analysis.
   unsigned NumIncluded = 0;
   unsigned NumMultiIncludeFileOptzn = 0;
+  unsigned NumIncludeGuardCacheOptzn = 0;
   unsigned NumFrameworkLookups = 0;
   unsigned NumSubFrameworkLookups = 0;
 
@@ -466,9 +483,11 @@ public:
   /// This is used by the multiple-include optimization to eliminate
   /// no-op \#includes.
   void SetFileControllingMacro(const FileEntry *File,
-                               const IdentifierInfo *ControllingMacro) {
-    getFileInfo(File).ControllingMacro = ControllingMacro;
-  }
+                               const IdentifierInfo *ControllingMacro);
+
+  /// Write the controlling macros found by this compilation back to the
+  /// include guard cache, if one is in use and anything changed.
+  void writeIncludeGuardCache();
 
   /// Return true if this is the first time encountering this header.
   bool FirstTimeLexingFile(const FileEntry *File) {
@@ -647,6 +666,14 @@ private:
       const FileEntry *File, StringRef FrameworkName, Module *RequestingModule,
       ModuleMap::KnownHeader *SuggestedModule, bool IsSystemFramework);
 
+  /// Read the include guard cache from disk, once.
+  void loadIncludeGuardCache();
+
+  /// Return the controlling macro recorded for \p File in the include guard
+  /// cache, or null if there is none or the file has changed since.
+  const IdentifierInfo *getCachedControllingMacro(Preprocessor &PP,
+                                                  const FileEntry *File);
+
   /// Look up the file with the specified name and determine its owning
   /// module.
   const FileEntry *
@@ -113,6 +113,10 @@ public:
   /// The directory used for a user build.
   std::string ModuleUserBuildPath;
 
+  /// If non-empty, the file used to remember the controlling macros of
+  /// headers across compilations.
+  std::string IncludeGuardCachePath;
+
   /// The mapping of module names to prebuilt module files.
   std::map<std::string, std::string> PrebuiltModuleFiles;
 
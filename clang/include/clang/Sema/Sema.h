@@ -1163,6 +1163,13 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// The number of class template specializations and member classes that
+  /// have been instantiated.
+  unsigned NumClassInstantiations = 0;
+
+  /// The number of function definitions that have been instantiated.
+  unsigned NumFunctionInstantiations = 0;
+
   typedef llvm::DenseMap<ParmVarDecl *, llvm::TinyPtrVector<ParmVarDecl *>>
     UnparsedDefaultArgInstantiationsMap;
 
@@ -15,6 +15,7 @@
 #ifndef LLVM_CLANG_SERIALIZATION_GLOBALMODULEINDEX_H
 #define LLVM_CLANG_SERIALIZATION_GLOBALMODULEINDEX_H
 
+#include "clang/Basic/Module.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
@@ -87,6 +88,9 @@ class GlobalModuleIndex {
     /// The module IDs on which this module directly depends.
     /// FIXME: We don't really need a vector here.
     llvm::SmallVector<unsigned, 4> Dependencies;
+
+    /// The signature of the module file, if it has one.
+    ASTFileSignature Signature;
   };
 
   /// A mapping from module IDs to information about each module.
@@ -177,6 +181,10 @@ public:
 
   /// Write a global index into the given
   ///
+  /// Module files that are unchanged since the existing index in \p Path was
+  /// written, and whose dependencies are unchanged too, are carried over from
+  /// that index instead of being read again.
+  ///
   /// \param FileMgr The file manager to use to load module files.
   /// \param PCHContainerRdr - The PCHContainerOperations to use for loading and
   /// creating modules.
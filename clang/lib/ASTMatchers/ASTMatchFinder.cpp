@@ -410,7 +410,9 @@ public:
     Result.ResultOfMatch = matchesRecursively(Node, Matcher, &Result.Nodes,
                                               MaxDepth, Traversal, Bind);
 
-    MemoizedMatchResult &CachedResult = ResultCache[Key];
+    // The key is not needed anymore; move it into the cache rather than
+    // copying its bound nodes.
+    MemoizedMatchResult &CachedResult = ResultCache[std::move(Key)];
     CachedResult = std::move(Result);
 
     *Builder = CachedResult.Nodes;
@@ -653,7 +655,7 @@ private:
     Result.ResultOfMatch =
         matchesAncestorOfRecursively(Node, Matcher, &Result.Nodes, MatchMode);
 
-    MemoizedMatchResult &CachedResult = ResultCache[Key];
+    MemoizedMatchResult &CachedResult = ResultCache[std::move(Key)];
     CachedResult = std::move(Result);
 
     *Builder = CachedResult.Nodes;
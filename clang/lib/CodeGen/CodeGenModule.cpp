@@ -390,7 +390,10 @@ void InstrProfStats::reportDiagnostics(DiagnosticsEngine &Diags,
 }
 
 void CodeGenModule::Release() {
-  EmitDeferred();
+  {
+    llvm::TimeTraceScope TimeScope("CodeGen Deferred", StringRef(""));
+    EmitDeferred();
+  }
   EmitVTablesOpportunistically();
   applyGlobalValReplacements();
   applyReplacements();
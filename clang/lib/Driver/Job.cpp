@@ -19,9 +19,13 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/CrashRecoveryContext.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Program.h"
+#include "llvm/Support/Signals.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -313,13 +317,17 @@ void Command::setEnvironment(llvm::ArrayRef<const char *> NewEnvironment) {
   Environment.push_back(nullptr);
 }
 
-int Command::Execute(ArrayRef<llvm::Optional<StringRef>> Redirects,
-                     std::string *ErrMsg, bool *ExecutionFailed) const {
+void Command::PrintFileNames() const {
   if (PrintInputFilenames) {
     for (const char *Arg : InputFilenames)
       llvm::outs() << llvm::sys::path::filename(Arg) << "\n";
     llvm::outs().flush();
   }
+}
+
+int Command::Execute(ArrayRef<llvm::Optional<StringRef>> Redirects,
+                     std::string *ErrMsg, bool *ExecutionFailed) const {
+  PrintFileNames();
 
   SmallVector<const char*, 128> Argv;
 
@@ -411,6 +419,52 @@ int FallbackCommand::Execute(ArrayRef<llvm::Optional<StringRef>> Redirects,
   return SecondaryStatus;
 }
 
+CC1Command::CC1Command(const Action &Source_, const Tool &Creator_,
+                       const char *Executable_,
+                       const llvm::opt::ArgStringList &Arguments_,
+                       ArrayRef<InputInfo> Inputs)
+    : Command(Source_, Creator_, Executable_, Arguments_, Inputs) {}
+
+int CC1Command::Execute(ArrayRef<llvm::Optional<StringRef>> Redirects,
+                        std::string *ErrMsg, bool *ExecutionFailed) const {
+  // cc1 keeps some global state, such as the cl::opt values set by -mllvm,
+  // that can't be reset once it ran, so only the first job of the driver runs
+  // in-process. Jobs that need their own environment or redirected output
+  // run in a new process as well.
+  static bool RanInProcess = false;
+  const Driver &D = getCreator().getToolChain().getDriver();
+  if (!D.CC1Main || RanInProcess || hasEnvironment() || !Redirects.empty())
+    return Command::Execute(Redirects, ErrMsg, ExecutionFailed);
+  RanInProcess = true;
+
+  PrintFileNames();
+
+  SmallVector<const char *, 128> Argv;
+  Argv.push_back(getExecutable());
+  Argv.append(getArguments().begin(), getArguments().end());
+
+  // The job can't fail to start when it doesn't need a new process.
+  if (ExecutionFailed)
+    *ExecutionFailed = false;
+
+  llvm::CrashRecoveryContext::Enable();
+  llvm::CrashRecoveryContext CRC;
+  const void *PrettyState = llvm::SavePrettyStackState();
+
+  int R = 0;
+  if (!CRC.RunSafely([&]() { R = D.CC1Main(Argv); })) {
+    // Report the crash like a job that was killed by a signal, after
+    // removing the files the job registered for removal on a crash.
+    llvm::RestorePrettyStackState(PrettyState);
+    llvm::remove_fatal_error_handler();
+    llvm::sys::RunInterruptHandlers();
+    if (ErrMsg)
+      *ErrMsg = "crashed";
+    return -1;
+  }
+  return R;
+}
+
 ForceSuccessCommand::ForceSuccessCommand(
     const Action &Source_, const Tool &Creator_, const char *Executable_,
     const llvm::opt::ArgStringList &Arguments_, ArrayRef<InputInfo> Inputs)
@@ -1798,6 +1798,9 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   Opts.TimeTrace = Args.hasArg(OPT_ftime_trace);
   Opts.TimeTraceGranularity = getLastArgIntValue(
       Args, OPT_ftime_trace_granularity_EQ, Opts.TimeTraceGranularity, Diags);
+  Opts.TimeTraceSummaryLimit = getLastArgIntValue(
+      Args, OPT_ftime_trace_summary_EQ, Opts.TimeTraceSummaryLimit, Diags);
+  Opts.TimeTraceSummaryOnly = Args.hasArg(OPT_ftime_trace_summary_only);
   Opts.ShowVersion = Args.hasArg(OPT_version);
   Opts.ASTMergeFiles = Args.getAllArgValues(OPT_ast_merge);
   Opts.LLVMArgs = Args.getAllArgValues(OPT_mllvm);
@@ -2011,6 +2014,19 @@ static void ParseHeaderSearchArgs(HeaderSearchOptions &Opts, ArgList &Args,
   llvm::sys::path::remove_dots(P);
   Opts.ModuleCachePath = P.str();
 
+  // Canonicalize -finclude-guard-cache-path the same way, since the cache is
+  // shared between compilations that may run in different directories.
+  SmallString<128> GuardCache(
+      Args.getLastArgValue(OPT_finclude_guard_cache_path));
+  if (!(GuardCache.empty() || llvm::sys::path::is_absolute(GuardCache))) {
+    if (WorkingDir.empty())
+      llvm::sys::fs::make_absolute(GuardCache);
+    else
+      llvm::sys::fs::make_absolute(WorkingDir, GuardCache);
+  }
+  llvm::sys::path::remove_dots(GuardCache);
+  Opts.IncludeGuardCachePath = GuardCache.str();
+
   Opts.ModuleUserBuildPath = Args.getLastArgValue(OPT_fmodules_user_build_path);
   // Only the -fmodule-file=<name>=<file> form.
   for (const auto *A : Args.filtered(OPT_fmodule_file)) {
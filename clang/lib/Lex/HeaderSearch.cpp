@@ -32,8 +32,10 @@
 #include "llvm/Support/Capacity.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
@@ -41,6 +43,7 @@
 #include <cstring>
 #include <string>
 #include <system_error>
+#include <tuple>
 #include <utility>
 
 using namespace clang;
@@ -91,6 +94,8 @@ void HeaderSearch::PrintStats() {
   fprintf(stderr, "  %d #include/#include_next/#import.\n", NumIncluded);
   fprintf(stderr, "    %d #includes skipped due to"
           " the multi-include optimization.\n", NumMultiIncludeFileOptzn);
+  fprintf(stderr, "    %d #includes skipped due to"
+          " the include guard cache.\n", NumIncludeGuardCacheOptzn);
 
   fprintf(stderr, "%d framework lookups.\n", NumFrameworkLookups);
   fprintf(stderr, "%d subframework lookups.\n", NumSubFrameworkLookups);
@@ -1272,12 +1277,149 @@ bool HeaderSearch::ShouldEnterIncludeFile(Preprocessor &PP,
     }
   }
 
+  // We haven't seen this file yet, so we don't know its controlling macro.
+  // An earlier compilation may have recorded it though, in which case we can
+  // skip the file without opening it if the macro is already defined.
+  if (!FileInfo.NumIncludes && !ModulesEnabled && !M &&
+      !HSOpts->IncludeGuardCachePath.empty()) {
+    if (const IdentifierInfo *ControllingMacro =
+            getCachedControllingMacro(PP, File)) {
+      if (PP.isMacroDefined(ControllingMacro)) {
+        ++NumIncludeGuardCacheOptzn;
+        return false;
+      }
+    }
+  }
+
   // Increment the number of times this file has been included.
   ++FileInfo.NumIncludes;
 
   return true;
 }
 
+/// Return the name \p File is stored under in the include guard cache.
+static StringRef getIncludeGuardCacheKey(const FileEntry *File) {
+  StringRef RealPath = File->tryGetRealPathName();
+  return RealPath.empty() ? File->getName() : RealPath;
+}
+
+void HeaderSearch::SetFileControllingMacro(
+    const FileEntry *File, const IdentifierInfo *ControllingMacro) {
+  getFileInfo(File).ControllingMacro = ControllingMacro;
+
+  if (HSOpts->IncludeGuardCachePath.empty())
+    return;
+  loadIncludeGuardCache();
+  CachedIncludeGuard &Entry = IncludeGuardCache[getIncludeGuardCacheKey(File)];
+  if (Entry.UniqueID == File->getUniqueID() &&
+      Entry.ModTime == File->getModificationTime() &&
+      Entry.Size == File->getSize() &&
+      Entry.ControllingMacro == ControllingMacro->getName())
+    return;
+  Entry.UniqueID = File->getUniqueID();
+  Entry.ModTime = File->getModificationTime();
+  Entry.Size = File->getSize();
+  Entry.ControllingMacro = ControllingMacro->getName();
+  IncludeGuardCacheChanged = true;
+}
+
+const IdentifierInfo *
+HeaderSearch::getCachedControllingMacro(Preprocessor &PP,
+                                        const FileEntry *File) {
+  loadIncludeGuardCache();
+  auto Known = IncludeGuardCache.find(getIncludeGuardCacheKey(File));
+  if (Known == IncludeGuardCache.end())
+    return nullptr;
+
+  // Only trust the entry if the file is the one it was recorded for.
+  const CachedIncludeGuard &Entry = Known->second;
+  if (Entry.UniqueID != File->getUniqueID() ||
+      Entry.ModTime != File->getModificationTime() ||
+      Entry.Size != File->getSize())
+    return nullptr;
+  return PP.getIdentifierInfo(Entry.ControllingMacro);
+}
+
+/// Parse the include guard cache in \p Buffer into \p Cache.  Each line has
+/// the form "<device> <inode> <mtime> <size> <macro> <path>".  Malformed lines
+/// are ignored.
+template <typename CacheT>
+static void parseIncludeGuardCache(StringRef Buffer, CacheT &Cache) {
+  SmallVector<StringRef, 16> Lines;
+  Buffer.split(Lines, '\n', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  for (StringRef Line : Lines) {
+    StringRef Fields[5];
+    for (StringRef &Field : Fields)
+      std::tie(Field, Line) = Line.split(' ');
+    uint64_t Device, Inode;
+    long long ModTime, Size;
+    if (Line.empty() || Fields[4].empty() ||
+        Fields[0].getAsInteger(10, Device) ||
+        Fields[1].getAsInteger(10, Inode) ||
+        Fields[2].getAsInteger(10, ModTime) ||
+        Fields[3].getAsInteger(10, Size))
+      continue;
+    auto &Entry = Cache[Line];
+    Entry.UniqueID = llvm::sys::fs::UniqueID(Device, Inode);
+    Entry.ModTime = ModTime;
+    Entry.Size = Size;
+    Entry.ControllingMacro = Fields[4];
+  }
+}
+
+void HeaderSearch::loadIncludeGuardCache() {
+  if (IncludeGuardCacheLoaded)
+    return;
+  IncludeGuardCacheLoaded = true;
+
+  // The cache is read directly rather than through the FileManager so that it
+  // doesn't show up as a dependency of the compilation.
+  if (auto Buffer =
+          llvm::MemoryBuffer::getFile(HSOpts->IncludeGuardCachePath))
+    parseIncludeGuardCache((*Buffer)->getBuffer(), IncludeGuardCache);
+}
+
+void HeaderSearch::writeIncludeGuardCache() {
+  if (HSOpts->IncludeGuardCachePath.empty() || !IncludeGuardCacheChanged)
+    return;
+  IncludeGuardCacheChanged = false;
+  StringRef Path = HSOpts->IncludeGuardCachePath;
+
+  // Other compilations may have updated the cache since we read it.  Merge
+  // their entries with ours, ours taking precedence, so concurrent builds
+  // don't keep discarding each other's results.
+  llvm::StringMap<CachedIncludeGuard> Merged;
+  if (auto Buffer = llvm::MemoryBuffer::getFile(Path))
+    parseIncludeGuardCache((*Buffer)->getBuffer(), Merged);
+  for (const auto &Entry : IncludeGuardCache)
+    Merged[Entry.getKey()] = Entry.second;
+
+  // Write to a temporary file and rename it into place, so readers never see
+  // a partially written cache.  The cache is purely an optimization, so
+  // failures are silently ignored.
+  int FD;
+  SmallString<128> TmpPath;
+  if (llvm::sys::fs::createUniqueFile(Path + "-%%%%%%%%", FD, TmpPath))
+    return;
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    for (const auto &Entry : Merged) {
+      const CachedIncludeGuard &Guard = Entry.second;
+      OS << Guard.UniqueID.getDevice() << ' ' << Guard.UniqueID.getFile() << ' '
+         << static_cast<long long>(Guard.ModTime) << ' '
+         << static_cast<long long>(Guard.Size) << ' ' << Guard.ControllingMacro
+         << ' ' << Entry.getKey() << '\n';
+    }
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TmpPath);
+      return;
+    }
+  }
+  if (llvm::sys::fs::rename(TmpPath, Path))
+    llvm::sys::fs::remove(TmpPath);
+}
+
 size_t HeaderSearch::getTotalMemory() const {
   return SearchDirs.capacity()
     + llvm::capacity_in_bytes(FileInfo)
@@ -1625,9 +1625,110 @@ bool Lexer::tryConsumeIdentifierUTF8Char(const char *&CurPtr) {
   return true;
 }
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
+/// Vectorized prefixes of the scalar scanning loops below.  Each helper
+/// advances \p CurPtr over 16-byte chunks consisting entirely of characters
+/// the scalar loop would skip, and stops at the chunk that contains the first
+/// interesting character (or when fewer than 16 bytes are left before
+/// \p BufferEnd).  The caller then finishes with its scalar loop, so these are
+/// purely an optimization and don't change what gets lexed.
+///
+/// Only SSE2 is used so that this works with the baseline x86-64 target;
+/// other targets fall back to the scalar loops.
+#ifdef __SSE2__
+/// Skip over [_A-Za-z0-9]*.
+static const char *skipIdentifierBodyFast(const char *CurPtr,
+                                          const char *BufferEnd) {
+  const __m128i CaseBit = _mm_set1_epi8(0x20);
+  const __m128i BeforeA = _mm_set1_epi8('a' - 1);
+  const __m128i AfterZ = _mm_set1_epi8('z' + 1);
+  const __m128i Before0 = _mm_set1_epi8('0' - 1);
+  const __m128i After9 = _mm_set1_epi8('9' + 1);
+  const __m128i Underscore = _mm_set1_epi8('_');
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i Chars = _mm_loadu_si128((const __m128i *)CurPtr);
+    // Bytes >= 0x80 are negative in the signed comparisons and thus never
+    // match, so UTF-8 identifiers drop to the slow path as before.
+    __m128i Lower = _mm_or_si128(Chars, CaseBit);
+    __m128i IsAlpha = _mm_and_si128(_mm_cmpgt_epi8(Lower, BeforeA),
+                                    _mm_cmpgt_epi8(AfterZ, Lower));
+    __m128i IsDigit = _mm_and_si128(_mm_cmpgt_epi8(Chars, Before0),
+                                    _mm_cmpgt_epi8(After9, Chars));
+    __m128i IsBody = _mm_or_si128(_mm_or_si128(IsAlpha, IsDigit),
+                                  _mm_cmpeq_epi8(Chars, Underscore));
+    unsigned Mask = _mm_movemask_epi8(IsBody);
+    if (Mask != 0xFFFF)
+      return CurPtr + llvm::countTrailingOnes(Mask);
+    CurPtr += 16;
+  }
+  return CurPtr;
+}
+
+/// Skip over [ \t\f\v]*.
+static const char *skipHorizontalWhitespaceFast(const char *CurPtr,
+                                                const char *BufferEnd) {
+  const __m128i Spaces = _mm_set1_epi8(' ');
+  const __m128i Tabs = _mm_set1_epi8('\t');
+  const __m128i FormFeeds = _mm_set1_epi8('\f');
+  const __m128i VTabs = _mm_set1_epi8('\v');
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i Chars = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i IsSpace =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chars, Spaces),
+                                  _mm_cmpeq_epi8(Chars, Tabs)),
+                     _mm_or_si128(_mm_cmpeq_epi8(Chars, FormFeeds),
+                                  _mm_cmpeq_epi8(Chars, VTabs)));
+    unsigned Mask = _mm_movemask_epi8(IsSpace);
+    if (Mask != 0xFFFF)
+      return CurPtr + llvm::countTrailingOnes(Mask);
+    CurPtr += 16;
+  }
+  return CurPtr;
+}
+
+/// Skip over everything except '\n', '\r' and '\0'.
+static const char *skipToLineEndFast(const char *CurPtr,
+                                     const char *BufferEnd) {
+  const __m128i Newlines = _mm_set1_epi8('\n');
+  const __m128i Returns = _mm_set1_epi8('\r');
+  const __m128i Zero = _mm_setzero_si128();
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i Chars = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i IsEnd = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chars, Newlines),
+                                              _mm_cmpeq_epi8(Chars, Returns)),
+                                 _mm_cmpeq_epi8(Chars, Zero));
+    unsigned Mask = _mm_movemask_epi8(IsEnd);
+    if (Mask != 0)
+      return CurPtr + llvm::countTrailingZeros(Mask);
+    CurPtr += 16;
+  }
+  return CurPtr;
+}
+#else
+static const char *skipIdentifierBodyFast(const char *CurPtr, const char *) {
+  return CurPtr;
+}
+
+static const char *skipHorizontalWhitespaceFast(const char *CurPtr,
+                                                const char *) {
+  return CurPtr;
+}
+
+static const char *skipToLineEndFast(const char *CurPtr, const char *) {
+  return CurPtr;
+}
+#endif
+
 bool Lexer::LexIdentifier(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$]
   unsigned Size;
+  CurPtr = skipIdentifierBodyFast(CurPtr, BufferEnd);
   unsigned char C = *CurPtr++;
   while (isIdentifierBody(C))
     C = *CurPtr++;
@@ -2182,7 +2283,12 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
 
   // Skip consecutive spaces efficiently.
   while (true) {
-    // Skip horizontal whitespace very aggressively.
+    // Skip horizontal whitespace very aggressively.  Only take the vector path
+    // for runs of indentation; most whitespace is a single space.
+    if (isHorizontalWhitespace(Char) && isHorizontalWhitespace(CurPtr[1])) {
+      CurPtr = skipHorizontalWhitespaceFast(CurPtr, BufferEnd);
+      Char = *CurPtr;
+    }
     while (isHorizontalWhitespace(Char))
       Char = *++CurPtr;
 
@@ -2252,6 +2358,7 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
   // character that ends the line comment.
   char C;
   while (true) {
+    CurPtr = skipToLineEndFast(CurPtr, BufferEnd);
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (C != 0 &&                // Potentially EOF.
@@ -2459,13 +2566,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -434,6 +434,9 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumClassInstantiations << " class instantiations.\n";
+  llvm::errs() << NumFunctionInstantiations
+               << " function definition instantiations.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
@@ -2032,6 +2032,7 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
                                         /*Qualified=*/true);
     return Name;
   });
+  ++NumClassInstantiations;
 
   Pattern = PatternDef;
 
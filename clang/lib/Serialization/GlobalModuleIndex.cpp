@@ -19,6 +19,7 @@
 #include "clang/Serialization/Module.h"
 #include "clang/Serialization/PCHContainerOperations.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Bitstream/BitstreamReader.h"
@@ -31,6 +32,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <cstdio>
+#include <functional>
 using namespace clang;
 using namespace serialization;
 
@@ -59,7 +61,7 @@ namespace {
 static const char * const IndexFileName = "modules.idx";
 
 /// The global index file version.
-static const unsigned CurrentVersion = 1;
+static const unsigned CurrentVersion = 2;
 
 //----------------------------------------------------------------------------//
 // Global module index reader.
@@ -217,6 +219,10 @@ GlobalModuleIndex::GlobalModuleIndex(std::unique_ptr<llvm::MemoryBuffer> Buffer,
                                       Record.begin() + Idx + NumDeps);
       Idx += NumDeps;
 
+      // Signature.
+      for (unsigned I = 0; I != 5; ++I)
+        Modules[ID].Signature[I] = Record[Idx++];
+
       // Make sure we're at the end of the record.
       assert(Idx == Record.size() && "More module info?");
 
@@ -457,6 +463,32 @@ namespace {
     /// Load the contents of the given module file into the builder.
     llvm::Error loadModuleFile(const FileEntry *File);
 
+    /// Add a module file whose information is carried over from an existing
+    /// index rather than read from the file itself.
+    ///
+    /// \returns the ID of the module file in the new index.
+    unsigned addIndexedModuleFile(const FileEntry *File,
+                                  ArrayRef<const FileEntry *> Dependencies,
+                                  ASTFileSignature Signature) {
+      unsigned ID = getModuleFileInfo(File).ID;
+      // Assign IDs to the dependencies first; doing so may grow the map and
+      // invalidate references into it.
+      SmallVector<unsigned, 4> DependencyIDs;
+      for (const FileEntry *Dep : Dependencies)
+        DependencyIDs.push_back(getModuleFileInfo(Dep).ID);
+      ModuleFileInfo &Info = getModuleFileInfo(File);
+      Info.Signature = Signature;
+      Info.Dependencies.append(DependencyIDs.begin(), DependencyIDs.end());
+      return ID;
+    }
+
+    /// Record that \p Name is an identifier in the indexed module files
+    /// \p IDs, which is interesting in all of them.
+    void addIndexedIdentifier(StringRef Name, ArrayRef<unsigned> IDs) {
+      auto &Hits = InterestingIdentifiers[Name];
+      Hits.append(IDs.begin(), IDs.end());
+    }
+
     /// Write the index to the given bitstream.
     /// \returns true if an error occurred, false otherwise.
     bool writeIndex(llvm::BitstreamWriter &Stream);
@@ -805,6 +837,9 @@ bool GlobalModuleIndexBuilder::writeIndex(llvm::BitstreamWriter &Stream) {
     // Dependencies
     Record.push_back(M->second.Dependencies.size());
     Record.append(M->second.Dependencies.begin(), M->second.Dependencies.end());
+
+    // Signature
+    Record.append(M->second.Signature.begin(), M->second.Signature.end());
     Stream.EmitRecord(MODULE, Record);
   }
 
@@ -876,6 +911,77 @@ GlobalModuleIndex::writeIndex(FileManager &FileMgr,
   // The module index builder.
   GlobalModuleIndexBuilder Builder(FileMgr, PCHContainerRdr);
 
+  // Carry over whatever the existing index knows about module files that
+  // haven't changed since, so that in a large module cache only the new and
+  // rebuilt module files have to be read.  A module file is only carried
+  // over if everything it depends on is too; otherwise it is read again so
+  // that its imports are validated below.
+  llvm::DenseSet<const FileEntry *> IndexedFiles;
+  {
+    std::pair<GlobalModuleIndex *, llvm::Error> Existing = readIndex(Path);
+    std::unique_ptr<GlobalModuleIndex> OldIndex(Existing.first);
+    llvm::consumeError(std::move(Existing.second));
+    if (OldIndex && OldIndex->IdentifierIndex) {
+      unsigned NumOldModules = OldIndex->Modules.size();
+      SmallVector<const FileEntry *, 16> OldFiles(NumOldModules);
+      for (unsigned ID = 0; ID != NumOldModules; ++ID) {
+        const ModuleInfo &Info = OldIndex->Modules[ID];
+        if (Info.FileName.empty())
+          continue;
+        const FileEntry *File =
+            FileMgr.getFile(Info.FileName, /*OpenFile=*/false,
+                            /*CacheFailure=*/false);
+        if (File && File->getSize() == Info.Size &&
+            File->getModificationTime() == Info.ModTime)
+          OldFiles[ID] = File;
+      }
+
+      // Decide which module files are unchanged along with all of their
+      // dependencies. Module dependencies are acyclic.
+      enum { Unknown, InProgress, Unchanged, Changed };
+      SmallVector<unsigned char, 16> State(NumOldModules, Unknown);
+      std::function<bool(unsigned)> IsUnchanged = [&](unsigned ID) {
+        if (ID >= NumOldModules || State[ID] == InProgress)
+          return false;
+        if (State[ID] != Unknown)
+          return State[ID] == Unchanged;
+        State[ID] = InProgress;
+        bool Result = OldFiles[ID] != nullptr;
+        for (unsigned Dep : OldIndex->Modules[ID].Dependencies)
+          Result = Result && IsUnchanged(Dep);
+        State[ID] = Result ? Unchanged : Changed;
+        return Result;
+      };
+
+      SmallVector<unsigned, 16> NewIDs(NumOldModules);
+      for (unsigned ID = 0; ID != NumOldModules; ++ID) {
+        if (!IsUnchanged(ID))
+          continue;
+        SmallVector<const FileEntry *, 4> Deps;
+        for (unsigned Dep : OldIndex->Modules[ID].Dependencies)
+          Deps.push_back(OldFiles[Dep]);
+        NewIDs[ID] = Builder.addIndexedModuleFile(
+            OldFiles[ID], Deps, OldIndex->Modules[ID].Signature);
+        IndexedFiles.insert(OldFiles[ID]);
+      }
+
+      // Identifiers without any hits in the carried over module files are
+      // kept too; they still record that no indexed module file has anything
+      // interesting to say about them.
+      auto &Table = *static_cast<IdentifierIndexTable *>(
+          OldIndex->IdentifierIndex);
+      auto Data = Table.data_begin();
+      for (auto Key = Table.key_begin(), KeyEnd = Table.key_end();
+           Key != KeyEnd; ++Key, ++Data) {
+        SmallVector<unsigned, 2> Hits;
+        for (unsigned ID : *Data)
+          if (ID < NumOldModules && State[ID] == Unchanged)
+            Hits.push_back(NewIDs[ID]);
+        Builder.addIndexedIdentifier(*Key, Hits);
+      }
+    }
+  }
+
   // Load each of the module files.
   std::error_code EC;
   for (llvm::sys::fs::directory_iterator D(Path, EC), DEnd;
@@ -898,6 +1004,10 @@ GlobalModuleIndex::writeIndex(FileManager &FileMgr,
     if (!ModuleFile)
       continue;
 
+    // If the existing index already covers this module file, we're done.
+    if (IndexedFiles.count(ModuleFile))
+      continue;
+
     // Load this module file.
     if (llvm::Error Err = Builder.loadModuleFile(ModuleFile))
       return Err;
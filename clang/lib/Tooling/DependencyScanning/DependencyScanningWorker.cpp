@@ -115,12 +115,17 @@ private:
 
 } // end anonymous namespace
 
-DependencyScanningWorker::DependencyScanningWorker() {
+DependencyScanningWorker::DependencyScanningWorker(
+    DependencyScanningService &Service) {
   DiagOpts = new DiagnosticOptions();
   PCHContainerOps = std::make_shared<PCHContainerOperations>();
-  /// FIXME: Use the shared file system from the service for fast scanning
-  /// mode.
-  WorkerFS = new ProxyFileSystemWithoutChdir(llvm::vfs::getRealFileSystem());
+  IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS = llvm::vfs::getRealFileSystem();
+  // Both modes go through the shared cache so that the workers only stat and
+  // read each file once. The canonical mode keeps the original contents.
+  FS = new DependencyScanningWorkerFilesystem(
+      Service.getSharedCache(), std::move(FS),
+      Service.getMode() == ScanningMode::MinimizedSourcePreprocessing);
+  WorkerFS = new ProxyFileSystemWithoutChdir(std::move(FS));
 }
 
 llvm::Expected<std::string>
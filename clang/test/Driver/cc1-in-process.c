@@ -0,0 +1,13 @@
+// Check that -fintegrated-cc1 runs cc1 in the driver process and produces
+// the same output as a separate process.
+
+// RUN: %clang -fintegrated-cc1 -c %s -o %t.in-process.o
+// RUN: %clang -fno-integrated-cc1 -c %s -o %t.new-process.o
+// RUN: cmp %t.in-process.o %t.new-process.o
+
+// RUN: %clang -### -fintegrated-cc1 -c %s 2>&1 | FileCheck %s
+// RUN: %clang -### -fno-integrated-cc1 -c %s 2>&1 | FileCheck %s
+// CHECK-NOT: argument unused
+// CHECK: "-cc1"
+
+int f(int x) { return x + 1; }
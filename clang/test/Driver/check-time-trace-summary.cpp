@@ -0,0 +1,29 @@
+// REQUIRES: shell
+// RUN: %clangxx -S -ftime-trace -ftime-trace-summary=5 -ftime-trace-summary-only -o %T/check-time-trace-summary %s
+// RUN: cat %T/check-time-trace-summary.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s
+
+// CHECK: "traceEvents": [
+// CHECK-NOT: "name": "InstantiateClass"
+// CHECK: "args":
+// CHECK-NEXT: "avg ms":
+// CHECK-NEXT: "count": 2,
+// CHECK-NEXT: "detail": "Struct"
+// CHECK-NEXT: },
+// CHECK-NEXT: "dur":
+// CHECK-NEXT: "name": "Summary InstantiateClass"
+// CHECK: "name": "clang"
+// CHECK: "name": "process_name"
+
+template <typename T>
+struct Struct {
+  T Num;
+};
+
+int main() {
+  Struct<int> S;
+  Struct<float> F;
+
+  return 0;
+}
@@ -0,0 +1,4 @@
+#ifndef INCLUDE_GUARD_CACHE_H
+#define INCLUDE_GUARD_CACHE_H
+int guarded;
+#endif
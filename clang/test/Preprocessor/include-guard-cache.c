@@ -0,0 +1,22 @@
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: cp %S/Inputs/include-guard-cache.h %t/guarded.h
+
+// The first compilation records the include guard.
+// RUN: %clang_cc1 -E -finclude-guard-cache-path=%t/guards -I%t %s -o /dev/null
+// RUN: FileCheck --check-prefix=CACHE %s < %t/guards
+// CACHE: INCLUDE_GUARD_CACHE_H {{.*}}guarded.h
+
+// With the guard already defined, the header isn't entered at all.
+// RUN: %clang_cc1 -E -finclude-guard-cache-path=%t/guards -I%t \
+// RUN:   -DINCLUDE_GUARD_CACHE_H -print-stats %s -o /dev/null 2>&1 \
+// RUN:   | FileCheck --check-prefix=SKIP %s
+// SKIP: 1 #includes skipped due to the include guard cache.
+
+// Once the header changes, the cached entry is no longer trusted.
+// RUN: echo "" >> %t/guarded.h
+// RUN: %clang_cc1 -E -finclude-guard-cache-path=%t/guards -I%t \
+// RUN:   -DINCLUDE_GUARD_CACHE_H -print-stats %s -o /dev/null 2>&1 \
+// RUN:   | FileCheck --check-prefix=STALE %s
+// STALE: 0 #includes skipped due to the include guard cache.
+
+#include "guarded.h"
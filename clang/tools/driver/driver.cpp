@@ -318,6 +318,11 @@ static int ExecuteCC1Tool(ArrayRef<const char *> argv, StringRef Tool) {
   return 1;
 }
 
+/// Runs a cc1 job from the driver process, see Driver::CC1Main.
+static int ExecuteCC1ToolInProcess(ArrayRef<const char *> ArgV) {
+  return ExecuteCC1Tool(ArgV, StringRef(ArgV[1]).drop_front(4));
+}
+
 int main(int argc_, const char **argv_) {
   llvm::InitLLVM X(argc_, argv_);
   SmallVector<const char *, 256> argv(argv_, argv_ + argc_);
@@ -448,6 +453,7 @@ int main(int argc_, const char **argv_) {
 
   Driver TheDriver(Path, llvm::sys::getDefaultTargetTriple(), Diags);
   SetInstallDir(argv, TheDriver, CanonicalPrefixes);
+  TheDriver.CC1Main = &ExecuteCC1ToolInProcess;
   TheDriver.setTargetAndMode(TargetAndMode);
 
   insertTargetAndModeArgs(TargetAndMode, argv, SavedStrings);
@@ -28,14 +28,16 @@ public:
       : CTU(CI), Success(Success) {}
 
   void HandleTranslationUnit(ASTContext &Ctx) {
-    auto FindFInTU = [](const TranslationUnitDecl *TU) {
-      const FunctionDecl *FD = nullptr;
+    auto FindInTU = [](const TranslationUnitDecl *TU, StringRef Name) {
       for (const Decl *D : TU->decls()) {
-        FD = dyn_cast<FunctionDecl>(D);
-        if (FD && FD->getName() == "f")
-          break;
+        const auto *FD = dyn_cast<FunctionDecl>(D);
+        if (FD && FD->getName() == Name)
+          return FD;
       }
-      return FD;
+      return static_cast<const FunctionDecl *>(nullptr);
+    };
+    auto FindFInTU = [&](const TranslationUnitDecl *TU) {
+      return FindInTU(TU, "f");
     };
 
     const TranslationUnitDecl *TU = Ctx.getTranslationUnitDecl();
@@ -56,10 +58,12 @@ public:
                                                     IndexFileName));
     llvm::ToolOutputFile IndexFile(IndexFileName, IndexFD);
     IndexFile.os() << "c:@F@f#I# " << ASTFileName << "\n";
+    IndexFile.os() << "c:@F@g#I# " << ASTFileName << "\n";
     IndexFile.os().flush();
     EXPECT_TRUE(llvm::sys::fs::exists(IndexFileName));
 
-    StringRef SourceText = "int f(int) { return 0; }\n";
+    StringRef SourceText = "int f(int) { return 0; }\n"
+                           "int g(int) { return 1; }\n";
     // This file must exist since the saved ASTFile will reference it.
     int SourceFD;
     llvm::SmallString<256> SourceFileName;
@@ -106,6 +110,16 @@ public:
         }
       }
     }
+
+    // A definition from an AST that is already loaded can be imported even
+    // if loading it again would exceed the threshold.
+    const FunctionDecl *GD = FindInTU(TU, "g");
+    if (*Success && GD) {
+      llvm::Expected<const FunctionDecl *> NewGDorError = handleExpected(
+          CTU.getCrossTUDefinition(GD, "", IndexFileName, false),
+          []() { return nullptr; }, [](IndexError &) {});
+      *Success = NewGDorError && *NewGDorError && (*NewGDorError)->hasBody();
+    }
   }
 
 private:
@@ -139,6 +153,13 @@ TEST(CrossTranslationUnit, CanLoadFunctionDefinition) {
   EXPECT_TRUE(Success);
 }
 
+TEST(CrossTranslationUnit, CanLoadFromLoadedASTAtThreshold) {
+  bool Success = false;
+  EXPECT_TRUE(tooling::runToolOnCode(new CTUAction(&Success, 1u),
+                                     "int f(int); int g(int);"));
+  EXPECT_TRUE(Success);
+}
+
 TEST(CrossTranslationUnit, RespectsLoadThreshold) {
   bool Success = false;
   EXPECT_TRUE(
@@ -532,4 +532,28 @@ TEST_F(LexerTest, CharRangeOffByOne) {
   EXPECT_EQ(Lexer::getSourceText(CR, SourceMgr, LangOpts), "MOO"); // Was "MO".
 }
 
+TEST_F(LexerTest, LongRunsOfSkippedCharacters) {
+  // Identifiers, indentation and line comments longer than a vector chunk,
+  // with the interesting character at varying offsets inside the chunk.
+  std::string LongId(37, 'a');
+  LongId += "_Z9";
+  std::string Source = "int " + LongId + ";\n" +
+                       std::string(21, ' ') + "\t\t" + LongId + "x$ = 0;\n" +
+                       "// " + std::string(50, '.') + " \\\n" +
+                       "still a comment " + std::string(20, '-') + "\r\n" +
+                       std::string(16, ' ') + "int y;";
+  LangOpts.DollarIdents = true;
+  std::vector<Token> toks = CheckLex(
+      Source, {tok::kw_int, tok::identifier, tok::semi, tok::identifier,
+               tok::equal, tok::numeric_constant, tok::semi, tok::kw_int,
+               tok::identifier, tok::semi});
+
+  EXPECT_EQ(getSourceText(toks[1], toks[1]), LongId);
+  EXPECT_EQ(getSourceText(toks[3], toks[3]), LongId + "x$");
+  EXPECT_TRUE(toks[3].isAtStartOfLine());
+  EXPECT_TRUE(toks[3].hasLeadingSpace());
+  EXPECT_TRUE(toks[7].isAtStartOfLine());
+  EXPECT_EQ(getSourceText(toks[8], toks[8]), "y");
+}
+
 } // anonymous namespace
@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <algorithm>
+
+// std::sort must stay O(N log N) even on inputs built to defeat its pivot
+// selection. The comparator below is McIlroy's "antiqsort" adversary: it
+// decides the values of the elements lazily, answering every comparison so
+// that the pivots stay as bad as possible.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "test_macros.h"
+
+namespace {
+
+struct Adversary {
+    std::vector<int> values;
+    int gas;
+    int solid;
+    std::size_t candidate;
+    std::size_t comparisons;
+
+    explicit Adversary(std::size_t n)
+        : values(n, static_cast<int>(n)), gas(static_cast<int>(n)), solid(0),
+          candidate(0), comparisons(0) {}
+
+    void freeze(std::size_t x) { values[x] = solid++; }
+
+    bool less(std::size_t x, std::size_t y) {
+        ++comparisons;
+        if (values[x] == gas && values[y] == gas) {
+            if (x == candidate)
+                freeze(x);
+            else
+                freeze(y);
+        }
+        if (values[x] == gas)
+            candidate = x;
+        else if (values[y] == gas)
+            candidate = y;
+        return values[x] < values[y];
+    }
+};
+
+struct AdversaryLess {
+    Adversary* adversary;
+    explicit AdversaryLess(Adversary* a) : adversary(a) {}
+    bool operator()(std::size_t x, std::size_t y) const {
+        return adversary->less(x, y);
+    }
+};
+
+std::size_t log2(std::size_t n) {
+    std::size_t result = 0;
+    while (n > 1) {
+        ++result;
+        n >>= 1;
+    }
+    return result;
+}
+
+}  // namespace
+
+int main(int, char**)
+{
+    const std::size_t n = 1 << 14;
+    Adversary adversary(n);
+    std::vector<std::size_t> indices(n);
+    for (std::size_t i = 0; i < n; ++i)
+        indices[i] = i;
+
+    std::sort(indices.begin(), indices.end(), AdversaryLess(&adversary));
+
+    for (std::size_t i = 1; i < n; ++i)
+        assert(adversary.values[indices[i - 1]] <= adversary.values[indices[i]]);
+    // A quadratic sort needs on the order of n * n / 4 comparisons here.
+    assert(adversary.comparisons < 10 * n * log2(n));
+
+    return 0;
+}
@@ -617,8 +617,14 @@ extern "C" _LIBCXXABI_FUNC_VIS void *
 __dynamic_cast(const void *static_ptr, const __class_type_info *static_type,
                const __class_type_info *dst_type,
                std::ptrdiff_t src2dst_offset) {
-    // Possible future optimization:  Take advantage of src2dst_offset
-    // Currently clang always sets src2dst_offset to -1 (no hint).
+    // src2dst_offset is the hint computed by the compiler:
+    //   >= 0: static_type is a unique public non-virtual base of dst_type, at
+    //         that offset from the start of dst_type
+    //     -1: no hint
+    //     -2: static_type is not a public base of dst_type
+    //     -3: static_type is a multiple public base type but never a virtual
+    //         base type
+    // It is only used below when the most derived type is dst_type.
 
     // Get (dynamic_ptr, dynamic_type) from static_ptr
     void **vtable = *static_cast<void ** const *>(static_ptr);
@@ -636,6 +642,18 @@ __dynamic_cast(const void *static_ptr, const __class_type_info *static_type,
     // Find out if we can use a giant short cut in the search
     if (is_equal(dynamic_type, dst_type, false))
     {
+        // The object is a dst_type, so the cast succeeds exactly when
+        // (static_ptr, static_type) is reached from it along a public path.
+        // The hint answers that without walking the hierarchy: the only
+        // public static_type subobject is at src2dst_offset, and there is
+        // none at all for -2.
+        if (src2dst_offset >= 0)
+            return static_cast<const char*>(static_ptr) - src2dst_offset ==
+                           dynamic_ptr
+                       ? const_cast<void*>(dynamic_ptr)
+                       : nullptr;
+        if (src2dst_offset == -2)
+            return nullptr;
         // Using giant short cut.  Add that information to info.
         info.number_of_dst_type = 1;
         // Do the  search
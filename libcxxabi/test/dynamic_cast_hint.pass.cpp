@@ -0,0 +1,99 @@
+//===----------------------- dynamic_cast_hint.cpp ------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <cassert>
+
+// This test covers downcasts to the most derived type, where __dynamic_cast
+// answers from the compiler's src2dst_offset hint instead of walking the
+// class hierarchy.
+
+namespace t1
+{
+
+// The source is a unique public non-virtual base of the destination.
+struct A1 { virtual ~A1() {} int a1; };
+struct A2 { virtual ~A2() {} int a2; };
+struct A3 : public A1, public A2 { int a3; };
+
+void test()
+{
+    A3 a3;
+    A1* a1 = &a3;
+    A2* a2 = &a3;
+    assert(dynamic_cast<A3*>(a1) == &a3);
+    assert(dynamic_cast<A3*>(a2) == &a3);
+}
+
+}  // t1
+
+namespace t2
+{
+
+// The source type is both a private and a public base of the destination;
+// only the public subobject may be cast.
+struct A1 { virtual ~A1() {} int a1; };
+struct A2 : public A1 { int a2; };
+struct A3 : public A1 { int a3; };
+struct A4 : private A2, public A3
+{
+    A1* getPrivateA1() { return static_cast<A2*>(this); }
+    A1* getPublicA1() { return static_cast<A3*>(this); }
+};
+
+void test()
+{
+    A4 a4;
+    assert(dynamic_cast<A4*>(a4.getPrivateA1()) == 0);
+    assert(dynamic_cast<A4*>(a4.getPublicA1()) == &a4);
+}
+
+}  // t2
+
+namespace t3
+{
+
+// The source is a private base of the destination.
+struct A1 { virtual ~A1() {} int a1; };
+struct A2 : private A1
+{
+    A1* getA1() { return this; }
+};
+
+void test()
+{
+    A2 a2;
+    assert(dynamic_cast<A2*>(a2.getA1()) == 0);
+}
+
+}  // t3
+
+namespace t4
+{
+
+// The most derived type is not the destination, so the hint is not used.
+struct A1 { virtual ~A1() {} int a1; };
+struct A2 { virtual ~A2() {} int a2; };
+struct A3 : public A1, public A2 { int a3; };
+struct A4 : public A3 { int a4; };
+
+void test()
+{
+    A4 a4;
+    A2* a2 = &a4;
+    assert(dynamic_cast<A3*>(a2) == static_cast<A3*>(&a4));
+}
+
+}  // t4
+
+int main()
+{
+    t1::test();
+    t2::test();
+    t3::test();
+    t4::test();
+}
@@ -178,6 +178,14 @@ struct UnwindInfoSections {
 #endif
 };
 
+#if defined(_LIBUNWIND_USE_FRAME_HEADER_CACHE)
+} // namespace libunwind
+#include "FrameHeaderCache.hpp"
+namespace libunwind {
+// One cache per process, or per image for a hermetic static libunwind.
+static FrameHeaderCache ProcessFrameHeaderCache;
+#endif
+
 
 /// LocalAddressSpace is used as a template parameter to UnwindCursor when
 /// unwinding a thread in the same process.  The wrappers compile away,
@@ -479,13 +487,14 @@ inline bool LocalAddressSpace::findUnwindSections(pint_t targetAddr,
 
   dl_iterate_cb_data cb_data = {this, &info, targetAddr};
   int found = dl_iterate_phdr(
-      [](struct dl_phdr_info *pinfo, size_t, void *data) -> int {
+      [](struct dl_phdr_info *pinfo, size_t pinfo_size, void *data) -> int {
         auto cbdata = static_cast<dl_iterate_cb_data *>(data);
         bool found_obj = false;
         bool found_hdr = false;
 
         assert(cbdata);
         assert(cbdata->sects);
+        (void)pinfo_size;
 
         if (cbdata->targetAddr < pinfo->dlpi_addr) {
           return false;
@@ -505,6 +514,11 @@ inline bool LocalAddressSpace::findUnwindSections(pint_t targetAddr,
   #if !defined(_LIBUNWIND_SUPPORT_DWARF_INDEX)
    #error "_LIBUNWIND_SUPPORT_DWARF_UNWIND requires _LIBUNWIND_SUPPORT_DWARF_INDEX on this platform."
   #endif
+#if defined(_LIBUNWIND_USE_FRAME_HEADER_CACHE)
+        if (ProcessFrameHeaderCache.find(pinfo, pinfo_size, cbdata->targetAddr,
+                                         cbdata->sects))
+          return true;
+#endif
         size_t object_length;
 #if defined(__ANDROID__)
         Elf_Addr image_base =
@@ -548,6 +562,9 @@ inline bool LocalAddressSpace::findUnwindSections(pint_t targetAddr,
 
         if (found_obj && found_hdr) {
           cbdata->sects->dwarf_section_length = object_length;
+#if defined(_LIBUNWIND_USE_FRAME_HEADER_CACHE)
+          ProcessFrameHeaderCache.add(pinfo, pinfo_size, cbdata->sects);
+#endif
           return true;
         } else {
           return false;
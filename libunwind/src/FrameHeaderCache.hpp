@@ -0,0 +1,134 @@
+//===-------------------------- FrameHeaderCache.hpp ----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//
+// Caches the unwind sections found through dl_iterate_phdr, so that unwinding
+// through a process with many shared objects does not parse the program
+// headers of every object on every lookup.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef __FRAMEHEADER_CACHE_HPP__
+#define __FRAMEHEADER_CACHE_HPP__
+
+#include <limits.h>
+#include <stddef.h>
+
+namespace libunwind {
+
+// Only use the cache from within a dl_iterate_phdr callback: the C library
+// holds its loader lock while calling it, which serializes all accesses. The
+// cache does no locking of its own.
+class _LIBUNWIND_HIDDEN FrameHeaderCache {
+  struct CacheEntry {
+    uintptr_t lowPC() const { return Info.dso_base; }
+    uintptr_t highPC() const {
+      return Info.dso_base + Info.dwarf_section_length;
+    }
+    UnwindInfoSections Info;
+    CacheEntry *Next;
+  };
+
+  static const size_t kCacheEntryCount = 8;
+
+  // libunwind cannot depend on the C++ library, so the entries live in a
+  // fixed array, threaded on a free list and on a most-recently-used list.
+  CacheEntry Entries[kCacheEntryCount];
+  CacheEntry *MostRecentlyUsed;
+  CacheEntry *Unused;
+  // dlpi_adds and dlpi_subs at the time the cache was last reset. The C
+  // library bumps them whenever an object is loaded or unloaded.
+  unsigned long long LastAdds;
+  unsigned long long LastSubs;
+
+  // Older C libraries do not provide the load and unload counters.
+  static bool hasLoadCounters(size_t PInfoSize) {
+    return PInfoSize >= offsetof(dl_phdr_info, dlpi_subs) +
+                            sizeof(((dl_phdr_info *)nullptr)->dlpi_subs);
+  }
+
+  void resetCache() {
+    MostRecentlyUsed = nullptr;
+    Unused = &Entries[0];
+    for (size_t i = 0; i < kCacheEntryCount - 1; i++)
+      Entries[i].Next = &Entries[i + 1];
+    Entries[kCacheEntryCount - 1].Next = nullptr;
+  }
+
+  // Returns true if the cache cannot be trusted for this iteration, resetting
+  // it if the set of loaded objects changed.
+  bool cacheNeedsReset(dl_phdr_info *PInfo, size_t PInfoSize) {
+    if (!hasLoadCounters(PInfoSize))
+      return true;
+    if (PInfo->dlpi_adds == LastAdds && PInfo->dlpi_subs == LastSubs)
+      return false;
+    LastAdds = PInfo->dlpi_adds;
+    LastSubs = PInfo->dlpi_subs;
+    resetCache();
+    return true;
+  }
+
+public:
+  // Statically initialized: an empty cache that resets on first use.
+  constexpr FrameHeaderCache()
+      : Entries(), MostRecentlyUsed(nullptr), Unused(nullptr),
+        LastAdds(ULLONG_MAX), LastSubs(ULLONG_MAX) {}
+
+  /// Looks up \p TargetAddr, filling in \p Sects on a hit. \p PInfo and
+  /// \p PInfoSize are the arguments of the current dl_iterate_phdr callback.
+  bool find(dl_phdr_info *PInfo, size_t PInfoSize, uintptr_t TargetAddr,
+            UnwindInfoSections *Sects) {
+    if (cacheNeedsReset(PInfo, PInfoSize))
+      return false;
+
+    CacheEntry *Previous = nullptr;
+    for (CacheEntry *Current = MostRecentlyUsed; Current != nullptr;
+         Previous = Current, Current = Current->Next) {
+      if (TargetAddr < Current->lowPC() || TargetAddr >= Current->highPC())
+        continue;
+      if (Previous) {
+        // Move the entry to the front of the most-recently-used list.
+        Previous->Next = Current->Next;
+        Current->Next = MostRecentlyUsed;
+        MostRecentlyUsed = Current;
+      }
+      *Sects = Current->Info;
+      return true;
+    }
+    return false;
+  }
+
+  /// Records the sections found for an object, evicting the least recently
+  /// used entry if the cache is full.
+  void add(dl_phdr_info *PInfo, size_t PInfoSize,
+           const UnwindInfoSections *Sects) {
+    // Entries cannot be invalidated without the load and unload counters.
+    if (!hasLoadCounters(PInfoSize))
+      return;
+    if (PInfo->dlpi_adds != LastAdds || PInfo->dlpi_subs != LastSubs)
+      return;
+
+    CacheEntry *Current;
+    if (Unused != nullptr) {
+      Current = Unused;
+      Unused = Unused->Next;
+    } else {
+      // The cache is full, so MostRecentlyUsed has kCacheEntryCount entries.
+      CacheEntry *Previous = MostRecentlyUsed;
+      while (Previous->Next->Next != nullptr)
+        Previous = Previous->Next;
+      Current = Previous->Next;
+      Previous->Next = nullptr;
+    }
+    Current->Info = *Sects;
+    Current->Next = MostRecentlyUsed;
+    MostRecentlyUsed = Current;
+  }
+};
+
+} // namespace libunwind
+
+#endif // __FRAMEHEADER_CACHE_HPP__
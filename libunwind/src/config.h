@@ -49,6 +49,11 @@
   #endif
 #endif
 
+// The frame header cache holds the sections found through dl_iterate_phdr.
+#if !defined(_LIBUNWIND_SUPPORT_DWARF_INDEX) || defined(_LIBUNWIND_IS_BAREMETAL)
+  #undef _LIBUNWIND_USE_FRAME_HEADER_CACHE
+#endif
+
 #if defined(_LIBUNWIND_DISABLE_VISIBILITY_ANNOTATIONS)
   #define _LIBUNWIND_EXPORT
   #define _LIBUNWIND_HIDDEN
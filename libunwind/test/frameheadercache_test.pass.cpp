@@ -0,0 +1,110 @@
+// Tests FrameHeaderCache: lookups, most-recently-used eviction, and resets
+// when the set of loaded objects changes.
+
+#define _LIBUNWIND_USE_FRAME_HEADER_CACHE
+#include "../src/config.h"
+
+// config.h turns the cache off where it can't be used.
+#if defined(_LIBUNWIND_USE_FRAME_HEADER_CACHE)
+
+#include <link.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Defines UnwindInfoSections and includes FrameHeaderCache.hpp.
+#include "../src/AddressSpace.hpp"
+
+using namespace libunwind;
+
+static const uintptr_t kObjectSize = 0x1000;
+
+static UnwindInfoSections makeSections(uintptr_t Base) {
+  UnwindInfoSections Sects;
+  memset(&Sects, 0, sizeof(Sects));
+  Sects.dso_base = Base;
+  Sects.dwarf_section_length = kObjectSize;
+  return Sects;
+}
+
+static uintptr_t objectBase(int I) { return (I + 1) * 0x100000; }
+
+int main() {
+  FrameHeaderCache FHC;
+  dl_phdr_info PInfo;
+  memset(&PInfo, 0, sizeof(PInfo));
+  // The cache only looks at the load and unload counters.
+  PInfo.dlpi_adds = 6;
+  PInfo.dlpi_subs = 7;
+  const size_t PInfoSize = sizeof(PInfo);
+
+  UnwindInfoSections Found;
+  UnwindInfoSections Sects = makeSections(objectBase(0));
+
+  // The first lookup resets the empty cache and finds nothing.
+  if (FHC.find(&PInfo, PInfoSize, objectBase(0), &Found))
+    abort();
+  FHC.add(&PInfo, PInfoSize, &Sects);
+  if (!FHC.find(&PInfo, PInfoSize, objectBase(0) + 1, &Found))
+    abort();
+  if (Found.dso_base != objectBase(0))
+    abort();
+  // The range is half-open.
+  if (FHC.find(&PInfo, PInfoSize, objectBase(0) + kObjectSize, &Found))
+    abort();
+
+  // Without the load and unload counters nothing is cached.
+  const size_t OldPInfoSize = offsetof(dl_phdr_info, dlpi_adds);
+  if (FHC.find(&PInfo, OldPInfoSize, objectBase(0), &Found))
+    abort();
+
+  // Fill the cache. Object 0 is now the least recently used one, so the
+  // next add evicts it.
+  for (int I = 1; I < 8; ++I) {
+    Sects = makeSections(objectBase(I));
+    FHC.add(&PInfo, PInfoSize, &Sects);
+  }
+  if (!FHC.find(&PInfo, PInfoSize, objectBase(0), &Found))
+    abort();
+  // Object 0 was just used, so object 1 is evicted instead.
+  Sects = makeSections(objectBase(8));
+  FHC.add(&PInfo, PInfoSize, &Sects);
+  if (FHC.find(&PInfo, PInfoSize, objectBase(1), &Found))
+    abort();
+  for (int I = 0; I <= 8; ++I) {
+    if (I == 1)
+      continue;
+    if (!FHC.find(&PInfo, PInfoSize, objectBase(I), &Found))
+      abort();
+    if (Found.dso_base != objectBase(I))
+      abort();
+  }
+
+  // Loading an object resets the cache.
+  PInfo.dlpi_adds++;
+  if (FHC.find(&PInfo, PInfoSize, objectBase(0), &Found))
+    abort();
+  Sects = makeSections(objectBase(0));
+  FHC.add(&PInfo, PInfoSize, &Sects);
+  if (!FHC.find(&PInfo, PInfoSize, objectBase(0), &Found))
+    abort();
+  if (FHC.find(&PInfo, PInfoSize, objectBase(2), &Found))
+    abort();
+
+  // So does unloading one.
+  PInfo.dlpi_subs++;
+  if (FHC.find(&PInfo, PInfoSize, objectBase(0), &Found))
+    abort();
+
+  // Adds made under stale counters are dropped.
+  PInfo.dlpi_adds++;
+  Sects = makeSections(objectBase(3));
+  FHC.add(&PInfo, PInfoSize, &Sects);
+  if (FHC.find(&PInfo, PInfoSize, objectBase(3), &Found))
+    abort();
+
+  return 0;
+}
+
+#else
+int main() { return 0; }
+#endif
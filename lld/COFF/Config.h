@@ -149,6 +149,11 @@ struct Configuration {
   // Used for /opt:lldltocachepolicy=policy
   llvm::CachePruningPolicy ltoCachePolicy;
 
+  // Used for /lldghashcache:path
+  StringRef ghashCache;
+  // Used for /lldghashcachepolicy:policy
+  llvm::CachePruningPolicy ghashCachePolicy;
+
   // Used for /merge:from=to (e.g. /merge:.rdata=.text)
   std::map<StringRef, StringRef> merge;
 
@@ -1394,6 +1394,17 @@ void LinkerDriver::link(ArrayRef<const char *> argsArr) {
         parseCachePruningPolicy(arg->getValue()),
         Twine("/lldltocachepolicy: invalid cache policy: ") + arg->getValue());
 
+  // Handle /lldghashcache
+  if (auto *arg = args.getLastArg(OPT_lldghashcache))
+    config->ghashCache = arg->getValue();
+
+  // Handle /lldghashcachepolicy
+  if (auto *arg = args.getLastArg(OPT_lldghashcachepolicy))
+    config->ghashCachePolicy = CHECK(
+        parseCachePruningPolicy(arg->getValue()),
+        Twine("/lldghashcachepolicy: invalid cache policy: ") +
+            arg->getValue());
+
   // Handle /failifmismatch
   for (auto *arg : args.filtered(OPT_failifmismatch))
     checkFailIfMismatch(arg->getValue(), nullptr);
@@ -28,6 +28,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cstddef>
@@ -100,7 +101,9 @@ BitcodeCompiler::BitcodeCompiler() {
     auto OnIndexWrite = [&](StringRef S) { thinIndices.erase(S); };
     backend = lto::createWriteIndexesThinBackend(
         config->thinLTOPrefixReplace.first, config->thinLTOPrefixReplace.second,
-        config->thinLTOEmitImportsFiles, indexFile.get(), OnIndexWrite);
+        config->thinLTOEmitImportsFiles, indexFile.get(), OnIndexWrite,
+        config->thinLTOJobs ? config->thinLTOJobs
+                            : heavyweight_hardware_concurrency());
   } else if (config->thinLTOJobs != 0) {
     backend = lto::createInProcessThinBackend(config->thinLTOJobs);
   }
@@ -18,6 +18,7 @@
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/Timer.h"
 #include "lld/Common/Threads.h"
+#include "lld/Common/Version.h"
 #include "llvm/DebugInfo/CodeView/DebugFrameDataSubsection.h"
 #include "llvm/DebugInfo/CodeView/DebugSubsectionRecord.h"
 #include "llvm/DebugInfo/CodeView/GlobalTypeTableBuilder.h"
@@ -55,6 +56,8 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/JamCRC.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include <memory>
@@ -71,6 +74,8 @@ static ExitOnError exitOnErr;
 static Timer totalPdbLinkTimer("PDB Emission (Cumulative)", Timer::root());
 
 static Timer addObjectsTimer("Add Objects", totalPdbLinkTimer);
+static Timer ghashTimer("Global Type Hashing", addObjectsTimer);
+static Timer relocDebugTimer("Relocate Debug Sections", addObjectsTimer);
 static Timer typeMergingTimer("Type Merging", addObjectsTimer);
 static Timer symbolMergingTimer("Symbol Merging", addObjectsTimer);
 static Timer globalsLayoutTimer("Globals Stream Layout", totalPdbLinkTimer);
@@ -109,6 +114,18 @@ public:
   /// externally.
   void addObjFile(ObjFile *file, CVIndexMap *externIndexMap = nullptr);
 
+  /// Compute global type hashes in parallel for all objects that need them
+  /// but lack a usable .debug$H section. The hashes only depend on each
+  /// object's own type stream, so this is done ahead of the serial merge.
+  void computeGHashes();
+
+  /// Apply relocations to all live .debug$S and .debug$F sections in
+  /// parallel ahead of the serial symbol merge.
+  void relocateDebugChunks();
+
+  /// Return the relocated contents of a .debug$S or .debug$F section.
+  ArrayRef<uint8_t> getRelocatedContents(SectionChunk &debugChunk);
+
   /// Produce a mapping from the type and item indices used in the object
   /// file to those in the destination PDB.
   ///
@@ -177,6 +194,12 @@ private:
 
   std::vector<pdb::SecMapEntry> sectionMap;
 
+  /// Global type hashes computed by computeGHashes().
+  DenseMap<ObjFile *, std::vector<GloballyHashedType>> ownedGHashes;
+
+  /// Section contents relocated by relocateDebugChunks().
+  DenseMap<SectionChunk *, ArrayRef<uint8_t>> relocatedDebugChunks;
+
   /// Type index mappings of type server PDBs that we've loaded so far.
   std::map<codeview::GUID, CVIndexMap> typeServerIndexMappings;
 
@@ -393,7 +416,10 @@ PDBLinker::mergeDebugT(ObjFile *file, CVIndexMap *objectIndexMap) {
   if (config->debugGHashes) {
     ArrayRef<GloballyHashedType> hashes;
     std::vector<GloballyHashedType> ownedHashes;
-    if (Optional<ArrayRef<uint8_t>> debugH = getDebugH(file))
+    auto it = ownedGHashes.find(file);
+    if (it != ownedGHashes.end())
+      hashes = it->second;
+    else if (Optional<ArrayRef<uint8_t>> debugH = getDebugH(file))
       hashes = getHashesFromDebugH(*debugH);
     else {
       ownedHashes = GloballyHashedType::hashTypes(types);
@@ -996,7 +1022,7 @@ void DebugSHandler::handleDebugS(lld::coff::SectionChunk &debugS) {
   DebugSubsectionArray subsections;
 
   ArrayRef<uint8_t> relocatedDebugContents = SectionChunk::consumeDebugMagic(
-      relocateDebugChunk(linker.alloc, debugS), debugS.getSectionName());
+      linker.getRelocatedContents(debugS), debugS.getSectionName());
 
   BinaryStreamReader reader(relocatedDebugContents, support::little);
   exitOnErr(reader.readArray(subsections, relocatedDebugContents.size()));
@@ -1207,7 +1233,7 @@ void PDBLinker::addObjFile(ObjFile *file, CVIndexMap *externIndexMap) {
 
     if (debugChunk->getSectionName() == ".debug$F") {
       ArrayRef<uint8_t> relocatedDebugContents =
-          relocateDebugChunk(alloc, *debugChunk);
+          getRelocatedContents(*debugChunk);
 
       FixedStreamArray<object::FpoData> fpoRecords;
       BinaryStreamReader reader(relocatedDebugContents, support::little);
@@ -1226,6 +1252,150 @@ void PDBLinker::addObjFile(ObjFile *file, CVIndexMap *externIndexMap) {
   dsh.finish();
 }
 
+// Returns the path of the /lldghashcache entry for a type stream. Entries are
+// keyed by the contents of the stream, so unchanged objects hit the cache no
+// matter where they are linked from. The "llvmcache-" prefix makes the files
+// eligible for pruneCache().
+static std::string getGHashCachePath(const CVTypeArray &types) {
+  BinaryStreamRef stream = types.getUnderlyingStream();
+  ArrayRef<uint8_t> data;
+  cantFail(stream.readBytes(0, stream.getLength(), data));
+
+  // Salt the key with the hash format and the linker version so that entries
+  // written by a different lld are never reused. Bump the format version
+  // whenever GloballyHashedType or hashTypes() changes.
+  MD5 hasher;
+  hasher.update("ghash-v1");
+  hasher.update(getLLDVersion());
+  hasher.update(data);
+  MD5::MD5Result hash;
+  hasher.final(hash);
+
+  SmallString<128> path(config->ghashCache);
+  sys::path::append(path, "llvmcache-ghash-" + hash.digest());
+  return path.str();
+}
+
+// Reads global type hashes from a cache entry. Returns false if there is no
+// entry or if it doesn't match the type stream.
+static bool readGHashCache(StringRef path, const CVTypeArray &types,
+                           std::vector<GloballyHashedType> &hashes) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr = MemoryBuffer::getFile(
+      path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+  if (!mbOrErr)
+    return false;
+  StringRef buf = (*mbOrErr)->getBuffer();
+  size_t count = std::distance(types.begin(), types.end());
+  if (buf.size() != count * sizeof(GloballyHashedType))
+    return false;
+  hashes.resize(count);
+  memcpy(hashes.data(), buf.data(), buf.size());
+  return true;
+}
+
+// Writes global type hashes to a cache entry. Failing to do so is not an error
+// since the hashes can always be recomputed; the entry is just left out.
+static void writeGHashCache(StringRef path,
+                            ArrayRef<GloballyHashedType> hashes) {
+  SmallString<128> model(config->ghashCache);
+  sys::path::append(model, "ghash-%%%%%%.tmp");
+  Expected<sys::fs::TempFile> temp = sys::fs::TempFile::create(model);
+  if (!temp) {
+    consumeError(temp.takeError());
+    return;
+  }
+  {
+    raw_fd_ostream os(temp->FD, /*shouldClose=*/false);
+    os.write(reinterpret_cast<const char *>(hashes.data()),
+             hashes.size() * sizeof(GloballyHashedType));
+    os.flush();
+    // An unchecked error would be fatal when os is destroyed.
+    if (os.has_error()) {
+      os.clear_error();
+      consumeError(temp->discard());
+      return;
+    }
+  }
+  if (Error e = temp->keep(path))
+    consumeError(std::move(e));
+}
+
+void PDBLinker::computeGHashes() {
+  if (!config->debugGHashes)
+    return;
+  ScopedTimer t(ghashTimer);
+
+  // Objects using a type server or a precompiled headers object are left to
+  // mergeDebugT(), which has to rewrite their type streams before hashing.
+  std::vector<ObjFile *> files;
+  for (ObjFile *file : ObjFile::instances) {
+    TpiSource *source = file->debugTypesObj;
+    if (source &&
+        (source->kind == TpiSource::Regular ||
+         source->kind == TpiSource::PCH) &&
+        !getDebugH(file))
+      files.push_back(file);
+  }
+
+  // Entries that can't be written are cache misses next time, so a failure
+  // to create the directory is ignored.
+  if (!config->ghashCache.empty())
+    sys::fs::create_directories(config->ghashCache);
+
+  std::vector<std::vector<GloballyHashedType>> hashes(files.size());
+  parallelForEachN(0, files.size(), [&](size_t i) {
+    const CVTypeArray &types = *files[i]->debugTypes;
+    if (config->ghashCache.empty()) {
+      hashes[i] = GloballyHashedType::hashTypes(types);
+      return;
+    }
+    std::string path = getGHashCachePath(types);
+    if (readGHashCache(path, types, hashes[i]))
+      return;
+    hashes[i] = GloballyHashedType::hashTypes(types);
+    writeGHashCache(path, hashes[i]);
+  });
+  for (size_t i = 0; i < files.size(); ++i)
+    ownedGHashes[files[i]] = std::move(hashes[i]);
+
+  if (!config->ghashCache.empty())
+    pruneCache(config->ghashCache, config->ghashCachePolicy);
+}
+
+void PDBLinker::relocateDebugChunks() {
+  ScopedTimer t(relocDebugTimer);
+
+  // The allocator is not thread-safe, so reserve the buffers up front and
+  // only write the section contents in parallel.
+  std::vector<std::pair<SectionChunk *, uint8_t *>> chunks;
+  for (ObjFile *file : ObjFile::instances) {
+    for (SectionChunk *debugChunk : file->getDebugChunks()) {
+      if (!debugChunk->live || debugChunk->getSize() == 0)
+        continue;
+      StringRef name = debugChunk->getSectionName();
+      if (name != ".debug$S" && name != ".debug$F")
+        continue;
+      uint8_t *buffer = alloc.Allocate<uint8_t>(debugChunk->getSize());
+      chunks.emplace_back(debugChunk, buffer);
+      relocatedDebugChunks[debugChunk] =
+          makeArrayRef(buffer, debugChunk->getSize());
+    }
+  }
+
+  parallelForEach(chunks, [](std::pair<SectionChunk *, uint8_t *> &p) {
+    assert(p.first->getOutputSectionIdx() == 0 &&
+           "debug sections should not be in output sections");
+    p.first->writeTo(p.second);
+  });
+}
+
+ArrayRef<uint8_t> PDBLinker::getRelocatedContents(SectionChunk &debugChunk) {
+  auto it = relocatedDebugChunks.find(&debugChunk);
+  if (it != relocatedDebugChunks.end())
+    return it->second;
+  return relocateDebugChunk(alloc, debugChunk);
+}
+
 // Add a module descriptor for every object file. We need to put an absolute
 // path to the object into the PDB. If this is a plain object, we make its
 // path absolute. If it's an object in an archive, we make the archive path
@@ -1282,6 +1452,12 @@ void PDBLinker::addObjectsToPDB() {
 
   createModuleDBI(builder);
 
+  // Do the work that doesn't depend on other objects in parallel. Type and
+  // symbol records are then merged serially in command line order, which
+  // keeps the type indices and the PDB contents deterministic.
+  computeGHashes();
+  relocateDebugChunks();
+
   for (ObjFile *file : ObjFile::instances)
     addObjFile(file);
 
@@ -28,6 +28,8 @@ public:
   void relocateOne(uint8_t *loc, RelType type, uint64_t val) const override;
   RelExpr getRelExpr(RelType type, const Symbol &s,
                      const uint8_t *loc) const override;
+  Optional<RelExpr> classifyRelocation(RelType type, const Symbol &s,
+                                       const uint8_t *loc) const override;
   RelType getDynRel(RelType type) const override;
 };
 } // namespace
@@ -79,8 +81,8 @@ void AMDGPU::relocateOne(uint8_t *loc, RelType type, uint64_t val) const {
   }
 }
 
-RelExpr AMDGPU::getRelExpr(RelType type, const Symbol &s,
-                           const uint8_t *loc) const {
+Optional<RelExpr> AMDGPU::classifyRelocation(RelType type, const Symbol &s,
+                                             const uint8_t *loc) const {
   switch (type) {
   case R_AMDGPU_ABS32:
   case R_AMDGPU_ABS64:
@@ -95,12 +97,19 @@ RelExpr AMDGPU::getRelExpr(RelType type, const Symbol &s,
   case R_AMDGPU_GOTPCREL32_HI:
     return R_GOT_PC;
   default:
-    error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
-          ") against symbol " + toString(s));
-    return R_NONE;
+    return None;
   }
 }
 
+RelExpr AMDGPU::getRelExpr(RelType type, const Symbol &s,
+                           const uint8_t *loc) const {
+  if (Optional<RelExpr> expr = classifyRelocation(type, s, loc))
+    return *expr;
+  error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
+        ") against symbol " + toString(s));
+  return R_NONE;
+}
+
 RelType AMDGPU::getDynRel(RelType type) const {
   if (type == R_AMDGPU_ABS64)
     return type;
@@ -30,6 +30,8 @@ public:
   uint32_t calcEFlags() const override;
   RelExpr getRelExpr(RelType type, const Symbol &s,
                      const uint8_t *loc) const override;
+  Optional<RelExpr> classifyRelocation(RelType type, const Symbol &s,
+                                       const uint8_t *loc) const override;
   int64_t getImplicitAddend(const uint8_t *buf, RelType type) const override;
   RelType getDynRel(RelType type) const override;
   void writeGotPlt(uint8_t *buf, const Symbol &s) const override;
@@ -77,7 +79,8 @@ template <class ELFT> uint32_t MIPS<ELFT>::calcEFlags() const {
 }
 
 template <class ELFT>
-RelExpr MIPS<ELFT>::getRelExpr(RelType type, const Symbol &s,
+Optional<RelExpr>
+MIPS<ELFT>::classifyRelocation(RelType type, const Symbol &s,
                                const uint8_t *loc) const {
   // See comment in the calculateMipsRelChain.
   if (ELFT::Is64Bits || config->mipsN32Abi)
@@ -176,12 +179,22 @@ RelExpr MIPS<ELFT>::getRelExpr(RelType type, const Symbol &s,
   case R_MIPS_NONE:
     return R_NONE;
   default:
-    error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
-          ") against symbol " + toString(s));
-    return R_NONE;
+    return None;
   }
 }
 
+template <class ELFT>
+RelExpr MIPS<ELFT>::getRelExpr(RelType type, const Symbol &s,
+                               const uint8_t *loc) const {
+  if (Optional<RelExpr> expr = classifyRelocation(type, s, loc))
+    return *expr;
+  if (ELFT::Is64Bits || config->mipsN32Abi)
+    type &= 0xff;
+  error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
+        ") against symbol " + toString(s));
+  return R_NONE;
+}
+
 template <class ELFT> RelType MIPS<ELFT>::getDynRel(RelType type) const {
   if (type == symbolicRel)
     return type;
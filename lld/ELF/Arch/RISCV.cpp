@@ -31,6 +31,8 @@ public:
   RelType getDynRel(RelType type) const override;
   RelExpr getRelExpr(RelType type, const Symbol &s,
                      const uint8_t *loc) const override;
+  Optional<RelExpr> classifyRelocation(RelType type, const Symbol &s,
+                                       const uint8_t *loc) const override;
   void relocateOne(uint8_t *loc, RelType type, uint64_t val) const override;
 };
 
@@ -180,8 +182,8 @@ RelType RISCV::getDynRel(RelType type) const {
                                      : static_cast<RelType>(R_RISCV_NONE);
 }
 
-RelExpr RISCV::getRelExpr(const RelType type, const Symbol &s,
-                          const uint8_t *loc) const {
+Optional<RelExpr> RISCV::classifyRelocation(RelType type, const Symbol &s,
+                                            const uint8_t *loc) const {
   switch (type) {
   case R_RISCV_ADD8:
   case R_RISCV_ADD16:
@@ -215,8 +217,8 @@ RelExpr RISCV::getRelExpr(const RelType type, const Symbol &s,
   case R_RISCV_TLS_GD_HI20:
     return R_TLSGD_PC;
   case R_RISCV_TLS_GOT_HI20:
-    config->hasStaticTlsModel = true;
-    return R_GOT_PC;
+    // Leave it to getRelExpr() to record the use of a static TLS model.
+    return None;
   case R_RISCV_TPREL_HI20:
   case R_RISCV_TPREL_LO12_I:
   case R_RISCV_TPREL_LO12_S:
@@ -230,6 +232,15 @@ RelExpr RISCV::getRelExpr(const RelType type, const Symbol &s,
   }
 }
 
+RelExpr RISCV::getRelExpr(const RelType type, const Symbol &s,
+                          const uint8_t *loc) const {
+  if (type == R_RISCV_TLS_GOT_HI20) {
+    config->hasStaticTlsModel = true;
+    return R_GOT_PC;
+  }
+  return *classifyRelocation(type, s, loc);
+}
+
 // Extract bits V[Begin:End], where range is inclusive, and Begin must be < 63.
 static uint32_t extractBits(uint64_t v, uint32_t begin, uint32_t end) {
   return (v & ((1ULL << (begin + 1)) - 1)) >> end;
@@ -25,6 +25,8 @@ public:
   SPARCV9();
   RelExpr getRelExpr(RelType type, const Symbol &s,
                      const uint8_t *loc) const override;
+  Optional<RelExpr> classifyRelocation(RelType type, const Symbol &s,
+                                       const uint8_t *loc) const override;
   void writePlt(uint8_t *buf, uint64_t gotEntryAddr, uint64_t pltEntryAddr,
                 int32_t index, unsigned relOff) const override;
   void relocateOne(uint8_t *loc, RelType type, uint64_t val) const override;
@@ -46,8 +48,8 @@ SPARCV9::SPARCV9() {
   defaultImageBase = 0x100000;
 }
 
-RelExpr SPARCV9::getRelExpr(RelType type, const Symbol &s,
-                            const uint8_t *loc) const {
+Optional<RelExpr> SPARCV9::classifyRelocation(RelType type, const Symbol &s,
+                                              const uint8_t *loc) const {
   switch (type) {
   case R_SPARC_32:
   case R_SPARC_UA32:
@@ -68,12 +70,19 @@ RelExpr SPARCV9::getRelExpr(RelType type, const Symbol &s,
   case R_SPARC_NONE:
     return R_NONE;
   default:
-    error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
-          ") against symbol " + toString(s));
-    return R_NONE;
+    return None;
   }
 }
 
+RelExpr SPARCV9::getRelExpr(RelType type, const Symbol &s,
+                            const uint8_t *loc) const {
+  if (Optional<RelExpr> expr = classifyRelocation(type, s, loc))
+    return *expr;
+  error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
+        ") against symbol " + toString(s));
+  return R_NONE;
+}
+
 void SPARCV9::relocateOne(uint8_t *loc, RelType type, uint64_t val) const {
   switch (type) {
   case R_SPARC_32:
@@ -26,6 +26,8 @@ public:
   int getTlsGdRelaxSkip(RelType type) const override;
   RelExpr getRelExpr(RelType type, const Symbol &s,
                      const uint8_t *loc) const override;
+  Optional<RelExpr> classifyRelocation(RelType type, const Symbol &s,
+                                       const uint8_t *loc) const override;
   int64_t getImplicitAddend(const uint8_t *buf, RelType type) const override;
   void writeGotPltHeader(uint8_t *buf) const override;
   RelType getDynRel(RelType type) const override;
@@ -69,16 +71,8 @@ int X86::getTlsGdRelaxSkip(RelType type) const {
   return 2;
 }
 
-RelExpr X86::getRelExpr(RelType type, const Symbol &s,
-                        const uint8_t *loc) const {
-  // There are 4 different TLS variable models with varying degrees of
-  // flexibility and performance. LocalExec and InitialExec models are fast but
-  // less-flexible models. If they are in use, we set DF_STATIC_TLS flag in the
-  // dynamic section to let runtime know about that.
-  if (type == R_386_TLS_LE || type == R_386_TLS_LE_32 || type == R_386_TLS_IE ||
-      type == R_386_TLS_GOTIE)
-    config->hasStaticTlsModel = true;
-
+Optional<RelExpr> X86::classifyRelocation(RelType type, const Symbol &s,
+                                          const uint8_t *loc) const {
   switch (type) {
   case R_386_8:
   case R_386_16:
@@ -98,8 +92,6 @@ RelExpr X86::getRelExpr(RelType type, const Symbol &s,
     return R_PC;
   case R_386_GOTPC:
     return R_GOTPLTONLY_PC;
-  case R_386_TLS_IE:
-    return R_GOT;
   case R_386_GOT32:
   case R_386_GOT32X:
     // These relocations are arguably mis-designed because their calculations
@@ -138,21 +130,45 @@ RelExpr X86::getRelExpr(RelType type, const Symbol &s,
     // the byte, we can determine whether the instruction uses the operand as an
     // absolute address (R_GOT) or a register-relative address (R_GOTPLT).
     return (loc[-1] & 0xc7) == 0x5 ? R_GOT : R_GOTPLT;
-  case R_386_TLS_GOTIE:
-    return R_GOTPLT;
   case R_386_GOTOFF:
     return R_GOTPLTREL;
+  case R_386_NONE:
+    return R_NONE;
+  default:
+    // The static TLS relocations have a side effect, so getRelExpr() handles
+    // them.
+    return None;
+  }
+}
+
+RelExpr X86::getRelExpr(RelType type, const Symbol &s,
+                        const uint8_t *loc) const {
+  // There are 4 different TLS variable models with varying degrees of
+  // flexibility and performance. LocalExec and InitialExec models are fast but
+  // less-flexible models. If they are in use, we set DF_STATIC_TLS flag in the
+  // dynamic section to let runtime know about that.
+  switch (type) {
+  case R_386_TLS_IE:
+    config->hasStaticTlsModel = true;
+    return R_GOT;
+  case R_386_TLS_GOTIE:
+    config->hasStaticTlsModel = true;
+    return R_GOTPLT;
   case R_386_TLS_LE:
+    config->hasStaticTlsModel = true;
     return R_TLS;
   case R_386_TLS_LE_32:
+    config->hasStaticTlsModel = true;
     return R_NEG_TLS;
-  case R_386_NONE:
-    return R_NONE;
   default:
-    error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
-          ") against symbol " + toString(s));
-    return R_NONE;
+    break;
   }
+
+  if (Optional<RelExpr> expr = classifyRelocation(type, s, loc))
+    return *expr;
+  error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
+        ") against symbol " + toString(s));
+  return R_NONE;
 }
 
 RelExpr X86::adjustRelaxExpr(RelType type, const uint8_t *data,
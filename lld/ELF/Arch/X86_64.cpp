@@ -28,6 +28,8 @@ public:
   int getTlsGdRelaxSkip(RelType type) const override;
   RelExpr getRelExpr(RelType type, const Symbol &s,
                      const uint8_t *loc) const override;
+  Optional<RelExpr> classifyRelocation(RelType type, const Symbol &s,
+                                       const uint8_t *loc) const override;
   RelType getDynRel(RelType type) const override;
   void writeGotPltHeader(uint8_t *buf) const override;
   void writeGotPlt(uint8_t *buf, const Symbol &s) const override;
@@ -71,11 +73,8 @@ X86_64::X86_64() {
 
 int X86_64::getTlsGdRelaxSkip(RelType type) const { return 2; }
 
-RelExpr X86_64::getRelExpr(RelType type, const Symbol &s,
-                           const uint8_t *loc) const {
-  if (type == R_X86_64_GOTTPOFF)
-    config->hasStaticTlsModel = true;
-
+Optional<RelExpr> X86_64::classifyRelocation(RelType type, const Symbol &s,
+                                             const uint8_t *loc) const {
   switch (type) {
   case R_X86_64_8:
   case R_X86_64_16:
@@ -112,7 +111,6 @@ RelExpr X86_64::getRelExpr(RelType type, const Symbol &s,
   case R_X86_64_GOTPCREL:
   case R_X86_64_GOTPCRELX:
   case R_X86_64_REX_GOTPCRELX:
-  case R_X86_64_GOTTPOFF:
     return R_GOT_PC;
   case R_X86_64_GOTOFF64:
     return R_GOTPLTREL;
@@ -122,10 +120,22 @@ RelExpr X86_64::getRelExpr(RelType type, const Symbol &s,
   case R_X86_64_NONE:
     return R_NONE;
   default:
-    error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
-          ") against symbol " + toString(s));
-    return R_NONE;
+    // R_X86_64_GOTTPOFF has a side effect, so getRelExpr() handles it.
+    return None;
+  }
+}
+
+RelExpr X86_64::getRelExpr(RelType type, const Symbol &s,
+                           const uint8_t *loc) const {
+  if (type == R_X86_64_GOTTPOFF) {
+    config->hasStaticTlsModel = true;
+    return R_GOT_PC;
   }
+  if (Optional<RelExpr> expr = classifyRelocation(type, s, loc))
+    return *expr;
+  error(getErrorLocation(loc) + "unknown relocation (" + Twine(type) +
+        ") against symbol " + toString(s));
+  return R_NONE;
 }
 
 void X86_64::writeGotPltHeader(uint8_t *buf) const {
@@ -44,6 +44,7 @@
 #include "OutputSections.h"
 #include "SymbolTable.h"
 #include "Symbols.h"
+#include "lld/Common/ErrorHandler.h"
 
 using namespace llvm;
 using namespace lld;
@@ -225,6 +226,26 @@ DenseMap<const InputSectionBase *, int> CallGraphSort::run() {
     for (int secIndex : c.sections)
       orderMap[sections[secIndex]] = curOrder++;
 
+  // Report the expected instruction TLB footprint of the profiled code.
+  // Clusters are laid out contiguously in the order of decreasing density,
+  // so the hot part of the program occupies a contiguous range whose size
+  // is the sum of the sizes of all clusters that were executed.
+  if (errorHandler().verbose) {
+    size_t numHot = 0;
+    uint64_t hotSize = 0;
+    for (const Cluster &c : clusters) {
+      if (c.weight == 0)
+        continue;
+      ++numHot;
+      hotSize += c.size;
+    }
+    log("call graph profile: " + Twine(numHot) + " hot clusters of " +
+        Twine(clusters.size()) + ", " + Twine(hotSize) + " bytes, " +
+        Twine(divideCeil(hotSize, config->commonPageSize)) + " pages of " +
+        Twine(config->commonPageSize) + " bytes, " +
+        Twine(divideCeil(hotSize, 2 * 1024 * 1024)) + " 2 MiB pages");
+  }
+
   if (!config->printSymbolOrder.empty()) {
     std::error_code ec;
     raw_fd_ostream os(config->printSymbolOrder, ec, sys::fs::F_None);
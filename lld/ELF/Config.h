@@ -185,6 +185,7 @@ struct Configuration {
   bool trace;
   bool thinLTOEmitImportsFiles;
   bool thinLTOIndexOnly;
+  bool timeTraceEnabled;
   bool tocOptimize;
   bool undefinedVersion;
   bool useAndroidRelrTags = false;
@@ -230,10 +231,12 @@ struct Configuration {
   uint64_t maxPageSize;
   uint64_t mipsGotSize;
   uint64_t zStackSize;
+  unsigned compressDebugSectionsLevel;
   unsigned ltoPartitions;
   unsigned ltoo;
   unsigned optimize;
   unsigned thinLTOJobs;
+  unsigned timeTraceGranularity;
   int32_t splitStackAdjustSize;
 
   // The following config options do not directly correspond to any
@@ -45,6 +45,7 @@
 #include "lld/Common/TargetOptionsCommandFlags.h"
 #include "lld/Common/Threads.h"
 #include "lld/Common/Version.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
@@ -55,6 +56,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cstdlib>
 #include <utility>
@@ -90,6 +92,7 @@ bool elf::link(ArrayRef<const char *> args, bool canExitEarly,
   bitcodeFiles.clear();
   objectFiles.clear();
   sharedFiles.clear();
+  prefetchedFiles.clear();
 
   config = make<Configuration>();
   driver = make<LinkerDriver>();
@@ -394,6 +397,22 @@ static void checkZOptions(opt::InputArgList &args) {
       error("unknown -z value: " + StringRef(arg->getValue()));
 }
 
+// Writes the result of the time trace profiler to a file specified by
+// --time-trace-file, or to <output>.time-trace by default.
+static void writeTimeTrace(opt::InputArgList &args) {
+  std::string path = args.getLastArgValue(OPT_time_trace_file_eq);
+  if (path.empty())
+    path = (config->outputFile + ".time-trace").str();
+
+  std::error_code ec;
+  raw_fd_ostream os(path, ec, sys::fs::OF_Text);
+  if (ec) {
+    error("cannot open " + path + ": " + ec.message());
+    return;
+  }
+  timeTraceProfilerWrite(os);
+}
+
 void LinkerDriver::main(ArrayRef<const char *> argsArr) {
   ELFOptTable parser;
   opt::InputArgList args = parser.parse(argsArr.slice(1));
@@ -449,11 +468,51 @@ void LinkerDriver::main(ArrayRef<const char *> argsArr) {
   if (args.hasArg(OPT_version))
     return;
 
+  // Initialize time trace profiler. The trace is written to a file when we
+  // return from this function, after the "ExecuteLinker" scope is closed.
+  if (config->timeTraceEnabled)
+    timeTraceProfilerInitialize(config->timeTraceGranularity);
+  auto writeTrace = make_scope_exit([&] {
+    if (config->timeTraceEnabled) {
+      writeTimeTrace(args);
+      timeTraceProfilerCleanup();
+    }
+  });
+  llvm::TimeTraceScope timeScope("ExecuteLinker", StringRef(""));
+
   initLLVM();
   createFiles(args);
   if (errorCount())
     return;
 
+  // Opening a bitcode file validates it and reads its symbol table, which
+  // adds up with many inputs. Do that in parallel for all bitcode files on
+  // the command line. Errors are collected and reported in input order, and
+  // the files are still added to the link in order.
+  {
+    llvm::TimeTraceScope timeScope("Read bitcode symbol tables",
+                                   StringRef(""));
+    std::vector<BitcodeFile *> bitcodeInputs;
+    for (InputFile *f : files)
+      if (auto *bf = dyn_cast<BitcodeFile>(f))
+        bitcodeInputs.push_back(bf);
+
+    std::vector<std::string> errs(bitcodeInputs.size());
+    parallelForEachN(0, bitcodeInputs.size(), [&](size_t i) {
+      if (Error e = bitcodeInputs[i]->readSymbolTable())
+        errs[i] = toString(std::move(e));
+    });
+
+    for (size_t i = 0, e = bitcodeInputs.size(); i != e; ++i) {
+      if (errs[i].empty())
+        bitcodeInputs[i]->init();
+      else
+        error(toString(bitcodeInputs[i]) + ": " + errs[i]);
+    }
+  }
+  if (errorCount())
+    return;
+
   inferMachineType();
   setConfigs(args);
   checkOptions();
@@ -804,6 +863,8 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasFlag(OPT_check_sections, OPT_no_check_sections, true);
   config->chroot = args.getLastArgValue(OPT_chroot);
   config->compressDebugSections = getCompressDebugSections(args);
+  config->compressDebugSectionsLevel = args::getInteger(
+      args, OPT_compress_debug_sections_level, zlib::DefaultCompression);
   config->cref = args.hasFlag(OPT_cref, OPT_no_cref, false);
   config->defineCommon = args.hasFlag(OPT_define_common, OPT_no_define_common,
                                       !args.hasArg(OPT_relocatable));
@@ -903,6 +964,9 @@ static void readConfigs(opt::InputArgList &args) {
       getOldNewOptions(args, OPT_plugin_opt_thinlto_object_suffix_replace_eq);
   config->thinLTOPrefixReplace =
       getOldNewOptions(args, OPT_plugin_opt_thinlto_prefix_replace_eq);
+  config->timeTraceEnabled = args.hasArg(OPT_time_trace);
+  config->timeTraceGranularity =
+      args::getInteger(args, OPT_time_trace_granularity, 500);
   config->trace = args.hasArg(OPT_trace);
   config->undefined = args::getStrings(args, OPT_undefined);
   config->undefinedVersion =
@@ -958,6 +1022,9 @@ static void readConfigs(opt::InputArgList &args) {
   if (config->thinLTOJobs == 0)
     error("--thinlto-jobs: number of threads must be > 0");
 
+  if (config->compressDebugSectionsLevel > 9)
+    error("--compress-debug-sections-level: level must be in [0, 9]");
+
   if (config->splitStackAdjustSize < 0)
     error("--split-stack-adjust-size: size must be >= 0");
 
@@ -1113,6 +1180,17 @@ void LinkerDriver::createFiles(opt::InputArgList &args) {
   // For --{push,pop}-state.
   std::vector<std::tuple<bool, bool, bool>> stack;
 
+  // With many inputs, especially on a network filesystem, waiting for each
+  // file in turn adds up. Open the files named on the command line all at
+  // once before processing them in order.
+  if (threadsEnabled) {
+    std::vector<StringRef> inputs;
+    for (auto *arg : args.filtered(OPT_INPUT))
+      inputs.push_back(arg->getValue());
+    if (inputs.size() > 1)
+      prefetchFiles(inputs);
+  }
+
   // Iterate over argv to process input files and positional arguments.
   for (auto *arg : args) {
     switch (arg->getOption().getID()) {
@@ -1209,6 +1287,9 @@ void LinkerDriver::createFiles(opt::InputArgList &args) {
     }
   }
 
+  // Free the prefetched buffers that no input ended up using.
+  prefetchedFiles.clear();
+
   if (files.empty() && errorCount() == 0)
     error("no input files");
 }
@@ -1706,8 +1787,11 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   // symbols that we need to the symbol table. This process might
   // add files to the link, via autolinking, these files are always
   // appended to the Files vector.
-  for (size_t i = 0; i < files.size(); ++i)
-    parseFile(files[i]);
+  {
+    llvm::TimeTraceScope timeScope("Parse input files", StringRef(""));
+    for (size_t i = 0; i < files.size(); ++i)
+      parseFile(files[i]);
+  }
 
   // Now that we have every file, we can decide if we will need a
   // dynamic symbol table.
@@ -1799,7 +1883,10 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   //
   // With this the symbol table should be complete. After this, no new names
   // except a few linker-synthesized ones will be added to the symbol table.
-  compileBitcodeFiles<ELFT>();
+  {
+    llvm::TimeTraceScope timeScope("LTO", StringRef(""));
+    compileBitcodeFiles<ELFT>();
+  }
   if (errorCount())
     return;
 
@@ -1889,11 +1976,21 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
 
   // Do size optimizations: garbage collection, merging of SHF_MERGE sections
   // and identical code folding.
-  splitSections<ELFT>();
-  markLive<ELFT>();
+  {
+    llvm::TimeTraceScope timeScope("Split sections", StringRef(""));
+    splitSections<ELFT>();
+  }
+  {
+    llvm::TimeTraceScope timeScope("Mark live", StringRef(""));
+    markLive<ELFT>();
+  }
   demoteSharedSymbols();
-  mergeSections();
+  {
+    llvm::TimeTraceScope timeScope("Merge sections", StringRef(""));
+    mergeSections();
+  }
   if (config->icf != ICFLevel::None) {
+    llvm::TimeTraceScope timeScope("ICF", StringRef(""));
     findKeepUniqueSections<ELFT>(args);
     doIcf<ELFT>();
   }
@@ -1907,5 +2004,8 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   }
 
   // Write the result to the file.
-  writeResult<ELFT>();
+  {
+    llvm::TimeTraceScope timeScope("Write output file", StringRef(""));
+    writeResult<ELFT>();
+  }
 }
@@ -79,6 +79,7 @@
 #include "SyntheticSections.h"
 #include "Writer.h"
 #include "lld/Common/Threads.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/BinaryFormat/ELF.h"
 #include "llvm/Object/ELF.h"
@@ -422,6 +423,21 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   ++cnt;
 }
 
+// Returns a hash value of the "non-moving" part of a given section. Sections
+// that are equal in terms of equalsConstant always have the same hash value,
+// so this is used as an initial partition. Hashing relocation offsets and
+// types in addition to section contents separates sections that differ only
+// in relocations before we start running the more expensive comparisons.
+template <class ELFT, class RelTy>
+static uint32_t getConstantHash(InputSection *isec, ArrayRef<RelTy> rels) {
+  hash_code hash = hash_combine(xxh3_64bits(isec->data()), isec->flags,
+                                rels.size());
+  for (const RelTy &rel : rels)
+    hash = hash_combine(hash, (uint64_t)rel.r_offset,
+                        rel.getType(config->isMips64EL));
+  return hash;
+}
+
 // Combine the hashes of the sections referenced by the given section into its
 // hash.
 template <class ELFT, class RelTy>
@@ -453,7 +469,10 @@ template <class ELFT> void ICF<ELFT>::run() {
 
   // Initially, we use hash values to partition sections.
   parallelForEach(sections, [&](InputSection *s) {
-    s->eqClass[0] = xxHash64(s->data());
+    if (s->areRelocsRela)
+      s->eqClass[0] = getConstantHash<ELFT>(s, s->template relas<ELFT>());
+    else
+      s->eqClass[0] = getConstantHash<ELFT>(s, s->template rels<ELFT>());
   });
 
   for (unsigned cnt = 0; cnt != 2; ++cnt) {
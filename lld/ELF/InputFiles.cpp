@@ -15,6 +15,7 @@
 #include "SyntheticSections.h"
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/Memory.h"
+#include "lld/Common/Threads.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/CodeGen/Analysis.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
@@ -88,21 +89,49 @@ InputFile::InputFile(Kind k, MemoryBufferRef m)
     ++nextGroupId;
 }
 
-Optional<MemoryBufferRef> elf::readFile(StringRef path) {
-  // The --chroot option changes our virtual root directory.
-  // This is useful when you are dealing with files created by --reproduce.
+StringMap<std::unique_ptr<MemoryBuffer>> elf::prefetchedFiles;
+
+// The --chroot option changes our virtual root directory.
+// This is useful when you are dealing with files created by --reproduce.
+static StringRef applyChroot(StringRef path) {
   if (!config->chroot.empty() && path.startswith("/"))
-    path = saver.save(config->chroot + path);
+    return saver.save(config->chroot + path);
+  return path;
+}
+
+void elf::prefetchFiles(ArrayRef<StringRef> paths) {
+  // Usually only a few members of an archive are pulled into the link, so
+  // reading all of it ahead of time would waste I/O and memory. We don't want
+  // to open the files to look at their magic here, so go by the extension.
+  std::vector<std::string> names;
+  for (StringRef path : paths)
+    if (!path.endswith(".a"))
+      names.push_back(applyChroot(path));
+  auto bufs = MemoryBuffer::getFiles(names, /*RequiresNullTerminator=*/false);
+  // Errors are reported by readFile when the file is actually needed.
+  for (size_t i = 0, e = names.size(); i != e; ++i)
+    if (bufs[i])
+      prefetchedFiles[names[i]] = std::move(*bufs[i]);
+}
 
+Optional<MemoryBufferRef> elf::readFile(StringRef path) {
+  path = applyChroot(path);
   log(path);
 
-  auto mbOrErr = MemoryBuffer::getFile(path, -1, false);
-  if (auto ec = mbOrErr.getError()) {
-    error("cannot open " + path + ": " + ec.message());
-    return None;
+  std::unique_ptr<MemoryBuffer> mb;
+  auto it = prefetchedFiles.find(path);
+  if (it != prefetchedFiles.end()) {
+    mb = std::move(it->second);
+    prefetchedFiles.erase(it);
+  } else {
+    auto mbOrErr = MemoryBuffer::getFile(path, -1, false);
+    if (auto ec = mbOrErr.getError()) {
+      error("cannot open " + path + ": " + ec.message());
+      return None;
+    }
+    mb = std::move(*mbOrErr);
   }
 
-  std::unique_ptr<MemoryBuffer> &mb = *mbOrErr;
   MemoryBufferRef mbref = mb->getMemBufferRef();
   make<std::unique_ptr<MemoryBuffer>>(std::move(mb)); // take MB ownership
 
@@ -189,6 +218,10 @@ template <class ELFT> static void doParseFile(InputFile *file) {
 
 // Add symbols in File to the symbol table.
 void elf::parseFile(InputFile *file) {
+  if (auto *f = dyn_cast<BitcodeFile>(file))
+    if (!f->obj)
+      f->init();
+
   switch (config->ekind) {
   case ELF32LEKind:
     doParseFile<ELF32LE>(file);
@@ -1052,10 +1085,30 @@ template <class ELFT> void ObjFile<ELFT>::initializeSymbols() {
 
   // Our symbol table may have already been partially initialized
   // because of LazyObjFile.
-  for (size_t i = 0, end = eSyms.size(); i != end; ++i)
-    if (!this->symbols[i] && eSyms[i].getBinding() != STB_LOCAL)
-      this->symbols[i] =
-          symtab->insert(CHECK(eSyms[i].getName(this->stringTable), this));
+  std::vector<uint32_t> globals;
+  std::vector<CachedHashStringRef> keys;
+  for (size_t i = 0, end = eSyms.size(); i != end; ++i) {
+    if (!this->symbols[i] && eSyms[i].getBinding() != STB_LOCAL) {
+      globals.push_back(i);
+      keys.emplace_back(CHECK(eSyms[i].getName(this->stringTable), this), 0);
+    }
+  }
+
+  // Hashing symbol names is the most expensive part of symbol insertion,
+  // so we do that in parallel if there are many symbols. Insertion itself
+  // is done serially in the symbol table order to keep the output
+  // deterministic.
+  auto computeKey = [&](size_t i) {
+    keys[i] = SymbolTable::getKey(keys[i].val());
+  };
+  if (keys.size() < 1024)
+    for (size_t i = 0, end = keys.size(); i != end; ++i)
+      computeKey(i);
+  else
+    parallelForEachN(0, keys.size(), computeKey);
+
+  for (size_t i = 0, end = globals.size(); i != end; ++i)
+    this->symbols[globals[i]] = symtab->insert(keys[i]);
 
   // Fill this->Symbols. A symbol is either local or global.
   for (size_t i = 0, end = eSyms.size(); i != end; ++i) {
@@ -1437,13 +1490,26 @@ BitcodeFile::BitcodeFile(MemoryBufferRef mb, StringRef archiveName,
   // into consideration at LTO time (which very likely causes undefined
   // symbols later in the link stage). So we append file offset to make
   // filename unique.
-  StringRef name = archiveName.empty()
-                       ? saver.save(path)
-                       : saver.save(archiveName + "(" + path + " at " +
-                                    utostr(offsetInArchive) + ")");
-  MemoryBufferRef mbref(mb.getBuffer(), name);
+  ltoName = archiveName.empty()
+                ? saver.save(path)
+                : saver.save(archiveName + "(" + path + " at " +
+                             utostr(offsetInArchive) + ")");
+}
+
+Error BitcodeFile::readSymbolTable() {
+  MemoryBufferRef mbref(mb.getBuffer(), ltoName);
+  Expected<std::unique_ptr<lto::InputFile>> objOrErr =
+      lto::InputFile::create(mbref);
+  if (!objOrErr)
+    return objOrErr.takeError();
+  obj = std::move(*objOrErr);
+  return Error::success();
+}
 
-  obj = CHECK(lto::InputFile::create(mbref), this);
+void BitcodeFile::init() {
+  if (!obj)
+    if (Error e = readSymbolTable())
+      fatal(toString(this) + ": " + toString(std::move(e)));
 
   Triple t(obj->getTargetTriple());
   ekind = getBitcodeELFKind(t);
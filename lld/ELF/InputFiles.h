@@ -16,6 +16,7 @@
 #include "llvm/ADT/CachedHashString.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugLine.h"
 #include "llvm/IR/Comdat.h"
 #include "llvm/Object/Archive.h"
@@ -54,6 +55,14 @@ extern std::unique_ptr<llvm::TarWriter> tar;
 // Opens a given file.
 llvm::Optional<MemoryBufferRef> readFile(StringRef path);
 
+// Opens the given files concurrently ahead of time, so that the readFile
+// calls for them later don't have to wait for I/O one file at a time.
+// Archives are skipped.
+void prefetchFiles(ArrayRef<StringRef> paths);
+
+// Buffers opened by prefetchFiles that readFile hasn't asked for yet.
+extern llvm::StringMap<std::unique_ptr<MemoryBuffer>> prefetchedFiles;
+
 // Add symbols in File to the symbol table.
 void parseFile(InputFile *file);
 
@@ -343,7 +352,22 @@ public:
               uint64_t offsetInArchive);
   static bool classof(const InputFile *f) { return f->kind() == BitcodeKind; }
   template <class ELFT> void parse();
+
+  // Reads the bitcode symbol table. This is separate from the constructor
+  // and doesn't report errors, so that the driver can do it for all input
+  // files in parallel and then report errors in input order.
+  llvm::Error readSymbolTable();
+
+  // Sets up the file from its symbol table, reading the symbol table first
+  // if that hasn't been done yet. Files that the driver didn't initialize are
+  // initialized by parseFile().
+  void init();
+
   std::unique_ptr<llvm::lto::InputFile> obj;
+
+private:
+  // The unique module identifier passed to LTO.
+  StringRef ltoName;
 };
 
 // .so file.
@@ -1240,6 +1240,7 @@ void MergeInputSection::splitNonStrings(ArrayRef<uint8_t> data,
   assert((size % entSize) == 0);
   bool isAlloc = flags & SHF_ALLOC;
 
+  pieces.reserve(size / entSize);
   for (size_t i = 0; i != size; i += entSize)
     pieces.emplace_back(i, xxHash64(data.slice(i, entSize)), !isAlloc);
 }
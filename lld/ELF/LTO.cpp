@@ -31,6 +31,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Threading.h"
 #include <algorithm>
 #include <cstddef>
 #include <memory>
@@ -136,7 +137,9 @@ BitcodeCompiler::BitcodeCompiler() {
     auto onIndexWrite = [&](StringRef s) { thinIndices.erase(s); };
     backend = lto::createWriteIndexesThinBackend(
         config->thinLTOPrefixReplace.first, config->thinLTOPrefixReplace.second,
-        config->thinLTOEmitImportsFiles, indexFile.get(), onIndexWrite);
+        config->thinLTOEmitImportsFiles, indexFile.get(), onIndexWrite,
+        config->thinLTOJobs == -1U ? heavyweight_hardware_concurrency()
+                                   : config->thinLTOJobs);
   } else if (config->thinLTOJobs != -1U) {
     backend = lto::createInProcessThinBackend(config->thinLTOJobs);
   }
@@ -113,7 +113,14 @@ void MarkLive<ELFT>::resolveReloc(InputSectionBase &sec, RelTy &rel,
     if (!ss->isWeak())
       ss->getFile().isNeeded = true;
 
-  for (InputSectionBase *sec : cNamedSections.lookup(sym.getName()))
+  // Only __start_ and __stop_ symbols can refer to C-named sections.
+  // Checking the prefix first avoids hashing the name of every undefined
+  // or shared symbol referenced by a live section.
+  StringRef name = sym.getName();
+  if (cNamedSections.empty() ||
+      (!name.startswith("__start_") && !name.startswith("__stop_")))
+    return;
+  for (InputSectionBase *sec : cNamedSections.lookup(name))
     enqueue(sec, 0);
 }
 
@@ -191,11 +191,59 @@ template <class ELFT> void OutputSection::maybeCompress() {
   hdr->ch_size = size;
   hdr->ch_addralign = alignment;
 
-  // Write section contents to a temporary buffer and compress it.
+  // Write section contents to a temporary buffer and compress it. Large
+  // debug sections dominate link time when compressed serially, so split the
+  // contents into 1 MiB shards and compress them in parallel. The shards are
+  // raw deflate streams which form a single zlib stream once concatenated
+  // between a zlib header and the Adler-32 checksum of the whole input.
   std::vector<uint8_t> buf(size);
   writeTo<ELFT>(buf.data());
-  if (Error e = zlib::compress(toStringRef(buf), compressedData))
-    fatal("compress failed: " + llvm::toString(std::move(e)));
+  StringRef input = toStringRef(buf);
+
+  constexpr size_t shardSize = 1 << 20;
+  size_t numShards = std::max<size_t>(1, divideCeil(input.size(), shardSize));
+  std::vector<SmallVector<char, 0>> shards(numShards);
+  std::vector<uint32_t> checksums(numShards);
+  std::vector<std::string> errors(numShards);
+  int level = config->compressDebugSectionsLevel;
+  parallelForEachN(0, numShards, [&](size_t i) {
+    StringRef shard = input.substr(i * shardSize, shardSize);
+    if (Error e = zlib::compressShard(shard, shards[i], i == numShards - 1,
+                                      level)) {
+      errors[i] = llvm::toString(std::move(e));
+      return;
+    }
+    checksums[i] = zlib::adler32(1, shard);
+  });
+
+  // fatal() exits the process, so it must not be called from the workers.
+  for (const std::string &e : errors)
+    if (!e.empty())
+      fatal("compress failed: " + e);
+
+  // The zlib header describes a deflate stream with a 32 KiB window. Its
+  // FLEVEL field records roughly which level was used; FCHECK makes the
+  // header a multiple of 31.
+  unsigned flevel = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+  uint16_t zlibHeader = 0x7800 | flevel << 6;
+  zlibHeader += 31 - zlibHeader % 31;
+  size_t compressedSize = 2 + 4;
+  for (const SmallVector<char, 0> &shard : shards)
+    compressedSize += shard.size();
+  compressedData.reserve(compressedSize);
+  compressedData.push_back(zlibHeader >> 8);
+  compressedData.push_back(zlibHeader & 0xff);
+
+  uint32_t checksum = 1;
+  for (size_t i = 0; i < numShards; ++i) {
+    compressedData.append(shards[i].begin(), shards[i].end());
+    checksum = zlib::adler32Combine(
+        checksum, checksums[i],
+        std::min(shardSize, input.size() - i * shardSize));
+    shards[i] = {};
+  }
+  compressedData.resize(compressedSize);
+  write32be(compressedData.data() + compressedSize - 4, checksum);
 
   // Update section headers.
   size = sizeof(Elf_Chdr) + compressedData.size();
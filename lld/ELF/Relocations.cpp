@@ -52,6 +52,7 @@
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/Memory.h"
 #include "lld/Common/Strings.h"
+#include "lld/Common/Threads.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/raw_ostream.h"
@@ -1104,7 +1105,7 @@ static std::vector<IRelativeReloc> iRelativeRelocs;
 
 template <class ELFT, class RelTy>
 static void scanReloc(InputSectionBase &sec, OffsetGetter &getOffset, RelTy *&i,
-                      RelTy *end) {
+                      RelTy *end, Optional<RelExpr> precomputedExpr) {
   const RelTy &rel = *i;
   uint32_t symIndex = rel.getSymbol(config->isMips64EL);
   Symbol &sym = sec.getFile<ELFT>()->getSymbol(symIndex);
@@ -1129,7 +1130,9 @@ static void scanReloc(InputSectionBase &sec, OffsetGetter &getOffset, RelTy *&i,
     return;
 
   const uint8_t *relocatedAddr = sec.data().begin() + rel.r_offset;
-  RelExpr expr = target->getRelExpr(type, sym, relocatedAddr);
+  RelExpr expr = precomputedExpr
+                     ? *precomputedExpr
+                     : target->getRelExpr(type, sym, relocatedAddr);
 
   // Ignore "hint" relocations because they are only markers for relaxation.
   if (oneof<R_HINT, R_NONE>(expr))
@@ -1342,15 +1345,44 @@ static void scanReloc(InputSectionBase &sec, OffsetGetter &getOffset, RelTy *&i,
   processRelocAux<ELFT>(sec, expr, type, offset, sym, rel, addend);
 }
 
+// Returns the result of TargetInfo::classifyRelocation for each relocation in
+// a given section. classifyRelocation has no side effects and doesn't depend
+// on the state of symbols or synthetic sections that scanReloc() mutates, so
+// this function can be called for different sections in parallel.
 template <class ELFT, class RelTy>
-static void scanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels) {
+static std::vector<Optional<RelExpr>> getRelExprs(InputSectionBase &sec,
+                                                  ArrayRef<RelTy> rels) {
+  ObjFile<ELFT> *file = sec.getFile<ELFT>();
+  const uint8_t *buf = sec.data().begin();
+
+  std::vector<Optional<RelExpr>> exprs;
+  exprs.reserve(rels.size());
+  for (const RelTy &rel : rels) {
+    Symbol &sym = file->getSymbol(rel.getSymbol(config->isMips64EL));
+    exprs.push_back(target->classifyRelocation(
+        rel.getType(config->isMips64EL), sym, buf + rel.r_offset));
+  }
+  return exprs;
+}
+
+template <class ELFT>
+static std::vector<Optional<RelExpr>> getRelExprs(InputSectionBase &s) {
+  if (s.areRelocsRela)
+    return getRelExprs<ELFT>(s, s.relas<ELFT>());
+  return getRelExprs<ELFT>(s, s.rels<ELFT>());
+}
+
+template <class ELFT, class RelTy>
+static void scanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels,
+                       ArrayRef<Optional<RelExpr>> exprs) {
   OffsetGetter getOffset(sec);
 
   // Not all relocations end up in Sec.Relocations, but a lot do.
   sec.relocations.reserve(rels.size());
 
   for (auto i = rels.begin(), end = rels.end(); i != end;)
-    scanReloc<ELFT>(sec, getOffset, i, end);
+    scanReloc<ELFT>(sec, getOffset, i, end,
+                    exprs.empty() ? None : exprs[i - rels.begin()]);
 
   // Sort relocations by offset for more efficient searching for
   // R_RISCV_PCREL_HI20 and R_PPC64_ADDR64.
@@ -1362,11 +1394,39 @@ static void scanRelocs(InputSectionBase &sec, ArrayRef<RelTy> rels) {
                       });
 }
 
-template <class ELFT> void elf::scanRelocations(InputSectionBase &s) {
-  if (s.areRelocsRela)
-    scanRelocs<ELFT>(s, s.relas<ELFT>());
-  else
-    scanRelocs<ELFT>(s, s.rels<ELFT>());
+// Scans relocations of given sections.
+//
+// Scanning is done in two steps. First, we classify relocations using
+// TargetInfo::classifyRelocation. That is a pure function of relocations, so
+// we do it in parallel. Then, we process GOT, PLT and copy relocation demands
+// for each relocation. That mutates symbols and synthetic sections, so we do
+// it on a single thread in the input order, which makes the output identical
+// to a single-threaded link. Relocations that classifyRelocation can't handle
+// (unknown types and those that record a static TLS model) are passed to
+// getRelExpr in that second step, so their diagnostics and side effects
+// happen in input order and only for relocations that are not skipped.
+template <class ELFT>
+void elf::scanRelocations(ArrayRef<InputSectionBase *> sections) {
+  // MIPS N32 relocations are chained, and .eh_frame relocations may point to
+  // dead pieces for which we must not call getRelExpr. We don't bother
+  // classifying them in advance.
+  std::vector<std::vector<Optional<RelExpr>>> exprs(sections.size());
+  if (threadsEnabled && !config->mipsN32Abi)
+    parallelForEachN(0, sections.size(), [&](size_t i) {
+      if (!isa<EhInputSection>(sections[i]))
+        exprs[i] = getRelExprs<ELFT>(*sections[i]);
+    });
+
+  for (size_t i = 0, e = sections.size(); i != e; ++i) {
+    InputSectionBase &s = *sections[i];
+    if (s.areRelocsRela)
+      scanRelocs<ELFT>(s, s.relas<ELFT>(), exprs[i]);
+    else
+      scanRelocs<ELFT>(s, s.rels<ELFT>(), exprs[i]);
+
+    // Free memory as early as possible.
+    exprs[i] = {};
+  }
 }
 
 // Figure out which representation to use for any absolute relocs to
@@ -1809,10 +1869,10 @@ bool ThunkCreator::createThunks(ArrayRef<OutputSection *> outputSections) {
   return addressesChanged;
 }
 
-template void elf::scanRelocations<ELF32LE>(InputSectionBase &);
-template void elf::scanRelocations<ELF32BE>(InputSectionBase &);
-template void elf::scanRelocations<ELF64LE>(InputSectionBase &);
-template void elf::scanRelocations<ELF64BE>(InputSectionBase &);
+template void elf::scanRelocations<ELF32LE>(ArrayRef<InputSectionBase *>);
+template void elf::scanRelocations<ELF32BE>(ArrayRef<InputSectionBase *>);
+template void elf::scanRelocations<ELF64LE>(ArrayRef<InputSectionBase *>);
+template void elf::scanRelocations<ELF64BE>(ArrayRef<InputSectionBase *>);
 template void elf::reportUndefinedSymbols<ELF32LE>();
 template void elf::reportUndefinedSymbols<ELF32BE>();
 template void elf::reportUndefinedSymbols<ELF64LE>();
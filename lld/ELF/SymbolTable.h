@@ -43,6 +43,14 @@ public:
 
   Symbol *insert(StringRef name);
 
+  // Same as insert(StringRef), but takes a key returned by getKey(). Computing
+  // a key involves hashing a symbol name, which is relatively expensive, so
+  // this allows callers to compute keys for many symbols in parallel before
+  // inserting them in a deterministic order.
+  Symbol *insert(llvm::CachedHashStringRef key);
+
+  static llvm::CachedHashStringRef getKey(StringRef name);
+
   Symbol *addSymbol(const Symbol &New);
 
   void scanVersionScript();
@@ -2560,17 +2560,23 @@ createSymbols(ArrayRef<std::vector<GdbIndexSection::NameAttrEntry>> nameAttrs,
     }
   });
 
+  // The sharded map is no longer needed. Free it before allocating
+  // the flattened vector to reduce peak memory usage.
+  map.clear();
+
   size_t numSymbols = 0;
   for (ArrayRef<GdbSymbol> v : symbols)
     numSymbols += v.size();
 
   // The return type is a flattened vector, so we'll copy each vector
-  // contents to Ret.
+  // contents to Ret. Each shard is freed as soon as it is copied.
   std::vector<GdbSymbol> ret;
   ret.reserve(numSymbols);
-  for (std::vector<GdbSymbol> &vec : symbols)
+  for (std::vector<GdbSymbol> &vec : symbols) {
     for (GdbSymbol &sym : vec)
       ret.push_back(std::move(sym));
+    vec = std::vector<GdbSymbol>();
+  }
 
   // CU vectors and symbol names are adjacent in the output file.
   // We can compute their offsets in the output file now.
@@ -2671,21 +2677,20 @@ void GdbIndexSection::writeTo(uint8_t *buf) {
 
   buf += symtabSize * 8;
 
-  // Write the string pool.
+  // Write the constant pool, which consists of the CU vectors followed by
+  // the string pool. Their offsets have been computed in advance, so we
+  // can write them in parallel.
   hdr->constantPoolOff = buf - start;
   parallelForEach(symbols, [&](GdbSymbol &sym) {
-    memcpy(buf + sym.nameOff, sym.name.data(), sym.name.size());
-  });
-
-  // Write the CU vectors.
-  for (GdbSymbol &sym : symbols) {
-    write32le(buf, sym.cuVector.size());
-    buf += 4;
+    uint8_t *p = buf + sym.cuVectorOff;
+    write32le(p, sym.cuVector.size());
+    p += 4;
     for (uint32_t val : sym.cuVector) {
-      write32le(buf, val);
-      buf += 4;
+      write32le(p, val);
+      p += 4;
     }
-  }
+    memcpy(buf + sym.nameOff, sym.name.data(), sym.name.size());
+  });
 }
 
 bool GdbIndexSection::isNeeded() const { return !chunks.empty(); }
@@ -2943,11 +2948,13 @@ void MergeTailSection::finalizeContents() {
 
   // finalize() fixed tail-optimized strings, so we can now get
   // offsets of strings. Get an offset for each string and save it
-  // to a corresponding SectionPiece for easy access.
-  for (MergeInputSection *sec : sections)
+  // to a corresponding SectionPiece for easy access. getOffset() doesn't
+  // mutate the builder, so we can do this in parallel.
+  parallelForEach(sections, [&](MergeInputSection *sec) {
     for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
       if (sec->pieces[i].live)
         sec->pieces[i].outputOff = builder.getOffset(sec->getData(i));
+  });
 }
 
 void MergeNoTailSection::writeTo(uint8_t *buf) {
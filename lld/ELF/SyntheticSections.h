@@ -705,9 +705,12 @@ public:
     std::vector<CuEntry> compilationUnits;
   };
 
+  // There are millions of GdbSymbols for large programs, and most symbols
+  // are referenced from only one compilation unit, so we use a SmallVector
+  // for cuVector, which is smaller than std::vector.
   struct GdbSymbol {
     llvm::CachedHashStringRef name;
-    std::vector<uint32_t> cuVector;
+    llvm::SmallVector<uint32_t, 0> cuVector;
     uint32_t nameOff;
     uint32_t cuVectorOff;
   };
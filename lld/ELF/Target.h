@@ -11,6 +11,7 @@
 
 #include "InputSection.h"
 #include "lld/Common/ErrorHandler.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/Object/ELF.h"
 #include "llvm/Support/MathExtras.h"
 #include <array>
@@ -28,6 +29,16 @@ public:
   virtual uint32_t calcEFlags() const { return 0; }
   virtual RelExpr getRelExpr(RelType type, const Symbol &s,
                              const uint8_t *loc) const = 0;
+
+  // Returns the same value as getRelExpr() without side effects, so that it
+  // can be called from multiple threads. Returns None if getRelExpr() would
+  // report an error or update the global state for the relocation; callers
+  // then need to call getRelExpr() on the main thread.
+  virtual llvm::Optional<RelExpr> classifyRelocation(RelType type,
+                                                     const Symbol &s,
+                                                     const uint8_t *loc) const {
+    return getRelExpr(type, s, loc);
+  }
   virtual RelType getDynRel(RelType type) const { return 0; }
   virtual void writeGotPltHeader(uint8_t *buf) const {}
   virtual void writeGotHeader(uint8_t *buf) const {}
@@ -26,6 +26,7 @@
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/RandomNumberGenerator.h"
 #include "llvm/Support/SHA1.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/xxhash.h"
 #include <climits>
 
@@ -577,7 +578,10 @@ template <class ELFT> void Writer<ELFT>::run() {
   // completes section contents. For example, we need to add strings
   // to the string table, and add entries to .got and .plt.
   // finalizeSections does that.
-  finalizeSections();
+  {
+    llvm::TimeTraceScope timeScope("Finalize sections", StringRef(""));
+    finalizeSections();
+  }
   checkExecuteOnly();
   if (errorCount())
     return;
@@ -621,12 +625,15 @@ template <class ELFT> void Writer<ELFT>::run() {
   if (errorCount())
     return;
 
-  if (!config->oFormatBinary) {
-    writeTrapInstr();
-    writeHeader();
-    writeSections();
-  } else {
-    writeSectionsBinary();
+  {
+    llvm::TimeTraceScope timeScope("Write sections", StringRef(""));
+    if (!config->oFormatBinary) {
+      writeTrapInstr();
+      writeHeader();
+      writeSections();
+    } else {
+      writeSectionsBinary();
+    }
   }
 
   // Backfill .note.gnu.build-id section content. This is done at last
@@ -1738,7 +1745,10 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
   // Scan relocations. This must be done after every symbol is declared so that
   // we can correctly decide if a dynamic relocation is needed.
   if (!config->relocatable) {
-    forEachRelSec(scanRelocations<ELFT>);
+    llvm::TimeTraceScope timeScope("Scan relocations", StringRef(""));
+    std::vector<InputSectionBase *> relSecs;
+    forEachRelSec([&](InputSectionBase &s) { relSecs.push_back(&s); });
+    scanRelocations<ELFT>(relSecs);
     reportUndefinedSymbols<ELFT>();
   }
 
@@ -1927,7 +1937,11 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
   // 3) Assign the final values for the linker script symbols. Linker scripts
   //    sometimes using forward symbol declarations. We want to set the correct
   //    values. They also might change after adding the thunks.
-  finalizeAddressDependentContent();
+  {
+    llvm::TimeTraceScope timeScope("Finalize address dependent content",
+                                   StringRef(""));
+    finalizeAddressDependentContent();
+  }
 
   // finalizeAddressDependentContent may have added local symbols to the static symbol table.
   finalizeSynthetic(in.symTab);
@@ -0,0 +1,33 @@
+# REQUIRES: x86
+## With threads enabled, the files named on the command line are opened
+## ahead of time (archives excepted). Check that this doesn't change the
+## output, and that a missing input is still reported.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64-unknown-linux %s -o %t1.o
+# RUN: echo '.globl foo; foo: ret' | \
+# RUN:   llvm-mc -filetype=obj -triple=x86_64-unknown-linux - -o %t2.o
+# RUN: echo '.globl bar; bar: ret' | \
+# RUN:   llvm-mc -filetype=obj -triple=x86_64-unknown-linux - -o %t3.o
+# RUN: echo '.globl unused; unused: ret' | \
+# RUN:   llvm-mc -filetype=obj -triple=x86_64-unknown-linux - -o %t4.o
+# RUN: rm -f %t.a
+# RUN: llvm-ar rcs %t.a %t3.o %t4.o
+
+# RUN: ld.lld --threads %t1.o %t2.o %t.a -o %t.threads
+# RUN: ld.lld --no-threads %t1.o %t2.o %t.a -o %t.nothreads
+# RUN: cmp %t.threads %t.nothreads
+# RUN: llvm-nm %t.threads | FileCheck %s
+
+# CHECK:      T _start
+# CHECK-NEXT: T bar
+# CHECK-NEXT: T foo
+# CHECK-NOT:  unused
+
+# RUN: not ld.lld --threads %t1.o %t.missing.o %t2.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck --check-prefix=ERR %s
+# ERR: cannot open {{.*}}.missing.o
+
+.globl _start
+_start:
+  call foo
+  call bar
@@ -0,0 +1,46 @@
+# REQUIRES: x86
+## --time-trace writes a Chrome trace event file with one event per traced
+## phase of the link.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64-unknown-linux %s -o %t.o
+
+## The trace goes to <output>.time-trace by default.
+# RUN: ld.lld --time-trace --time-trace-granularity=0 %t.o -o %t1.elf
+# RUN: %python -c 'import json, sys; json.dump(json.load(sys.stdin), sys.stdout, sort_keys=True, indent=2)' \
+# RUN:   < %t1.elf.time-trace | FileCheck %s
+
+## --time-trace-file overrides the path.
+# RUN: ld.lld --time-trace --time-trace-granularity=0 \
+# RUN:   --time-trace-file=%t2.json %t.o -o %t2.elf
+# RUN: %python -c 'import json, sys; json.dump(json.load(sys.stdin), sys.stdout, sort_keys=True, indent=2)' \
+# RUN:   < %t2.json | FileCheck %s
+
+## ICF is only traced when it runs.
+# RUN: ld.lld --time-trace --time-trace-granularity=0 --icf=all %t.o -o %t4.elf
+# RUN: FileCheck %s --check-prefix=ICF < %t4.elf.time-trace
+# RUN: FileCheck %s --check-prefix=NOICF < %t1.elf.time-trace
+# ICF:       "name":"ICF"
+# NOICF-NOT: "name":"ICF"
+
+## Nothing is written without --time-trace.
+# RUN: rm -f %t3.elf.time-trace
+# RUN: ld.lld %t.o -o %t3.elf
+# RUN: not ls %t3.elf.time-trace
+
+# CHECK:      "traceEvents": [
+# CHECK-DAG:  "name": "ExecuteLinker"
+# CHECK-DAG:  "name": "Parse input files"
+# CHECK-DAG:  "name": "LTO"
+# CHECK-DAG:  "name": "Split sections"
+# CHECK-DAG:  "name": "Mark live"
+# CHECK-DAG:  "name": "Merge sections"
+# CHECK-DAG:  "name": "Finalize sections"
+# CHECK-DAG:  "name": "Scan relocations"
+# CHECK-DAG:  "name": "Finalize address dependent content"
+# CHECK-DAG:  "name": "Write output file"
+# CHECK-DAG:  "name": "Write sections"
+# CHECK-DAG:  "name": "Total ExecuteLinker"
+
+.globl _start
+_start:
+  ret
@@ -0,0 +1,110 @@
+from __future__ import print_function
+
+import gdbremote_testcase
+import lldbgdbserverutils
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestGdbRemoteExpeditedMemory(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def stop_and_get_key_vals(self):
+        self.test_sequence.add_log_lines(["read packet: $vCont;c#a8",
+                                          {"direction": "send",
+                                           "regex":
+                                           r"^\$T([0-9a-fA-F]{2})([^#]+)#[0-9a-fA-F]{2}$",
+                                           "capture": {
+                                               1: "signal",
+                                               2: "key_vals_text"}},
+                                          ],
+                                         True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        sigtrap = lldbutil.get_signal_number("SIGTRAP")
+        self.assertEqual(sigtrap, int(context.get("signal"), 16))
+        return context.get("key_vals_text")
+
+    def get_expedited_memory(self, kv_dict):
+        memory = kv_dict.get("memory")
+        self.assertIsNotNone(memory)
+        if not isinstance(memory, list):
+            memory = [memory]
+
+        records = {}
+        for entry in memory:
+            address, _, contents = entry.partition("=")
+            records[int(address, 16)] = contents
+        return records
+
+    def read_memory(self, address, length):
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $m{0:x},{1:x}#00".format(address, length),
+             {"direction": "send", "regex": r"^\$([0-9a-fA-F]+)#[0-9a-fA-F]{2}$",
+              "capture": {1: "contents"}}],
+            True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        return context.get("contents")
+
+    @llgs_test
+    @skipIf(archs=no_match(['aarch64', 'i386', 'x86_64']))
+    def test_stop_reply_expedites_frame_pointer_chain(self):
+        """The stop reply carries the frame records of the frame pointer chain."""
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        procs = self.prep_debug_monitor_and_inferior()
+
+        key_vals_text = self.stop_and_get_key_vals()
+        kv_dict = self.parse_key_val_dict(key_vals_text)
+        records = self.get_expedited_memory(kv_dict)
+
+        # Grab the byte order and pointer size of the inferior.
+        self.reset_test_sequence()
+        self.add_process_info_collection_packets()
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        proc_info = self.parse_process_info_response(context)
+        endian = proc_info.get("endian")
+        self.assertIsNotNone(endian)
+        word_size = int(proc_info["ptrsize"])
+
+        # The chain starts at the frame pointer of the stopped thread.
+        reg_infos = self.gather_register_infos()
+        fp_info = self.find_generic_register_with_name(reg_infos, "fp")
+        self.assertIsNotNone(fp_info)
+        expedited_registers = self.extract_registers_from_stop_notification(
+            key_vals_text)
+        fp_index = fp_info["lldb_register_index"]
+        self.assertTrue(fp_index in expedited_registers)
+        fp = lldbgdbserverutils.unpack_register_hex_unsigned(
+            endian, expedited_registers[fp_index])
+        self.assertTrue(fp in records)
+
+        # Each record is the caller's frame pointer followed by the return
+        # address, and matches what a memory read returns.
+        self.assertEqual(records[fp], self.read_memory(fp, 2 * word_size))
+        frame_count = 0
+        address = fp
+        while address in records:
+            record = records[address]
+            self.assertEqual(len(record), 4 * word_size)
+            caller_fp = lldbgdbserverutils.unpack_register_hex_unsigned(
+                endian, record[:2 * word_size])
+            return_address = lldbgdbserverutils.unpack_register_hex_unsigned(
+                endian, record[2 * word_size:])
+            self.assertNotEqual(return_address, 0)
+            frame_count += 1
+            if caller_fp <= address:
+                break
+            address = caller_fp
+
+        # leaf, middle, outer and main.
+        self.assertTrue(frame_count >= 4)
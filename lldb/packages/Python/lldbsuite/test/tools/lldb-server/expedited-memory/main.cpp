@@ -0,0 +1,17 @@
+// Stop three calls deep, so that the frame pointer chain in the stop reply
+// has a record for each of leaf, middle, outer and main.
+
+__attribute__((noinline)) int leaf(int x) {
+#if defined(__i386__) || defined(__x86_64__)
+  asm volatile("int3");
+#elif defined(__aarch64__)
+  asm volatile("brk #0xf000");
+#endif
+  return x + 1;
+}
+
+__attribute__((noinline)) int middle(int x) { return leaf(x) * 2; }
+
+__attribute__((noinline)) int outer(int x) { return middle(x) + 3; }
+
+int main(int argc, char **argv) { return outer(argc); }
@@ -56,11 +56,17 @@ public:
   size_t GetIndexOfChildWithName(ConstString name) override;
 
 private:
+  bool ReadStorageByte(Process &process, size_t byte_idx, uint8_t &byte);
+
   CompilerType m_bool_type;
   ExecutionContextRef m_exe_ctx_ref;
   uint64_t m_count;
   lldb::addr_t m_base_data_address;
   std::map<size_t, lldb::ValueObjectSP> m_children;
+  // A window of the bit storage, so that consecutive children don't each
+  // read memory.
+  size_t m_cached_bytes_idx;
+  std::vector<uint8_t> m_cached_bytes;
 };
 
 } // namespace formatters
@@ -173,7 +179,8 @@ size_t lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::
 lldb_private::formatters::LibcxxVectorBoolSyntheticFrontEnd::
     LibcxxVectorBoolSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp)
     : SyntheticChildrenFrontEnd(*valobj_sp), m_bool_type(), m_exe_ctx_ref(),
-      m_count(0), m_base_data_address(0), m_children() {
+      m_count(0), m_base_data_address(0), m_children(),
+      m_cached_bytes_idx(0) {
   if (valobj_sp) {
     Update();
     m_bool_type =
@@ -200,15 +207,12 @@ lldb_private::formatters::LibcxxVectorBoolSyntheticFrontEnd::GetChildAtIndex(
     return {};
   size_t byte_idx = (idx >> 3); // divide by 8 to get byte index
   size_t bit_index = (idx & 7); // efficient idx % 8 for bit index
-  lldb::addr_t byte_location = m_base_data_address + byte_idx;
   ProcessSP process_sp(m_exe_ctx_ref.GetProcessSP());
   if (!process_sp)
     return {};
   uint8_t byte = 0;
   uint8_t mask = 0;
-  Status err;
-  size_t bytes_read = process_sp->ReadMemory(byte_location, &byte, 1, err);
-  if (err.Fail() || bytes_read == 0)
+  if (!ReadStorageByte(*process_sp, byte_idx, byte))
     return {};
   mask = 1 << bit_index;
   bool bit_set = ((byte & mask) != 0);
@@ -243,8 +247,31 @@ lldb_private::formatters::LibcxxVectorBoolSyntheticFrontEnd::GetChildAtIndex(
  }
  }*/
 
+bool lldb_private::formatters::LibcxxVectorBoolSyntheticFrontEnd::
+    ReadStorageByte(Process &process, size_t byte_idx, uint8_t &byte) {
+  if (byte_idx < m_cached_bytes_idx ||
+      byte_idx >= m_cached_bytes_idx + m_cached_bytes.size()) {
+    // Read ahead, but never past the end of the storage.
+    static const size_t k_read_ahead_bytes = 64;
+    size_t storage_size = (m_count + 7) / 8;
+    m_cached_bytes.resize(
+        std::min(k_read_ahead_bytes, storage_size - byte_idx));
+    Status err;
+    size_t bytes_read =
+        process.ReadMemory(m_base_data_address + byte_idx,
+                           m_cached_bytes.data(), m_cached_bytes.size(), err);
+    m_cached_bytes.resize(err.Fail() ? 0 : bytes_read);
+    m_cached_bytes_idx = byte_idx;
+    if (m_cached_bytes.empty())
+      return false;
+  }
+  byte = m_cached_bytes[byte_idx - m_cached_bytes_idx];
+  return true;
+}
+
 bool lldb_private::formatters::LibcxxVectorBoolSyntheticFrontEnd::Update() {
   m_children.clear();
+  m_cached_bytes.clear();
   ValueObjectSP valobj_sp = m_backend.GetSP();
   if (!valobj_sp)
     return false;
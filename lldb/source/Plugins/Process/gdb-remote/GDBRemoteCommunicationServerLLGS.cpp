@@ -463,6 +463,62 @@ static JSONObject::SP GetRegistersAsJSON(NativeThreadProtocol &thread) {
   return register_object_sp;
 }
 
+// Expedite the frame pointer backchain in a stop reply: for every frame, the
+// saved frame pointer and the return address stored next to it. The client
+// puts these in its memory cache and can then backtrace without sending
+// memory reads. Only done where a frame record is exactly that pair.
+static void AppendExpeditedFramePointerChain(StreamString &response,
+                                             NativeThreadProtocol &thread) {
+  static const unsigned k_max_expedited_frames = 64;
+
+  NativeProcessProtocol &process = thread.GetProcess();
+  const ArchSpec &arch = process.GetArchitecture();
+  switch (arch.GetMachine()) {
+  case llvm::Triple::x86:
+  case llvm::Triple::x86_64:
+  case llvm::Triple::aarch64:
+    break;
+  default:
+    return;
+  }
+  const uint32_t addr_size = arch.GetAddressByteSize();
+  if ((addr_size != 4 && addr_size != 8) ||
+      arch.GetByteOrder() != endian::InlHostByteOrder())
+    return;
+
+  lldb::addr_t fp = thread.GetRegisterContext().GetFP(0);
+  for (unsigned frame = 0; frame < k_max_expedited_frames; ++frame) {
+    if (fp == 0 || fp % addr_size != 0)
+      return;
+
+    uint8_t frame_record[16];
+    size_t bytes_read = 0;
+    Status error = process.ReadMemoryWithoutTrap(fp, frame_record,
+                                                 2 * addr_size, bytes_read);
+    if (error.Fail() || bytes_read != 2 * addr_size)
+      return;
+
+    response.Printf("memory:0x%" PRIx64 "=", fp);
+    response.PutBytesAsRawHex8(frame_record, 2 * addr_size);
+    response.PutChar(';');
+
+    lldb::addr_t caller_fp;
+    if (addr_size == 8) {
+      uint64_t value;
+      memcpy(&value, frame_record, sizeof(value));
+      caller_fp = value;
+    } else {
+      uint32_t value;
+      memcpy(&value, frame_record, sizeof(value));
+      caller_fp = value;
+    }
+    // The stack grows down, so each caller's frame must be above this one.
+    if (caller_fp <= fp)
+      return;
+    fp = caller_fp;
+  }
+}
+
 static const char *GetStopReasonString(StopReason stop_reason) {
   switch (stop_reason) {
   case eStopReasonTrace:
@@ -749,6 +805,8 @@ GDBRemoteCommunicationServerLLGS::SendStopReplyPacketForThread(
     }
   }
 
+  AppendExpeditedFramePointerChain(response, *thread);
+
   const char *reason_str = GetStopReasonString(tid_stop_info.reason);
   if (reason_str != nullptr) {
     response.Printf("reason:%s;", reason_str);
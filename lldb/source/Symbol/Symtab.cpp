@@ -15,6 +15,7 @@
 #include "lldb/Core/RichManglingContext.h"
 #include "lldb/Core/STLUtils.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
@@ -330,14 +331,15 @@ void Symtab::InitNameIndexes() {
       RegisterBacklogEntry(record.first, record.second, class_contexts);
     }
 
-    m_name_to_index.Sort();
-    m_name_to_index.SizeToFit();
-    m_selector_to_index.Sort();
-    m_selector_to_index.SizeToFit();
-    m_basename_to_index.Sort();
-    m_basename_to_index.SizeToFit();
-    m_method_to_index.Sort();
-    m_method_to_index.SizeToFit();
+    // The maps are independent, so finalize them concurrently.
+    auto finalize_fn = [](NameToIndexMap &map) {
+      map.Sort();
+      map.SizeToFit();
+    };
+    TaskPool::RunTasks([&]() { finalize_fn(m_name_to_index); },
+                       [&]() { finalize_fn(m_selector_to_index); },
+                       [&]() { finalize_fn(m_basename_to_index); },
+                       [&]() { finalize_fn(m_method_to_index); });
   }
 }
 
@@ -0,0 +1,57 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Support/ConcurrentStringSaver.h"
+#include "llvm/Support/StringSaver.h"
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+// Symbol-like names. Most interning calls in a link or an index see names
+// that were already interned, so each thread goes over the same set.
+const std::vector<std::string> &getNames() {
+  static const std::vector<std::string> Names = [] {
+    std::vector<std::string> Names;
+    for (unsigned I = 0; I < 50000; ++I)
+      Names.push_back("_ZN4llvm12_GLOBAL__N_16Symbol" + std::to_string(I) +
+                      "Ev");
+    return Names;
+  }();
+  return Names;
+}
+
+struct LockedUniqueStringSaver {
+  std::mutex Mu;
+  BumpPtrAllocator Alloc;
+  UniqueStringSaver Saver{Alloc};
+
+  StringRef save(StringRef S) {
+    std::lock_guard<std::mutex> Lock(Mu);
+    return Saver.save(S);
+  }
+};
+
+template <typename SaverT> void intern(benchmark::State &State) {
+  static SaverT *Saver;
+  const std::vector<std::string> &Names = getNames();
+  if (State.thread_index == 0)
+    Saver = new SaverT();
+  // Each thread starts at a different place, so that they don't all
+  // insert the same string at the same time.
+  size_t Start = State.thread_index * Names.size() / State.threads;
+  for (auto _ : State)
+    for (size_t I = 0, E = Names.size(); I != E; ++I)
+      benchmark::DoNotOptimize(Saver->save(Names[(Start + I) % E]).data());
+  State.SetItemsProcessed(State.iterations() * Names.size());
+  if (State.thread_index == 0)
+    delete Saver;
+}
+
+BENCHMARK_TEMPLATE(intern, LockedUniqueStringSaver)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(intern, ConcurrentUniqueStringSaver)->ThreadRange(1, 8);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FlatHashMap.h"
+#include "llvm/Support/Allocator.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+// Stand-in for IR objects: pointer keys come from a bump allocator, as
+// Values and Instructions mostly do, with 48-byte objects in between.
+struct Object {
+  char Data[48];
+};
+
+std::vector<const Object *> getPointerKeys(unsigned N,
+                                           BumpPtrAllocator &Alloc) {
+  std::vector<const Object *> Keys;
+  for (unsigned I = 0; I < N; ++I)
+    Keys.push_back(new (Alloc) Object());
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(0));
+  return Keys;
+}
+
+// Value and register numbers: small, dense integers.
+std::vector<unsigned> getIntKeys(unsigned N) {
+  std::vector<unsigned> Keys;
+  for (unsigned I = 0; I < N; ++I)
+    Keys.push_back(I);
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(0));
+  return Keys;
+}
+
+template <typename MapT, typename KeyT>
+void lookupHits(benchmark::State &State, const std::vector<KeyT> &Keys) {
+  MapT M;
+  for (const KeyT &K : Keys)
+    M[K] = 1;
+  for (auto _ : State)
+    for (const KeyT &K : Keys)
+      benchmark::DoNotOptimize(M.find(K));
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT, typename KeyT>
+void lookupMisses(benchmark::State &State, const std::vector<KeyT> &Keys) {
+  // Insert the first half, look up the second half.
+  MapT M;
+  size_t Half = Keys.size() / 2;
+  for (size_t I = 0; I < Half; ++I)
+    M[Keys[I]] = 1;
+  for (auto _ : State)
+    for (size_t I = Half; I < Keys.size(); ++I)
+      benchmark::DoNotOptimize(M.find(Keys[I]));
+  State.SetItemsProcessed(State.iterations() * (Keys.size() - Half));
+}
+
+template <typename MapT, typename KeyT>
+void insertAll(benchmark::State &State, const std::vector<KeyT> &Keys) {
+  for (auto _ : State) {
+    MapT M;
+    for (const KeyT &K : Keys)
+      M[K] = 1;
+    benchmark::DoNotOptimize(M.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+#define POINTER_BENCHMARK(Name, Map)                                           \
+  static void BM_##Name##_##Map##_Pointer(benchmark::State &State) {           \
+    BumpPtrAllocator Alloc;                                                    \
+    Name<Map<const Object *, unsigned>>(                                       \
+        State, getPointerKeys(State.range(0), Alloc));                         \
+  }                                                                            \
+  BENCHMARK(BM_##Name##_##Map##_Pointer)->Range(64, 1 << 20);
+
+#define INT_BENCHMARK(Name, Map)                                               \
+  static void BM_##Name##_##Map##_Int(benchmark::State &State) {               \
+    Name<Map<unsigned, unsigned>>(State, getIntKeys(State.range(0)));          \
+  }                                                                            \
+  BENCHMARK(BM_##Name##_##Map##_Int)->Range(64, 1 << 20);
+
+#define MAP_BENCHMARKS(Name)                                                   \
+  POINTER_BENCHMARK(Name, DenseMap)                                            \
+  POINTER_BENCHMARK(Name, FlatHashMap)                                         \
+  INT_BENCHMARK(Name, DenseMap)                                                \
+  INT_BENCHMARK(Name, FlatHashMap)
+
+MAP_BENCHMARKS(lookupHits)
+MAP_BENCHMARKS(lookupMisses)
+MAP_BENCHMARKS(insertAll)
+
+} // namespace
+
+BENCHMARK_MAIN();
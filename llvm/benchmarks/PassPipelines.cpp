@@ -0,0 +1,110 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include <memory>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+// A chain of functions, each with a simple loop over an array and a call to
+// the previous function. That keeps the inliner, the loop passes,
+// InstCombine and GVN busy without checking in any bitcode.
+std::string getModuleText(unsigned NumFunctions) {
+  std::string Text;
+  raw_string_ostream OS(Text);
+  for (unsigned I = 0; I != NumFunctions; ++I) {
+    OS << "define i32 @f" << I << "(i32* %p, i32 %n) {\n"
+       << "entry:\n"
+       << "  br label %loop\n"
+       << "loop:\n"
+       << "  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]\n"
+       << "  %acc = phi i32 [ 0, %entry ], [ %acc.next, %loop ]\n"
+       << "  %idx = sext i32 %i to i64\n"
+       << "  %addr = getelementptr inbounds i32, i32* %p, i64 %idx\n"
+       << "  %v = load i32, i32* %addr\n"
+       << "  %m = mul i32 %v, " << I + 3 << "\n"
+       << "  %acc.next = add i32 %acc, %m\n"
+       << "  store i32 %acc.next, i32* %addr\n"
+       << "  %i.next = add nsw i32 %i, 1\n"
+       << "  %c = icmp slt i32 %i.next, %n\n"
+       << "  br i1 %c, label %loop, label %exit\n"
+       << "exit:\n";
+    if (I == 0) {
+      OS << "  ret i32 %acc.next\n";
+    } else {
+      OS << "  %r = call i32 @f" << I - 1 << "(i32* %p, i32 %n)\n"
+         << "  %s = add i32 %r, %acc.next\n"
+         << "  ret i32 %s\n";
+    }
+    OS << "}\n\n";
+  }
+  return OS.str();
+}
+
+// Everything one run of a pipeline needs. It lives on the heap so that the
+// module and the analysis managers can be torn down outside the timed region.
+struct PipelineRun {
+  LLVMContext Context;
+  std::unique_ptr<Module> M;
+  PassBuilder PB;
+  LoopAnalysisManager LAM;
+  FunctionAnalysisManager FAM;
+  CGSCCAnalysisManager CGAM;
+  ModuleAnalysisManager MAM;
+  ModulePassManager MPM;
+};
+
+void runPipeline(benchmark::State &State,
+                 PassBuilder::OptimizationLevel Level) {
+  const std::string Text = getModuleText(State.range(0));
+  for (auto _ : State) {
+    State.PauseTiming();
+    auto Run = llvm::make_unique<PipelineRun>();
+    SMDiagnostic Err;
+    Run->M = parseAssemblyString(Text, Err, Run->Context);
+    if (!Run->M) {
+      State.SkipWithError("cannot parse the benchmark module");
+      return;
+    }
+
+    PassBuilder &PB = Run->PB;
+    Run->FAM.registerPass([&] { return PB.buildDefaultAAPipeline(); });
+    PB.registerModuleAnalyses(Run->MAM);
+    PB.registerCGSCCAnalyses(Run->CGAM);
+    PB.registerFunctionAnalyses(Run->FAM);
+    PB.registerLoopAnalyses(Run->LAM);
+    PB.crossRegisterProxies(Run->LAM, Run->FAM, Run->CGAM, Run->MAM);
+    Run->MPM = PB.buildPerModuleDefaultPipeline(Level);
+    State.ResumeTiming();
+
+    Run->MPM.run(*Run->M, Run->MAM);
+    benchmark::DoNotOptimize(Run->M.get());
+
+    // Freeing the module and the cached analyses is not part of the pipeline.
+    State.PauseTiming();
+    Run.reset();
+    State.ResumeTiming();
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+
+void BM_O1(benchmark::State &State) { runPipeline(State, PassBuilder::O1); }
+void BM_O2(benchmark::State &State) { runPipeline(State, PassBuilder::O2); }
+void BM_O3(benchmark::State &State) { runPipeline(State, PassBuilder::O3); }
+
+BENCHMARK(BM_O1)->Range(8, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_O2)->Range(8, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_O3)->Range(8, 512)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
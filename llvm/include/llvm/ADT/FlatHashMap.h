@@ -0,0 +1,512 @@
+//===- llvm/ADT/FlatHashMap.h - Group-probed hash table ---------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the FlatHashMap class, an open-addressing hash table that
+// keeps one control byte per bucket next to the buckets themselves, in the
+// style of Abseil's flat_hash_map ("SwissTable").
+//
+// Buckets are split into groups of 16. Each control byte records whether its
+// bucket is empty, deleted, or full, and for full buckets 7 bits of the key's
+// hash. A lookup loads the 16 control bytes of a group at once and only
+// compares keys whose hash bits match, so most probes touch a single cache
+// line of control bytes and one bucket. Unlike DenseMap, no key values are
+// reserved: KeyInfoT only needs to provide getHashValue() and isEqual().
+//
+// As with DenseMap, inserting or erasing elements invalidates iterators and
+// references into the map.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_FLATHASHMAP_H
+#define LLVM_ADT_FLATHASHMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemAlloc.h"
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LLVM_FLATHASHMAP_SSE2 1
+#endif
+
+namespace llvm {
+
+namespace detail {
+
+/// Control byte values. Full buckets store 7 bits of their hash, so the sign
+/// bit is only set for empty and deleted buckets.
+enum : int8_t { FlatHashEmpty = -128, FlatHashDeleted = -2 };
+
+/// The control bytes of one group of buckets, and matching over them.
+struct FlatHashGroup {
+  enum : unsigned { Width = 16 };
+
+#ifdef LLVM_FLATHASHMAP_SSE2
+  explicit FlatHashGroup(const int8_t *Ctrl)
+      : Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Ctrl))) {}
+
+  /// Returns a bitmask of the buckets whose control byte is \p H2.
+  unsigned match(int8_t H2) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Ctrl));
+  }
+  /// Returns a bitmask of the empty buckets.
+  unsigned matchEmpty() const { return match(FlatHashEmpty); }
+  /// Returns a bitmask of the empty or deleted buckets.
+  unsigned matchEmptyOrDeleted() const { return _mm_movemask_epi8(Ctrl); }
+
+private:
+  __m128i Ctrl;
+#else
+  explicit FlatHashGroup(const int8_t *C) { std::memcpy(Ctrl, C, Width); }
+
+  unsigned match(int8_t H2) const {
+    unsigned Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= unsigned(Ctrl[I] == H2) << I;
+    return Mask;
+  }
+  unsigned matchEmpty() const { return match(FlatHashEmpty); }
+  unsigned matchEmptyOrDeleted() const {
+    unsigned Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= unsigned(Ctrl[I] < 0) << I;
+    return Mask;
+  }
+
+private:
+  int8_t Ctrl[Width];
+#endif
+};
+
+} // end namespace detail
+
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class FlatHashMap {
+  using Group = detail::FlatHashGroup;
+
+public:
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = detail::DenseMapPair<KeyT, ValueT>;
+  using size_type = unsigned;
+
+private:
+  template <bool IsConst> class Iterator {
+    friend class FlatHashMap;
+    friend class Iterator<!IsConst>;
+
+    using BucketPtr = typename std::conditional<
+        IsConst, const typename FlatHashMap::value_type *,
+        typename FlatHashMap::value_type *>::type;
+
+    const int8_t *Ctrl = nullptr;
+    const int8_t *CtrlEnd = nullptr;
+    BucketPtr Bucket = nullptr;
+
+    Iterator(const int8_t *Ctrl, const int8_t *CtrlEnd, BucketPtr Bucket,
+             bool NoAdvance = false)
+        : Ctrl(Ctrl), CtrlEnd(CtrlEnd), Bucket(Bucket) {
+      if (!NoAdvance)
+        skipEmpty();
+    }
+
+    void skipEmpty() {
+      while (Ctrl != CtrlEnd && *Ctrl < 0) {
+        ++Ctrl;
+        ++Bucket;
+      }
+    }
+
+  public:
+    using difference_type = ptrdiff_t;
+    using value_type = typename std::conditional<
+        IsConst, const typename FlatHashMap::value_type,
+        typename FlatHashMap::value_type>::type;
+    using pointer = value_type *;
+    using reference = value_type &;
+    using iterator_category = std::forward_iterator_tag;
+
+    Iterator() = default;
+
+    // Allow conversion from iterator to const_iterator.
+    template <bool WasConst, typename = typename std::enable_if<
+                                 !WasConst && IsConst>::type>
+    Iterator(const Iterator<WasConst> &I)
+        : Ctrl(I.Ctrl), CtrlEnd(I.CtrlEnd), Bucket(I.Bucket) {}
+
+    reference operator*() const { return *Bucket; }
+    pointer operator->() const { return Bucket; }
+
+    bool operator==(const Iterator &RHS) const { return Ctrl == RHS.Ctrl; }
+    bool operator!=(const Iterator &RHS) const { return Ctrl != RHS.Ctrl; }
+
+    Iterator &operator++() {
+      assert(Ctrl != CtrlEnd && "incrementing end() iterator");
+      ++Ctrl;
+      ++Bucket;
+      skipEmpty();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator Tmp = *this;
+      ++*this;
+      return Tmp;
+    }
+  };
+
+public:
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  /// Create a FlatHashMap that can hold at least \p InitialReserve elements
+  /// without growing.
+  explicit FlatHashMap(unsigned InitialReserve = 0) { reserve(InitialReserve); }
+
+  FlatHashMap(const FlatHashMap &Other) {
+    reserve(Other.size());
+    for (const value_type &KV : Other)
+      insertUnique(KV.first, KV.second);
+  }
+
+  FlatHashMap(FlatHashMap &&Other) { swap(Other); }
+
+  FlatHashMap(std::initializer_list<value_type> Vals) {
+    reserve(Vals.size());
+    for (const value_type &KV : Vals)
+      insert(KV);
+  }
+
+  ~FlatHashMap() {
+    destroyAll();
+    deallocate();
+  }
+
+  FlatHashMap &operator=(const FlatHashMap &Other) {
+    if (&Other != this) {
+      FlatHashMap Tmp(Other);
+      swap(Tmp);
+    }
+    return *this;
+  }
+
+  FlatHashMap &operator=(FlatHashMap &&Other) {
+    FlatHashMap Tmp(std::move(Other));
+    swap(Tmp);
+    return *this;
+  }
+
+  void swap(FlatHashMap &RHS) {
+    std::swap(Ctrl, RHS.Ctrl);
+    std::swap(Buckets, RHS.Buckets);
+    std::swap(NumBuckets, RHS.NumBuckets);
+    std::swap(NumEntries, RHS.NumEntries);
+    std::swap(GrowthLeft, RHS.GrowthLeft);
+  }
+
+  iterator begin() { return iterator(Ctrl, Ctrl + NumBuckets, Buckets); }
+  iterator end() {
+    return iterator(Ctrl + NumBuckets, Ctrl + NumBuckets,
+                    Buckets + NumBuckets, true);
+  }
+  const_iterator begin() const {
+    return const_iterator(Ctrl, Ctrl + NumBuckets, Buckets);
+  }
+  const_iterator end() const {
+    return const_iterator(Ctrl + NumBuckets, Ctrl + NumBuckets,
+                          Buckets + NumBuckets, true);
+  }
+
+  LLVM_NODISCARD bool empty() const { return NumEntries == 0; }
+  unsigned size() const { return NumEntries; }
+
+  /// Grow the map so that it can hold at least \p NumEntries elements without
+  /// growing again.
+  void reserve(size_type NumElts) {
+    if (NumElts == 0)
+      return;
+    unsigned Needed = std::max<unsigned>(
+        NextPowerOf2((uint64_t(NumElts) * 8 + 6) / 7 - 1), Group::Width);
+    if (Needed > NumBuckets)
+      rehash(Needed);
+  }
+
+  void clear() {
+    if (NumEntries == 0 && GrowthLeft == maxEntries(NumBuckets))
+      return;
+    destroyAll();
+    std::memset(Ctrl, detail::FlatHashEmpty, NumBuckets);
+    NumEntries = 0;
+    GrowthLeft = maxEntries(NumBuckets);
+  }
+
+  /// Return 1 if the specified key is in the map, 0 otherwise.
+  size_type count(const KeyT &Key) const {
+    return findIndex(Key) != NumBuckets ? 1 : 0;
+  }
+
+  iterator find(const KeyT &Key) { return iteratorAt(findIndex(Key)); }
+  const_iterator find(const KeyT &Key) const {
+    return iteratorAt(findIndex(Key));
+  }
+
+  /// Return the entry for the specified key, or a default constructed value
+  /// if no such entry exists.
+  ValueT lookup(const KeyT &Key) const {
+    unsigned I = findIndex(Key);
+    if (I != NumBuckets)
+      return Buckets[I].second;
+    return ValueT();
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // If the key is already in the map, it returns false and doesn't update the
+  // value.
+  std::pair<iterator, bool> insert(const std::pair<KeyT, ValueT> &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+  std::pair<iterator, bool> insert(std::pair<KeyT, ValueT> &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  /// Inserts a new element constructed from \p Args if the key isn't already
+  /// in the map. Returns the element for the key, and whether it was inserted.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&... Args) {
+    uint64_t Hash = hash(Key);
+    unsigned I = findIndex(Key, Hash);
+    if (I != NumBuckets)
+      return {iteratorAt(I), false};
+    I = prepareInsert(Hash);
+    ::new (&Buckets[I].getFirst()) KeyT(std::move(Key));
+    ::new (&Buckets[I].getSecond()) ValueT(std::forward<Ts>(Args)...);
+    return {iteratorAt(I), true};
+  }
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&... Args) {
+    uint64_t Hash = hash(Key);
+    unsigned I = findIndex(Key, Hash);
+    if (I != NumBuckets)
+      return {iteratorAt(I), false};
+    I = prepareInsert(Hash);
+    ::new (&Buckets[I].getFirst()) KeyT(Key);
+    ::new (&Buckets[I].getSecond()) ValueT(std::forward<Ts>(Args)...);
+    return {iteratorAt(I), true};
+  }
+
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  ValueT &operator[](const KeyT &Key) { return try_emplace(Key).first->second; }
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->second;
+  }
+
+  /// Remove the element for \p Key. Returns false if there was none.
+  bool erase(const KeyT &Key) {
+    unsigned I = findIndex(Key);
+    if (I == NumBuckets)
+      return false;
+    eraseAt(I);
+    return true;
+  }
+  void erase(iterator I) {
+    assert(I != end() && "erasing end() iterator");
+    eraseAt(I.Ctrl - Ctrl);
+  }
+
+  /// Return the approximate size (in bytes) of the actual map.
+  size_t getMemorySize() const {
+    return NumBuckets * (sizeof(value_type) + 1);
+  }
+
+private:
+  int8_t *Ctrl = nullptr;
+  value_type *Buckets = nullptr;
+  // Always zero or a power of two, and a multiple of the group width.
+  unsigned NumBuckets = 0;
+  unsigned NumEntries = 0;
+  // The number of elements that can be added before the map must grow. Reuse
+  // of deleted buckets doesn't count against it.
+  unsigned GrowthLeft = 0;
+
+  static unsigned maxEntries(unsigned NumBuckets) {
+    return NumBuckets - NumBuckets / 8;
+  }
+
+  // DenseMapInfo hashes are often weak in the low bits (e.g. pointer hashes),
+  // so mix them before splitting off the group index and the control bits.
+  static uint64_t hash(const KeyT &Key) {
+    return uint64_t(KeyInfoT::getHashValue(Key)) * 0x9E3779B97F4A7C15ULL;
+  }
+  // The top 7 bits of the mixed hash are stored in the control byte.
+  static int8_t h2(uint64_t Hash) { return int8_t(Hash >> 57); }
+  // The next bits select the first group to probe.
+  static unsigned h1(uint64_t Hash) { return unsigned(Hash >> 32); }
+
+  iterator iteratorAt(unsigned I) {
+    return iterator(Ctrl + I, Ctrl + NumBuckets, Buckets + I, true);
+  }
+  const_iterator iteratorAt(unsigned I) const {
+    return const_iterator(Ctrl + I, Ctrl + NumBuckets, Buckets + I, true);
+  }
+
+  unsigned findIndex(const KeyT &Key) const {
+    return findIndex(Key, hash(Key));
+  }
+
+  /// Returns the index of the bucket holding \p Key, or NumBuckets.
+  unsigned findIndex(const KeyT &Key, uint64_t Hash) const {
+    if (NumBuckets == 0)
+      return NumBuckets;
+    unsigned GroupMask = NumBuckets / Group::Width - 1;
+    unsigned G = h1(Hash) & GroupMask;
+    int8_t H2 = h2(Hash);
+    // Triangular probing over groups, which visits every group once.
+    for (unsigned Step = 1;; ++Step) {
+      unsigned Base = G * Group::Width;
+      Group Grp(Ctrl + Base);
+      for (unsigned M = Grp.match(H2); M; M &= M - 1) {
+        unsigned I = Base + countTrailingZeros(M);
+        if (LLVM_LIKELY(KeyInfoT::isEqual(Buckets[I].first, Key)))
+          return I;
+      }
+      // A key is never placed past a group that still has an empty bucket.
+      if (Grp.matchEmpty() || Step > GroupMask)
+        return NumBuckets;
+      G = (G + Step) & GroupMask;
+    }
+  }
+
+  /// Returns the index of the first empty or deleted bucket for \p Hash.
+  /// The map must have such a bucket.
+  unsigned findFirstNonFull(uint64_t Hash) const {
+    unsigned GroupMask = NumBuckets / Group::Width - 1;
+    unsigned G = h1(Hash) & GroupMask;
+    for (unsigned Step = 1;; ++Step) {
+      unsigned Base = G * Group::Width;
+      if (unsigned M = Group(Ctrl + Base).matchEmptyOrDeleted())
+        return Base + countTrailingZeros(M);
+      assert(Step <= GroupMask && "no free bucket in the map");
+      G = (G + Step) & GroupMask;
+    }
+  }
+
+  /// Claims a bucket for a new element with \p Hash, growing the map if
+  /// needed, and returns its index. The caller must construct the element.
+  unsigned prepareInsert(uint64_t Hash) {
+    unsigned I = NumBuckets ? findFirstNonFull(Hash) : 0;
+    if (NumBuckets == 0 ||
+        (GrowthLeft == 0 && Ctrl[I] != detail::FlatHashDeleted)) {
+      // Rehash in place if at least half the used buckets are tombstones,
+      // otherwise double the capacity.
+      unsigned Used = maxEntries(NumBuckets) - GrowthLeft;
+      if (NumBuckets && NumEntries * 2 <= Used)
+        rehash(NumBuckets);
+      else
+        rehash(std::max<unsigned>(NumBuckets * 2, Group::Width));
+      I = findFirstNonFull(Hash);
+    }
+    if (Ctrl[I] == detail::FlatHashEmpty)
+      --GrowthLeft;
+    Ctrl[I] = h2(Hash);
+    ++NumEntries;
+    return I;
+  }
+
+  void eraseAt(unsigned I) {
+    Buckets[I].~value_type();
+    --NumEntries;
+    // If the group still has an empty bucket, no lookup probes past it, so
+    // the bucket can become empty again. Otherwise keep a tombstone.
+    unsigned Base = I & ~(Group::Width - 1);
+    if (Group(Ctrl + Base).matchEmpty()) {
+      Ctrl[I] = detail::FlatHashEmpty;
+      ++GrowthLeft;
+    } else {
+      Ctrl[I] = detail::FlatHashDeleted;
+    }
+  }
+
+  /// Adds an element that is known not to be in the map, without rehashing.
+  void insertUnique(const KeyT &Key, const ValueT &Value) {
+    uint64_t Hash = hash(Key);
+    unsigned I = findFirstNonFull(Hash);
+    ::new (&Buckets[I]) value_type(Key, Value);
+    Ctrl[I] = h2(Hash);
+    --GrowthLeft;
+    ++NumEntries;
+  }
+
+  void rehash(unsigned NewNumBuckets) {
+    assert(isPowerOf2_32(NewNumBuckets) && NewNumBuckets >= Group::Width &&
+           NewNumBuckets >= NumEntries);
+    int8_t *OldCtrl = Ctrl;
+    value_type *OldBuckets = Buckets;
+    unsigned OldNumBuckets = NumBuckets;
+
+    Ctrl = static_cast<int8_t *>(safe_malloc(NewNumBuckets));
+    std::memset(Ctrl, detail::FlatHashEmpty, NewNumBuckets);
+    Buckets = static_cast<value_type *>(
+        operator new(sizeof(value_type) * NewNumBuckets));
+    NumBuckets = NewNumBuckets;
+    GrowthLeft = maxEntries(NumBuckets) - NumEntries;
+
+    for (unsigned I = 0; I != OldNumBuckets; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      value_type &KV = OldBuckets[I];
+      uint64_t Hash = hash(KV.first);
+      unsigned J = findFirstNonFull(Hash);
+      Ctrl[J] = h2(Hash);
+      ::new (&Buckets[J].getFirst()) KeyT(std::move(KV.getFirst()));
+      ::new (&Buckets[J].getSecond()) ValueT(std::move(KV.getSecond()));
+      KV.~value_type();
+    }
+    if (OldNumBuckets) {
+      std::free(OldCtrl);
+      operator delete(OldBuckets);
+    }
+  }
+
+  void destroyAll() {
+    for (unsigned I = 0; I != NumBuckets; ++I)
+      if (Ctrl[I] >= 0)
+        Buckets[I].~value_type();
+  }
+
+  void deallocate() {
+    if (!NumBuckets)
+      return;
+    std::free(Ctrl);
+    operator delete(Buckets);
+  }
+};
+
+template <typename KeyT, typename ValueT, typename KeyInfoT>
+inline void swap(FlatHashMap<KeyT, ValueT, KeyInfoT> &LHS,
+                 FlatHashMap<KeyT, ValueT, KeyInfoT> &RHS) {
+  LHS.swap(RHS);
+}
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_FLATHASHMAP_H
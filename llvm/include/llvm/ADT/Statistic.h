@@ -28,6 +28,7 @@
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Compiler.h"
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -168,6 +169,94 @@ protected:
 #define STATISTIC(VARNAME, DESC)                                               \
   static llvm::Statistic VARNAME = {DEBUG_TYPE, #VARNAME, DESC, {0}, {false}}
 
+/// A statistic that is also collected in release builds, cheaply enough for
+/// hot paths. Each thread counts into its own slot with a plain load and
+/// store, without atomic read-modify-write operations or cache line sharing.
+/// The slots are only summed up when the value is read or printed. Like
+/// Statistic, these must be declared as globals, and are printed with -stats
+/// or -stats-json.
+class AlwaysOnStatistic {
+public:
+  const char *DebugType;
+  const char *Name;
+  const char *Desc;
+  /// The slot used in each thread's counters, or -1 until first updated.
+  std::atomic<int> Slot;
+  /// Used for updates once all per-thread slots are taken.
+  std::atomic<uint64_t> Overflow;
+  /// The total at the last ResetStatistics(), subtracted from the sum.
+  std::atomic<uint64_t> Base;
+
+  const char *getDebugType() const { return DebugType; }
+  const char *getName() const { return Name; }
+  const char *getDesc() const { return Desc; }
+
+  /// Returns the sum over all threads. This takes a lock, so it shouldn't be
+  /// called on hot paths.
+  uint64_t getValue() const;
+
+  AlwaysOnStatistic &operator++() {
+    add(1);
+    return *this;
+  }
+
+  AlwaysOnStatistic &operator+=(uint64_t V) {
+    add(V);
+    return *this;
+  }
+
+  void add(uint64_t V) { addToThreadValue(V); }
+
+private:
+  friend class SampledScopedTimer;
+
+  /// Adds V to this thread's slot, and returns the slot's new value.
+  uint64_t addToThreadValue(uint64_t V);
+  int registerStatistic();
+};
+
+#define ALWAYS_ON_STATISTIC(VARNAME, DESC)                                     \
+  static llvm::AlwaysOnStatistic VARNAME = {                                   \
+      DEBUG_TYPE, #VARNAME, DESC, {-1}, {0}, {0}}
+
+/// Estimates the time spent in a scope, cheaply enough to be left on in
+/// release builds. Each entry to the scope is counted in \p Count, but only
+/// one in every \p SampleRate of them per thread is timed. The time measured
+/// is scaled up by the sample rate and added to \p TimeNS, in nanoseconds.
+/// \p SampleRate must be at least 1.
+///
+/// \code
+///   ALWAYS_ON_STATISTIC(NumFooCalls, "Number of calls to foo");
+///   ALWAYS_ON_STATISTIC(FooTimeNS, "Estimated time in foo (ns)");
+///   void foo() {
+///     SampledScopedTimer T(NumFooCalls, FooTimeNS);
+///     ...
+/// \endcode
+class SampledScopedTimer {
+  AlwaysOnStatistic &TimeNS;
+  unsigned SampleRate;
+  /// Zero if this entry isn't sampled.
+  uint64_t StartNS = 0;
+
+public:
+  SampledScopedTimer(AlwaysOnStatistic &Count, AlwaysOnStatistic &TimeNS,
+                     unsigned SampleRate = 64)
+      : TimeNS(TimeNS), SampleRate(SampleRate) {
+    if (LLVM_UNLIKELY(Count.addToThreadValue(1) % SampleRate == 0))
+      StartNS = now();
+  }
+  SampledScopedTimer(const SampledScopedTimer &) = delete;
+  SampledScopedTimer &operator=(const SampledScopedTimer &) = delete;
+
+  ~SampledScopedTimer() {
+    if (LLVM_UNLIKELY(StartNS != 0))
+      TimeNS.add((now() - StartNS) * SampleRate);
+  }
+
+private:
+  static uint64_t now();
+};
+
 /// Enable the collection and printing of statistics.
 void EnableStatistics(bool PrintOnExit = true);
 
@@ -713,6 +713,12 @@ public:
   MemorySSAWalker *getWalker();
   MemorySSAWalker *getSkipSelfWalker();
 
+  /// Return a walker like getWalker(), except that it disambiguates with
+  /// \p BAA, so alias results are shared by all the queries it answers. Like
+  /// \p BAA itself, it may only be used while the IR isn't modified. The
+  /// optimized accesses it finds are recorded in MemorySSA as usual.
+  std::unique_ptr<MemorySSAWalker> getBatchWalker(BatchAAResults &BAA);
+
   /// Given a memory Mod/Ref'ing instruction, get the MemorySSA
   /// access associated with it. If passed a basic block gets the memory phi
   /// node that exists for that block, if there is one. Otherwise, this will get
@@ -836,6 +842,7 @@ private:
   template <class AliasAnalysisType> class ClobberWalkerBase;
   template <class AliasAnalysisType> class CachingWalker;
   template <class AliasAnalysisType> class SkipSelfWalker;
+  class BatchWalker;
   class OptimizeUses;
 
   CachingWalker<AliasAnalysis> *getWalkerImpl();
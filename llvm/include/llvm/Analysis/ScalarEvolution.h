@@ -794,6 +794,17 @@ public:
   // bodies).
   void forgetAllLoops();
 
+  /// Bound the work done by this ScalarEvolution. Each SCEV created for an
+  /// instruction, and each backedge-taken count computed, costs one unit.
+  /// Once \p Budget units are spent, analysis degrades gracefully: new
+  /// instructions get a SCEVUnknown, and new loops a SCEVCouldNotCompute
+  /// trip count. Results already cached are unaffected. Zero means no limit.
+  /// The default comes from -scalar-evolution-max-cost.
+  void setCostBudget(unsigned Budget) { CostBudget = Budget; }
+
+  /// Return the work done so far, in the units of setCostBudget.
+  unsigned getCost() const { return Cost; }
+
   /// This method should be called by the client when it has changed a loop in
   /// a way that may effect ScalarEvolution's ability to compute a trip count,
   /// or if the loop is deleted.  This call is potentially expensive for large
@@ -1124,6 +1135,18 @@ private:
   /// thare are guards present in the IR.
   bool HasGuards;
 
+  /// See setCostBudget and getCost.
+  unsigned CostBudget;
+  unsigned Cost = 0;
+
+  /// Spend one unit of the budget, or return false if it's already spent.
+  bool consumeCost() {
+    if (CostBudget && Cost >= CostBudget)
+      return false;
+    ++Cost;
+    return true;
+  }
+
   /// The target library information for the target we are targeting.
   TargetLibraryInfo &TLI;
 
@@ -87,7 +87,12 @@ private:
   FixedStreamArray<codeview::TypeIndexOffset> TypeIndexOffsets;
   HashTable<support::ulittle32_t> HashAdjusters;
 
-  std::vector<std::vector<codeview::TypeIndex>> HashMap;
+  /// Type indices grouped by hash bucket, built on the first lookup. Bucket B
+  /// is HashBuckets[HashBucketStarts[B], HashBucketStarts[B + 1]).
+  std::vector<uint32_t> HashBucketStarts;
+  std::vector<codeview::TypeIndex> HashBuckets;
+
+  ArrayRef<codeview::TypeIndex> getHashBucket(uint32_t Bucket) const;
 
   const TpiStreamHeader *Header;
 };
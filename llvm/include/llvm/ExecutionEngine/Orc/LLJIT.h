@@ -195,6 +195,7 @@ public:
   Optional<JITTargetMachineBuilder> JTMB;
   ObjectLinkingLayerCreator CreateObjectLinkingLayer;
   CompileFunctionCreator CreateCompileFunction;
+  ObjectCache *ObjCache = nullptr;
   unsigned NumCompileThreads = 0;
 
   /// Called prior to JIT class construcion to fix up defaults.
@@ -241,6 +242,16 @@ public:
     return impl();
   }
 
+  /// Set an ObjectCache for the default compile function to consult before
+  /// compiling a module, and to notify of newly compiled objects.
+  ///
+  /// The cache is not owned by the JIT and must outlive it. It is ignored if
+  /// a custom CompileFunctionCreator is set.
+  SetterImpl &setObjectCache(ObjectCache *ObjCache) {
+    impl().ObjCache = ObjCache;
+    return impl();
+  }
+
   /// Set the number of compile threads to use.
   ///
   /// If set to zero, compilation will be performed on the execution thread when
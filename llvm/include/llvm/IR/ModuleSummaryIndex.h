@@ -19,6 +19,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
@@ -117,7 +118,10 @@ inline const char *getHotnessName(CalleeInfo::HotnessType HT) {
 
 class GlobalValueSummary;
 
-using GlobalValueSummaryList = std::vector<std::unique_ptr<GlobalValueSummary>>;
+/// Almost every GUID has a single summary, so keep it inline rather than
+/// paying for a separate heap allocation per entry in the GlobalValueMap.
+using GlobalValueSummaryList =
+    SmallVector<std::unique_ptr<GlobalValueSummary>, 1>;
 
 struct LLVM_ALIGNAS(8) GlobalValueSummaryInfo {
   union NameOrGV {
@@ -146,7 +150,7 @@ struct LLVM_ALIGNAS(8) GlobalValueSummaryInfo {
 
   /// List of global value summary structures for a particular value held
   /// in the GlobalValueMap. Requires a vector in the case of multiple
-  /// COMDAT values of the same name.
+  /// COMDAT values of the same name, but usually holds a single summary.
   GlobalValueSummaryList SummaryList;
 };
 
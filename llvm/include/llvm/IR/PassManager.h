@@ -1295,6 +1295,11 @@ public:
     PassInstrumentation PI = AM.getResult<PassInstrumentationAnalysis>(M);
 
     PreservedAnalyses PA = PreservedAnalyses::all();
+    // Functions are visited one at a time. Running them concurrently is not
+    // possible even for passes that only touch their own function: any
+    // instruction change updates the use lists of the constants and globals
+    // it refers to, which are shared across the module, and creating
+    // constants, types or metadata mutates the LLVMContext.
     for (Function &F : M) {
       if (F.isDeclaration())
         continue;
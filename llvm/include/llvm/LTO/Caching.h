@@ -7,7 +7,7 @@
 //===----------------------------------------------------------------------===//
 //
 // This file defines the localCache function, which allows clients to add a
-// filesystem cache to ThinLTO.
+// filesystem cache to ThinLTO, optionally backed by a remote cache.
 //
 //===----------------------------------------------------------------------===//
 
@@ -33,6 +33,28 @@ using AddBufferFn =
 Expected<NativeObjectCache> localCache(StringRef CacheDirectoryPath,
                                        AddBufferFn AddBuffer);
 
+/// Callbacks to a cache shared between machines, such as an HTTP object
+/// store. Both callbacks are called from the ThinLTO backend threads and must
+/// be thread safe.
+struct RemoteCache {
+  /// Looks up \p Key in the remote cache. Returns nullptr on a miss or on
+  /// any error.
+  std::function<std::unique_ptr<MemoryBuffer>(StringRef Key)> Fetch;
+
+  /// Publishes a newly compiled object under \p Key. \p Object is only valid
+  /// for the duration of the call, so an implementation that uploads in the
+  /// background must copy it. Failures should be ignored.
+  std::function<void(StringRef Key, MemoryBufferRef Object)> Store;
+};
+
+/// Create a local file system cache as above which falls back to \p Remote
+/// on a miss. Objects fetched from the remote cache are also added to the
+/// local cache, and objects compiled on a miss in both are published to the
+/// remote cache.
+Expected<NativeObjectCache> localCache(StringRef CacheDirectoryPath,
+                                       AddBufferFn AddBuffer,
+                                       RemoteCache Remote);
+
 } // namespace lto
 } // namespace llvm
 
@@ -240,12 +240,14 @@ ThinBackend createInProcessThinBackend(unsigned ParallelismLevel);
 /// the final ThinLTO linking. Can be nullptr.
 /// OnWrite is callback which receives module identifier and notifies LTO user
 /// that index file for the module (and optionally imports file) was created.
+/// Up to ParallelismLevel index files are written concurrently.
 using IndexWriteCallback = std::function<void(const std::string &)>;
 ThinBackend createWriteIndexesThinBackend(std::string OldPrefix,
                                           std::string NewPrefix,
                                           bool ShouldEmitImportsFiles,
                                           raw_fd_ostream *LinkedObjectsFile,
-                                          IndexWriteCallback OnWrite);
+                                          IndexWriteCallback OnWrite,
+                                          unsigned ParallelismLevel);
 
 /// This class implements a resolution-based interface to LLVM's LTO
 /// functionality. It supports regular LTO, parallel LTO code generation and
@@ -43,6 +43,8 @@ class MCAsmBackend {
 
 protected: // Can only create subclasses.
   MCAsmBackend(support::endianness Endian);
+  MCAsmBackend(support::endianness Endian,
+               std::unique_ptr<MCCodePadder> CodePadder);
 
 public:
   MCAsmBackend(const MCAsmBackend &) = delete;
@@ -12,6 +12,7 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/iterator.h"
 #include "llvm/ADT/iterator_range.h"
@@ -109,6 +110,10 @@ private:
 
   SectionListType Sections;
 
+  /// The sections holding a fragment whose size may change during relaxation,
+  /// in section order. Computed by layout(); the others are laid out once.
+  SmallVector<MCSection *, 16> RelaxableSections;
+
   SymbolDataListType Symbols;
 
   std::vector<IndirectSymbolData> IndirectSymbols;
@@ -574,8 +574,13 @@ ELFFile<ELFT>::getSection(const StringRef SectionName) const {
   auto TableOrErr = sections();
   if (!TableOrErr)
     return TableOrErr.takeError();
+  // Look up the section name string table once rather than revalidating the
+  // section headers for every section name.
+  auto StrTabOrErr = getSectionStringTable(*TableOrErr);
+  if (!StrTabOrErr)
+    return StrTabOrErr.takeError();
   for (auto &Sec : *TableOrErr) {
-    auto SecNameOrErr = getSectionName(&Sec);
+    auto SecNameOrErr = getSectionName(&Sec, *StrTabOrErr);
     if (!SecNameOrErr)
       return SecNameOrErr.takeError();
     if (*SecNameOrErr == SectionName)
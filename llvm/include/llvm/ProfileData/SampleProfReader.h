@@ -453,13 +453,23 @@ public:
   static bool hasFormat(const MemoryBuffer &Buffer);
 };
 
+/// Reader for the compact binary format. Unlike the raw binary format, whose
+/// read() decodes every function profile, this format carries a function
+/// offset table indexed by name hash (see SampleProfileWriterCompactBinary).
+/// read() then only decodes the profiles of the functions recorded by
+/// collectFuncsToUse(), so the load cost scales with the module rather than
+/// with the profile.
 class SampleProfileReaderCompactBinary : public SampleProfileReaderBinary {
 private:
-  /// Function name table.
+  /// Function GUID table.
+  std::vector<uint64_t> GUIDTable;
+  /// Function names, parallel to GUIDTable. A name is the decimal string of
+  /// its GUID and is only built the first time it is read, so a large
+  /// profile costs no string allocations for the functions never loaded.
   std::vector<std::string> NameTable;
-  /// The table mapping from function name to the offset of its FunctionSample
+  /// The table mapping from function GUID to the offset of its FunctionSample
   /// towards file start.
-  DenseMap<StringRef, uint64_t> FuncOffsetTable;
+  DenseMap<uint64_t, uint64_t> FuncOffsetTable;
   /// The set containing the functions to use when compiling a module.
   DenseSet<StringRef> FuncsToUse;
   virtual std::error_code verifySPMagic(uint64_t Magic) override;
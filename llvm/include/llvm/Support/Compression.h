@@ -41,6 +41,26 @@ Error uncompress(StringRef InputBuffer,
 
 uint32_t crc32(StringRef Buffer);
 
+/// Compresses \p InputBuffer as one shard of a larger zlib stream. The
+/// output is a raw deflate stream without a zlib header or checksum. Shards
+/// that are compressed independently (e.g. in parallel) and then concatenated
+/// in order form a valid zlib stream when preceded by a zlib header and
+/// followed by the big-endian Adler-32 checksum of the whole uncompressed data
+/// (see adler32 and adler32Combine). \p IsLast must be true for the last shard
+/// and false for all others.
+Error compressShard(StringRef InputBuffer,
+                    SmallVectorImpl<char> &CompressedBuffer, bool IsLast,
+                    int Level = DefaultCompression);
+
+/// Updates the Adler-32 checksum \p Adler with the contents of \p Buffer.
+/// The Adler-32 checksum of an empty buffer is 1.
+uint32_t adler32(uint32_t Adler, StringRef Buffer);
+
+/// Returns the Adler-32 checksum of the concatenation of two buffers given
+/// their checksums \p Adler1 and \p Adler2 and the length of the second
+/// buffer \p Len2.
+uint32_t adler32Combine(uint32_t Adler1, uint32_t Adler2, size_t Len2);
+
 }  // End of namespace zlib
 
 } // End of namespace llvm
@@ -0,0 +1,86 @@
+//===- llvm/Support/ConcurrentStringSaver.h ---------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_CONCURRENTSTRINGSAVER_H
+#define LLVM_SUPPORT_CONCURRENTSTRINGSAVER_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/Allocator.h"
+#include <atomic>
+#include <mutex>
+
+namespace llvm {
+
+/// A thread-safe UniqueStringSaver: saving the same string yields the same
+/// StringRef, from any thread, and the returned characters stay valid until
+/// the saver is destroyed.
+///
+/// Strings are spread over independent shards by hash. Each shard is an open
+/// addressing table of atomic pointers, so looking up a string that is
+/// already saved takes no locks. Inserting a new string locks only its shard.
+/// When a shard's table grows, the old table is kept alive in the shard's
+/// allocator, so concurrent readers still probing it stay safe.
+class ConcurrentUniqueStringSaver {
+public:
+  ConcurrentUniqueStringSaver() = default;
+  ConcurrentUniqueStringSaver(const ConcurrentUniqueStringSaver &) = delete;
+  ConcurrentUniqueStringSaver &
+  operator=(const ConcurrentUniqueStringSaver &) = delete;
+
+  // All returned strings are null-terminated: *save(S).end() == 0.
+  StringRef save(const char *S) { return save(StringRef(S)); }
+  StringRef save(StringRef S);
+  StringRef save(const Twine &S) { return save(StringRef(S.str())); }
+  StringRef save(const std::string &S) { return save(StringRef(S)); }
+
+  /// Returns the number of unique strings saved. Only exact when no other
+  /// thread is saving at the same time.
+  size_t size() const;
+
+  /// Returns the memory allocated for strings and tables.
+  size_t getMemorySize() const;
+
+private:
+  struct Entry {
+    uint64_t Hash;
+    size_t Length;
+    // Followed by Length characters and a null terminator.
+    const char *getData() const {
+      return reinterpret_cast<const char *>(this + 1);
+    }
+    StringRef getKey() const { return StringRef(getData(), Length); }
+  };
+
+  struct Table {
+    size_t Mask;
+    // Followed by Mask + 1 slots.
+    std::atomic<const Entry *> *getSlots() {
+      return reinterpret_cast<std::atomic<const Entry *> *>(this + 1);
+    }
+  };
+
+  struct Shard {
+    std::atomic<Table *> Tab{nullptr};
+    // Guards everything below, and replacing Tab.
+    mutable std::mutex Mu;
+    size_t NumEntries = 0;
+    BumpPtrAllocator Alloc;
+  };
+
+  static const Entry *find(Table *T, uint64_t Hash, StringRef S);
+  static void insert(Table *T, const Entry *E);
+  static Table *createTable(BumpPtrAllocator &Alloc, size_t NumSlots);
+
+  static constexpr unsigned NumShardsLog2 = 6;
+  Shard Shards[1 << NumShardsLog2];
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_CONCURRENTSTRINGSAVER_H
@@ -27,6 +27,9 @@ namespace llvm {
 /// If the FileOutputBuffer is committed, the target file's content will become
 /// the buffer content at the time of the commit.  If the FileOutputBuffer is
 /// not committed, the file will be deleted in the FileOutputBuffer destructor.
+///
+/// Independent parts of the output can be produced concurrently by giving
+/// each writer a raw_region_ostream over its own slice of the buffer.
 class FileOutputBuffer {
 public:
   enum {
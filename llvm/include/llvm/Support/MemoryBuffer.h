@@ -15,6 +15,7 @@
 
 #include "llvm-c/Types.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CBindingWrapping.h"
@@ -23,6 +24,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
 
 namespace llvm {
 
@@ -80,6 +82,16 @@ public:
   getFile(const Twine &Filename, int64_t FileSize = -1,
           bool RequiresNullTerminator = true, bool IsVolatile = false);
 
+  /// Open each of the specified files as if by getFile, but concurrently.
+  /// Files that end up memory mapped are also paged in by the loading
+  /// thread, so that the reads overlap instead of being faulted in one page
+  /// at a time by whoever first touches the buffer. This helps most with
+  /// many inputs on a network filesystem. The results are in the same order
+  /// as \p Filenames.
+  static SmallVector<ErrorOr<std::unique_ptr<MemoryBuffer>>, 0>
+  getFiles(ArrayRef<std::string> Filenames,
+           bool RequiresNullTerminator = true, bool IsVolatile = false);
+
   /// Read all of the specified file into a MemoryBuffer as a stream
   /// (i.e. until EOF reached). This is useful for special files that
   /// look like a regular file but have 0 size (e.g. /proc/cpuinfo on Linux).
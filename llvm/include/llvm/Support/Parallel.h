@@ -69,8 +69,16 @@ public:
     std::unique_lock<std::mutex> lock(Mutex);
     Cond.wait(lock, [&] { return Count == 0; });
   }
+
+  bool done() const {
+    std::lock_guard<std::mutex> lock(Mutex);
+    return Count == 0;
+  }
 };
 
+/// A set of tasks spawned on the default executor that can be waited for
+/// together. Task groups may be nested: a thread waiting in sync() runs other
+/// queued tasks in the meantime instead of blocking a worker.
 class TaskGroup {
   Latch L;
   bool Parallel;
@@ -81,7 +89,7 @@ public:
 
   void spawn(std::function<void()> f);
 
-  void sync() const { L.sync(); }
+  void sync() const;
 };
 
 #if defined(_MSC_VER)
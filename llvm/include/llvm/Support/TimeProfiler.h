@@ -19,7 +19,16 @@ extern TimeTraceProfiler *TimeTraceProfilerInstance;
 /// Initialize the time trace profiler.
 /// This sets up the global \p TimeTraceProfilerInstance
 /// variable to be the profiler instance.
-void timeTraceProfilerInitialize(unsigned TimeTraceGranularity);
+///
+/// If \p SummaryLimit is non-zero, the profiler also totals the time of each
+/// section name per detail, with template arguments removed from the detail
+/// (so that e.g. all instantiations of \c std::vector are counted together),
+/// and writes the \p SummaryLimit most expensive ones for each name.
+/// If \p SummaryOnly is set, only those summaries and the per-name totals
+/// are written, which keeps the output small for large inputs.
+void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
+                                 unsigned SummaryLimit = 0,
+                                 bool SummaryOnly = false);
 
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
@@ -45,6 +54,11 @@ void timeTraceProfilerBegin(StringRef Name,
 /// Manually end the last time section.
 void timeTraceProfilerEnd();
 
+/// Return \p Detail with all template argument lists removed, which is the
+/// key used to summarize sections. For example, "std::vector<int>::push_back"
+/// becomes "std::vector::push_back".
+std::string timeTraceSummaryKey(StringRef Detail);
+
 /// The TimeTraceScope is a helper class to call the begin and end functions
 /// of the time trace profiler.  When the object is constructed, it begins
 /// the section; and when it is destroyed, it stops it. If the time profiler
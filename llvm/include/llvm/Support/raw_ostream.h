@@ -13,6 +13,7 @@
 #ifndef LLVM_SUPPORT_RAW_OSTREAM_H
 #define LLVM_SUPPORT_RAW_OSTREAM_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include <cassert>
@@ -534,6 +535,45 @@ public:
   StringRef str() { return StringRef(OS.data(), OS.size()); }
 };
 
+/// A raw_ostream that writes into a preallocated region of memory, typically
+/// a slice of a FileOutputBuffer. The region itself is used as the stream's
+/// buffer, so output is formatted directly into its final location without
+/// an intermediate copy. Streams over disjoint regions share no state and can
+/// be written from different threads at the same time.
+///
+/// Writers that can't compute their exact size up front may write past the
+/// end of the region. The excess is kept in a separate growable buffer, and
+/// tell() reports the total size, so that the caller can allocate a larger
+/// output and write again, or copy getOverflow() somewhere else.
+class raw_region_ostream : public raw_pwrite_stream {
+  MutableArrayRef<uint8_t> Region;
+  /// The number of bytes of the region that have been written.
+  size_t Pos = 0;
+  SmallVector<char, 0> Overflow;
+
+  /// See raw_ostream::write_impl.
+  void write_impl(const char *Ptr, size_t Size) override;
+
+  void pwrite_impl(const char *Ptr, size_t Size, uint64_t Offset) override;
+
+  /// Return the current position within the stream, not counting the bytes
+  /// currently in the buffer.
+  uint64_t current_pos() const override { return Pos + Overflow.size(); }
+
+public:
+  explicit raw_region_ostream(MutableArrayRef<uint8_t> Region);
+  ~raw_region_ostream() override;
+
+  /// Returns true if more was written than fits in the region.
+  bool overflowed() const { return !Overflow.empty(); }
+
+  /// Returns the output that didn't fit in the region.
+  StringRef getOverflow() {
+    flush();
+    return StringRef(Overflow.data(), Overflow.size());
+  }
+};
+
 /// A raw_ostream that discards all output.
 class raw_null_ostream : public raw_pwrite_stream {
   /// See raw_ostream::write_impl.
@@ -44,6 +44,14 @@
 namespace llvm {
 uint64_t xxHash64(llvm::StringRef Data);
 uint64_t xxHash64(llvm::ArrayRef<uint8_t> Data);
+
+/// Computes the 64-bit XXH3 hash of \p Data. XXH3 is considerably faster
+/// than xxHash64 on short and on long inputs. The result is a different
+/// value, so only use it where the hash is not written to an output file.
+uint64_t xxh3_64bits(llvm::ArrayRef<uint8_t> Data);
+inline uint64_t xxh3_64bits(llvm::StringRef Data) {
+  return xxh3_64bits(llvm::makeArrayRef(Data.bytes_begin(), Data.size()));
+}
 }
 
 #endif
@@ -62,7 +62,10 @@ public:
     // This corresponds to NoInline being set on the function summary,
     // which will happen if it is known that the inliner will not be able
     // to inline the function (e.g. it is marked with a NoInline attribute).
-    NoInline
+    NoInline,
+    // Importing the function would exceed the instruction budget of the
+    // importing module (-import-module-instr-budget).
+    BudgetExhausted
   };
 
   /// Information optionally tracked for candidates the importer decided
@@ -27,6 +27,7 @@
 namespace llvm {
 
 class TargetLibraryInfo;
+class WeakVH;
 using LoadStorePair = std::pair<Instruction *, Instruction *>;
 
 /// Instrumentation based profiling lowering pass. This pass lowers
@@ -81,9 +82,16 @@ private:
   /// Register-promote counter loads and stores in loops.
   void promoteCounterLoadStores(Function *F);
 
+  /// Turn the counter updates behind \p CounterStores that were not promoted
+  /// back into atomic adds.
+  void makeUnpromotedCountersAtomic(ArrayRef<WeakVH> CounterStores);
+
   /// Returns true if profile counter update register promotion is enabled.
   bool isCounterPromotionEnabled() const;
 
+  /// Returns true if profile counters must be updated atomically.
+  bool isAtomicCounterUpdateEnabled() const;
+
   /// Count the number of instrumented value sites for the function.
   void computeNumValueSiteCounts(InstrProfValueProfileInst *Ins);
 
@@ -15,6 +15,7 @@
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/ConstantFolding.h"
 #include "llvm/Analysis/InstructionSimplify.h"
@@ -33,6 +34,7 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/PatternMatch.h"
 #include "llvm/IR/ValueHandle.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Support/raw_ostream.h"
@@ -42,9 +44,20 @@ using namespace PatternMatch;
 
 #define DEBUG_TYPE "lazy-value-info"
 
+STATISTIC(NumCacheFlushes, "Number of times the LVI cache hit its size cap");
+
 // This is the number of worklist items we will process to try to discover an
 // answer for a given value.
-static const unsigned MaxProcessedPerValue = 500;
+static cl::opt<unsigned> MaxProcessedPerValue(
+    "lvi-max-processed-per-value", cl::Hidden, cl::init(500),
+    cl::desc("Maximum number of block values to solve for one query before "
+             "giving up with overdefined"));
+
+// Bounds the memory of the cache on large CFGs. Zero means no limit.
+static cl::opt<unsigned> MaxCacheEntries(
+    "lvi-max-cache-entries", cl::Hidden, cl::init(0),
+    cl::desc("Flush the LVI cache between queries once it holds this many "
+             "block values (0 = no limit)"));
 
 char LazyValueInfoWrapperPass::ID = 0;
 INITIALIZE_PASS_BEGIN(LazyValueInfoWrapperPass, "lazy-value-info",
@@ -175,6 +188,9 @@ namespace {
     DenseMap<Value *, std::unique_ptr<ValueCacheEntryTy>> ValueCache;
     OverDefinedCacheTy OverDefinedCache;
 
+    /// The number of results inserted since the last clear. Erasures do not
+    /// decrement it, so it is an upper bound on the cache size.
+    unsigned NumEntries = 0;
 
   public:
     void insertResult(Value *Val, BasicBlock *BB,
@@ -183,19 +199,26 @@ namespace {
 
       // Insert over-defined values into their own cache to reduce memory
       // overhead.
-      if (Result.isOverdefined())
-        OverDefinedCache[BB].insert(Val);
-      else {
+      if (Result.isOverdefined()) {
+        if (OverDefinedCache[BB].insert(Val).second)
+          ++NumEntries;
+      } else {
         auto It = ValueCache.find_as(Val);
         if (It == ValueCache.end()) {
           ValueCache[Val] = make_unique<ValueCacheEntryTy>(Val, this);
           It = ValueCache.find_as(Val);
           assert(It != ValueCache.end() && "Val was just added to the map!");
         }
-        It->second->BlockVals[BB] = Result;
+        auto Inserted = It->second->BlockVals.try_emplace(BB, Result);
+        if (Inserted.second)
+          ++NumEntries;
+        else
+          Inserted.first->second = Result;
       }
     }
 
+    unsigned getNumEntries() const { return NumEntries; }
+
     bool isOverdefined(Value *V, BasicBlock *BB) const {
       auto ODI = OverDefinedCache.find(BB);
 
@@ -234,6 +257,7 @@ namespace {
       SeenBlocks.clear();
       ValueCache.clear();
       OverDefinedCache.clear();
+      NumEntries = 0;
     }
 
     /// Inform the cache that a given value has been deleted.
@@ -440,6 +464,16 @@ namespace {
 
   void solve();
 
+  /// Flush the cache if it has outgrown -lvi-max-cache-entries. Only called
+  /// at the start of a query, when no solver state refers to the cache.
+  void enforceCacheLimit() {
+    if (MaxCacheEntries && TheCache.getNumEntries() > MaxCacheEntries) {
+      LLVM_DEBUG(dbgs() << "LVI cache is over its cap, flushing it\n");
+      ++NumCacheFlushes;
+      TheCache.clear();
+    }
+  }
+
   public:
     /// This is the query interface to determine the lattice
     /// value for the specified Value* at the end of the specified block.
@@ -1502,6 +1536,7 @@ ValueLatticeElement LazyValueInfoImpl::getValueInBlock(Value *V, BasicBlock *BB,
                     << BB->getName() << "'\n");
 
   assert(BlockValueStack.empty() && BlockValueSet.empty());
+  enforceCacheLimit();
   if (!hasBlockValue(V, BB)) {
     pushBlockValue(std::make_pair(BB, V));
     solve();
@@ -1536,6 +1571,7 @@ getValueOnEdge(Value *V, BasicBlock *FromBB, BasicBlock *ToBB,
                     << FromBB->getName() << "' to '" << ToBB->getName()
                     << "'\n");
 
+  enforceCacheLimit();
   ValueLatticeElement Result;
   if (!getEdgeValue(V, FromBB, ToBB, Result, CxtI)) {
     solve();
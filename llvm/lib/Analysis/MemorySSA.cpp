@@ -1074,6 +1074,29 @@ public:
   }
 };
 
+/// A CachingWalker that owns its ClobberWalkerBase, for getBatchWalker.
+class MemorySSA::BatchWalker final : public MemorySSAWalker {
+  ClobberWalkerBase<BatchAAResults> WalkerBase;
+  CachingWalker<BatchAAResults> Walker;
+
+public:
+  BatchWalker(MemorySSA *M, BatchAAResults *BAA, DominatorTree *D)
+      : MemorySSAWalker(M), WalkerBase(M, BAA, D), Walker(M, &WalkerBase) {}
+  ~BatchWalker() override = default;
+
+  using MemorySSAWalker::getClobberingMemoryAccess;
+
+  MemoryAccess *getClobberingMemoryAccess(MemoryAccess *MA) override {
+    return Walker.getClobberingMemoryAccess(MA);
+  }
+  MemoryAccess *getClobberingMemoryAccess(MemoryAccess *MA,
+                                          const MemoryLocation &Loc) override {
+    return Walker.getClobberingMemoryAccess(MA, Loc);
+  }
+
+  void invalidateInfo(MemoryAccess *MA) override { Walker.invalidateInfo(MA); }
+};
+
 } // end namespace llvm
 
 void MemorySSA::renameSuccessorPhis(BasicBlock *BB, MemoryAccess *IncomingVal,
@@ -1561,6 +1584,11 @@ MemorySSA::CachingWalker<AliasAnalysis> *MemorySSA::getWalkerImpl() {
   return Walker.get();
 }
 
+std::unique_ptr<MemorySSAWalker>
+MemorySSA::getBatchWalker(BatchAAResults &BAA) {
+  return llvm::make_unique<BatchWalker>(this, &BAA, DT);
+}
+
 MemorySSAWalker *MemorySSA::getSkipSelfWalker() {
   if (SkipWalker)
     return SkipWalker.get();
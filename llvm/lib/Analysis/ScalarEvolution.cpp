@@ -145,6 +145,8 @@ STATISTIC(NumTripCountsNotComputed,
           "Number of loops without predictable loop counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumOverBudget,
+          "Number of queries given up because the cost budget was spent");
 
 static cl::opt<unsigned>
 MaxBruteForceIterations("scalar-evolution-max-iterations", cl::ReallyHidden,
@@ -211,6 +213,17 @@ static cl::opt<unsigned>
                   cl::desc("Max coefficients in AddRec during evolving"),
                   cl::init(8));
 
+static cl::opt<unsigned> MaxSCEVCost(
+    "scalar-evolution-max-cost", cl::Hidden,
+    cl::desc("Maximum number of SCEVs created and trip counts computed per "
+             "ScalarEvolution instance before it gives up (0 = no limit)"),
+    cl::init(0));
+
+static cl::opt<bool> PrintSCEVCost(
+    "scalar-evolution-print-cost", cl::Hidden,
+    cl::desc("Print the work done by each ScalarEvolution instance when it "
+             "is destroyed"));
+
 static cl::opt<unsigned>
     HugeExprThreshold("scalar-evolution-huge-expr-threshold", cl::Hidden,
                   cl::desc("Size of the expression which is considered huge"),
@@ -6122,6 +6135,10 @@ const SCEV *ScalarEvolution::createSCEV(Value *V) {
     // analysis depends on.
     if (!DT.isReachableFromEntry(I->getParent()))
       return getUnknown(UndefValue::get(V->getType()));
+    if (!consumeCost()) {
+      ++NumOverBudget;
+      return getUnknown(V);
+    }
   } else if (ConstantInt *CI = dyn_cast<ConstantInt>(V))
     return getConstant(CI);
   else if (isa<ConstantPointerNull>(V))
@@ -6628,6 +6645,10 @@ ScalarEvolution::getPredicatedBackedgeTakenInfo(const Loop *L) {
   if (!Pair.second)
     return Pair.first->second;
 
+  if (!consumeCost()) {
+    ++NumOverBudget;
+    return Pair.first->second;
+  }
   BackedgeTakenInfo Result =
       computeBackedgeTakenCount(L, /*AllowPredicates=*/true);
 
@@ -6646,6 +6667,12 @@ ScalarEvolution::getBackedgeTakenInfo(const Loop *L) {
   if (!Pair.second)
     return Pair.first->second;
 
+  // Leave the CouldNotCompute entry in place if we're out of budget.
+  if (!consumeCost()) {
+    ++NumOverBudget;
+    return Pair.first->second;
+  }
+
   // computeBackedgeTakenCount may allocate memory for its result. Inserting it
   // into the BackedgeTakenCounts map transfers ownership. Otherwise, the result
   // must be cleared in this scope.
@@ -11326,7 +11353,7 @@ ScalarEvolution::SCEVCallbackVH::SCEVCallbackVH(Value *V, ScalarEvolution *se)
 ScalarEvolution::ScalarEvolution(Function &F, TargetLibraryInfo &TLI,
                                  AssumptionCache &AC, DominatorTree &DT,
                                  LoopInfo &LI)
-    : F(F), TLI(TLI), AC(AC), DT(DT), LI(LI),
+    : F(F), CostBudget(MaxSCEVCost), TLI(TLI), AC(AC), DT(DT), LI(LI),
       CouldNotCompute(new SCEVCouldNotCompute()), ValuesAtScopes(64),
       LoopDispositions(64), BlockDispositions(64) {
   // To use guards for proving predicates, we need to scan every instruction in
@@ -11345,8 +11372,9 @@ ScalarEvolution::ScalarEvolution(Function &F, TargetLibraryInfo &TLI,
 }
 
 ScalarEvolution::ScalarEvolution(ScalarEvolution &&Arg)
-    : F(Arg.F), HasGuards(Arg.HasGuards), TLI(Arg.TLI), AC(Arg.AC), DT(Arg.DT),
-      LI(Arg.LI), CouldNotCompute(std::move(Arg.CouldNotCompute)),
+    : F(Arg.F), HasGuards(Arg.HasGuards), CostBudget(Arg.CostBudget),
+      Cost(Arg.Cost), TLI(Arg.TLI), AC(Arg.AC), DT(Arg.DT), LI(Arg.LI),
+      CouldNotCompute(std::move(Arg.CouldNotCompute)),
       ValueExprMap(std::move(Arg.ValueExprMap)),
       PendingLoopPredicates(std::move(Arg.PendingLoopPredicates)),
       PendingPhiRanges(std::move(Arg.PendingPhiRanges)),
@@ -11370,9 +11398,17 @@ ScalarEvolution::ScalarEvolution(ScalarEvolution &&Arg)
       PredicatedSCEVRewrites(std::move(Arg.PredicatedSCEVRewrites)),
       FirstUnknown(Arg.FirstUnknown) {
   Arg.FirstUnknown = nullptr;
+  // Only the moved-to instance reports its cost.
+  Arg.Cost = 0;
 }
 
 ScalarEvolution::~ScalarEvolution() {
+  // A function that is analyzed again after being invalidated reports once
+  // per analysis, which is the point: that work is redone.
+  if (PrintSCEVCost && Cost)
+    errs() << "SCEV cost for '" << F.getName() << "': " << Cost
+           << (CostBudget && Cost >= CostBudget ? " (budget spent)\n" : "\n");
+
   // Iterate through all the SCEVUnknown instances and call their
   // destructors, so that they release their references to their values.
   for (SCEVUnknown *U = FirstUnknown; U;) {
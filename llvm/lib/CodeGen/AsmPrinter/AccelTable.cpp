@@ -54,7 +54,9 @@ void AccelTableBase::computeBucketCount() {
 void AccelTableBase::finalize(AsmPrinter *Asm, StringRef Prefix) {
   // Create the individual hash data outputs.
   for (auto &E : Entries) {
-    // Unique the entries.
+    // Unique the entries. Most names have a single entry.
+    if (E.second.Values.size() < 2)
+      continue;
     llvm::stable_sort(E.second.Values,
                       [](const AccelTableData *A, const AccelTableData *B) {
                         return *A < *B;
@@ -70,8 +72,14 @@ void AccelTableBase::finalize(AsmPrinter *Asm, StringRef Prefix) {
   // referenced when emitting the offsets.
   computeBucketCount();
 
-  // Compute bucket contents and final ordering.
+  // Compute bucket contents and final ordering. Size every bucket up front so
+  // filling them doesn't reallocate.
   Buckets.resize(BucketCount);
+  std::vector<uint32_t> BucketSizes(BucketCount);
+  for (const auto &E : Entries)
+    ++BucketSizes[E.second.HashValue % BucketCount];
+  for (uint32_t I = 0; I != BucketCount; ++I)
+    Buckets[I].reserve(BucketSizes[I]);
   for (auto &E : Entries) {
     uint32_t Bucket = E.second.HashValue % BucketCount;
     Buckets[Bucket].push_back(&E.second);
@@ -81,9 +89,10 @@ void AccelTableBase::finalize(AsmPrinter *Asm, StringRef Prefix) {
   // Sort the contents of the buckets by hash value so that hash collisions end
   // up together. Stable sort makes testing easier and doesn't cost much more.
   for (auto &Bucket : Buckets)
-    llvm::stable_sort(Bucket, [](HashData *LHS, HashData *RHS) {
-      return LHS->HashValue < RHS->HashValue;
-    });
+    if (Bucket.size() > 1)
+      llvm::stable_sort(Bucket, [](HashData *LHS, HashData *RHS) {
+        return LHS->HashValue < RHS->HashValue;
+      });
 }
 
 namespace {
@@ -91,6 +91,14 @@ static cl::opt<bool> UseDwarfRangesBaseAddressSpecifier(
     "use-dwarf-ranges-base-address-specifier", cl::Hidden,
     cl::desc("Use base address specifiers in debug_ranges"), cl::init(false));
 
+// Off by default: lldb can't read DW_LLE_base_addressx or DW_LLE_offset_pair
+// entries in lists of units that have no base address yet.
+static cl::opt<bool> UseDwarfLoclistsBaseAddressx(
+    "use-dwarf-loclists-base-addressx", cl::Hidden,
+    cl::desc("Use DW_LLE_base_addressx and offset pairs for DWARF v5 "
+             "location lists of units without a base address"),
+    cl::init(false));
+
 static cl::opt<bool> GenerateARangeSection("generate-arange-section",
                                            cl::Hidden,
                                            cl::desc("Generate dwarf aranges"),
@@ -2162,7 +2170,30 @@ void DwarfDebug::emitDebugLoc() {
 
     const DwarfCompileUnit *CU = List.CU;
     const MCSymbol *Base = CU->getBaseAddress();
-    for (const auto &Entry : DebugLocs.getEntries(List)) {
+    auto Entries = DebugLocs.getEntries(List);
+
+    // Without a unit base address, a DWARF v5 list of several entries in one
+    // section is shorter as a DW_LLE_base_addressx followed by offset pairs
+    // than as one address pool index per entry.
+    bool UseListBase = false;
+    if (UseDwarfLoclistsBaseAddressx && IsLocLists && !Base &&
+        Entries.size() > 1) {
+      const MCSymbol *First = Entries.front().BeginSym;
+      UseListBase = First->isInSection() &&
+                    llvm::all_of(Entries, [&](const DebugLocStream::Entry &E) {
+                      return E.BeginSym->isInSection() &&
+                             &E.BeginSym->getSection() == &First->getSection();
+                    });
+      if (UseListBase) {
+        Base = First;
+        Asm->OutStreamer->AddComment("DW_LLE_base_addressx");
+        Asm->emitInt8(dwarf::DW_LLE_base_addressx);
+        Asm->OutStreamer->AddComment("  base address index");
+        Asm->EmitULEB128(AddrPool.getIndex(Base));
+      }
+    }
+
+    for (const auto &Entry : Entries) {
       if (Base) {
         // Set up the range. This range is relative to the entry point of the
         // compile unit. This is a hard coded 0 for low_pc when we're emitting
@@ -2185,10 +2216,6 @@ void DwarfDebug::emitDebugLoc() {
 
       // We have no base address.
       if (IsLocLists) {
-        // TODO: Use DW_LLE_base_addressx + DW_LLE_offset_pair, or
-        // DW_LLE_startx_length in case if there is only a single range.
-        // That should reduce the size of the debug data emited.
-        // For now just use the DW_LLE_startx_length for all cases.
         Asm->OutStreamer->AddComment("DW_LLE_startx_length");
         Asm->emitInt8(dwarf::DW_LLE_startx_length);
         Asm->OutStreamer->AddComment("  start idx");
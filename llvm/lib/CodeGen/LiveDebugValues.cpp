@@ -51,6 +51,7 @@
 #include "llvm/MC/MCRegisterInfo.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
@@ -68,6 +69,23 @@ using namespace llvm;
 #define DEBUG_TYPE "livedebugvalues"
 
 STATISTIC(NumInserted, "Number of DBG_VALUE instructions inserted");
+STATISTIC(NumFunctionsSkipped,
+          "Number of functions too large for range extension");
+
+// The dataflow works on sets of all variable locations in the function, so
+// its cost grows with blocks times DBG_VALUEs. These put a cap on it for
+// pathologically large functions, which then keep only their block-local
+// variable locations.
+static cl::opt<unsigned> InputBBLimit(
+    "livedebugvalues-input-bb-limit", cl::Hidden, cl::init(0),
+    cl::desc("Number of basic blocks from which the DBG_VALUE limit applies "
+             "(0 = no limit)"));
+
+static cl::opt<unsigned> InputDbgValueLimit(
+    "livedebugvalues-input-dbg-value-limit", cl::Hidden, cl::init(0),
+    cl::desc("Maximum number of DBG_VALUEs in functions over the basic block "
+             "limit for which variable locations are extended "
+             "(0 = no limit)"));
 
 // If @MI is a DBG_VALUE with debug value described by a defined
 // register, returns the number of this register. In the other case, returns 0.
@@ -1311,6 +1329,21 @@ bool LiveDebugValues::runOnMachineFunction(MachineFunction &MF) {
                             make_unique<RegScavenger>().get());
   LS.initialize(MF);
 
+  if (InputBBLimit && InputDbgValueLimit && MF.size() > InputBBLimit) {
+    unsigned NumDbgValues = 0;
+    for (const MachineBasicBlock &MBB : MF)
+      for (const MachineInstr &MI : MBB)
+        if (MI.isDebugValue())
+          ++NumDbgValues;
+    if (NumDbgValues > InputDbgValueLimit) {
+      LLVM_DEBUG(dbgs() << "Skipping range extension for " << MF.getName()
+                        << ": " << MF.size() << " blocks, " << NumDbgValues
+                        << " DBG_VALUEs\n");
+      ++NumFunctionsSkipped;
+      return false;
+    }
+  }
+
   bool Changed = ExtendRanges(MF);
   return Changed;
 }
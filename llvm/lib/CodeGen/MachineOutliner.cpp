@@ -96,6 +96,14 @@ static cl::opt<bool> EnableLinkOnceODROutlining(
     cl::desc("Enable the machine outliner on linkonceodr functions"),
     cl::init(false));
 
+// Each rerun rebuilds the suffix tree over the module as it is after the
+// previous round, so sequences that only became repeated by outlining (for
+// example, the calls left behind) can be outlined too.
+static cl::opt<unsigned> OutlinerReruns(
+    "machine-outliner-reruns", cl::init(0), cl::Hidden,
+    cl::desc(
+        "Number of times to rerun the outliner after the initial outline"));
+
 namespace {
 
 /// Represents an undefined index in the suffix tree.
@@ -843,6 +851,10 @@ struct MachineOutliner : public ModulePass {
   /// Set when the pass is constructed in TargetPassConfig.
   bool RunOnAllFunctions = true;
 
+  /// The current outlining round, starting at 0. Used to keep the names of
+  /// functions outlined in different rounds apart.
+  unsigned OutlineRepeatedNum = 0;
+
   StringRef getPassName() const override { return "Machine Outliner"; }
 
   void getAnalysisUsage(AnalysisUsage &AU) const override {
@@ -899,6 +911,10 @@ struct MachineOutliner : public ModulePass {
   /// strings from that tree.
   bool runOnModule(Module &M) override;
 
+  /// Run one round of outlining on \p M.
+  /// \returns true if anything was outlined.
+  bool doOutline(Module &M);
+
   /// Return a DISubprogram for OF if one exists, and null otherwise. Helper
   /// function for remark emission.
   DISubprogram *getSubprogramOrNull(const OutlinedFunction &OF) {
@@ -1095,7 +1111,10 @@ MachineOutliner::createOutlinedFunction(Module &M, OutlinedFunction &OF,
   // Create the function name. This should be unique.
   // FIXME: We should have a better naming scheme. This should be stable,
   // regardless of changes to the outliner's cost model/traversal order.
-  std::string FunctionName = ("OUTLINED_FUNCTION_" + Twine(Name)).str();
+  std::string FunctionName = "OUTLINED_FUNCTION_";
+  if (OutlineRepeatedNum > 0)
+    FunctionName += std::to_string(OutlineRepeatedNum + 1) + "_";
+  FunctionName += std::to_string(Name);
 
   // Create the function using an IR-level function.
   LLVMContext &C = M.getContext();
@@ -1421,8 +1440,6 @@ bool MachineOutliner::runOnModule(Module &M) {
   if (M.empty())
     return false;
 
-  MachineModuleInfo &MMI = getAnalysis<MachineModuleInfo>();
-
   // If the user passed -enable-machine-outliner=always or
   // -enable-machine-outliner, the pass will run on all functions in the module.
   // Otherwise, if the target supports default outlining, it will run on all
@@ -1440,6 +1457,21 @@ bool MachineOutliner::runOnModule(Module &M) {
   // If the user specifies that they want to outline from linkonceodrs, set
   // it here.
   OutlineFromLinkOnceODRs = EnableLinkOnceODROutlining;
+
+  bool Changed = false;
+  for (OutlineRepeatedNum = 0; OutlineRepeatedNum <= OutlinerReruns;
+       ++OutlineRepeatedNum) {
+    // Stop early once a round finds nothing; later rounds would see the same
+    // module.
+    if (!doOutline(M))
+      break;
+    Changed = true;
+  }
+  return Changed;
+}
+
+bool MachineOutliner::doOutline(Module &M) {
+  MachineModuleInfo &MMI = getAnalysis<MachineModuleInfo>();
   InstructionMapper Mapper;
 
   // Prepare instruction mappings for the suffix tree.
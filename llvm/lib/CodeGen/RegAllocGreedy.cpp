@@ -84,6 +84,10 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumEvictBudgetHits,
+          "Number of eviction attempts skipped over the per-function budget");
+STATISTIC(NumRegionSplitBudgetHits,
+          "Number of region splits skipped over the per-function budget");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -130,6 +134,19 @@ static cl::opt<unsigned>
                               "high compile time cost in global splitting."),
                      cl::init(5000));
 
+// Compile-time budgets for functions with very many virtual registers. Once a
+// budget is spent, spillable ranges skip the expensive strategy and fall
+// back to block splitting and spilling, which always make progress.
+static cl::opt<unsigned> MaxEvictAttempts(
+    "regalloc-greedy-max-evictions", cl::Hidden, cl::init(0),
+    cl::desc("Maximum number of eviction attempts per function "
+             "(0 = no limit)"));
+
+static cl::opt<unsigned> MaxRegionSplitAttempts(
+    "regalloc-greedy-max-region-splits", cl::Hidden, cl::init(0),
+    cl::desc("Maximum number of region split attempts per function "
+             "(0 = no limit)"));
+
 // FIXME: Find a good default for this flag and remove the flag.
 static cl::opt<unsigned>
 CSRFirstTimeCost("regalloc-csr-first-time-cost",
@@ -179,6 +196,10 @@ class RAGreedy : public MachineFunctionPass,
   PQueue Queue;
   unsigned NextCascade;
 
+  // Attempts spent against MaxEvictAttempts and MaxRegionSplitAttempts.
+  unsigned NumEvictAttempts;
+  unsigned NumRegionSplitAttempts;
+
   // Live ranges pass through a number of stages as we try to allocate them.
   // Some of the stages may also create new live ranges:
   //
@@ -1108,6 +1129,15 @@ unsigned RAGreedy::tryEvict(LiveInterval &VirtReg,
                             SmallVectorImpl<unsigned> &NewVRegs,
                             unsigned CostPerUseLimit,
                             const SmallVirtRegSet &FixedRegisters) {
+  // Unspillable ranges may depend on eviction, so they are exempt from the
+  // budget.
+  if (MaxEvictAttempts && NumEvictAttempts >= MaxEvictAttempts &&
+      VirtReg.isSpillable()) {
+    ++NumEvictBudgetHits;
+    return 0;
+  }
+  ++NumEvictAttempts;
+
   NamedRegionTimer T("evict", "Evict", TimerGroupName, TimerGroupDescription,
                      TimePassesIsEnabled);
 
@@ -2495,9 +2525,15 @@ unsigned RAGreedy::trySplit(LiveInterval &VirtReg, AllocationOrder &Order,
   // ranges already made dubious progress with region splitting, so they go
   // straight to single block splitting.
   if (getStage(VirtReg) < RS_Split2) {
-    unsigned PhysReg = tryRegionSplit(VirtReg, Order, NewVRegs);
-    if (PhysReg || !NewVRegs.empty())
-      return PhysReg;
+    if (MaxRegionSplitAttempts &&
+        NumRegionSplitAttempts >= MaxRegionSplitAttempts) {
+      ++NumRegionSplitBudgetHits;
+    } else {
+      ++NumRegionSplitAttempts;
+      unsigned PhysReg = tryRegionSplit(VirtReg, Order, NewVRegs);
+      if (PhysReg || !NewVRegs.empty())
+        return PhysReg;
+    }
   }
 
   // Then isolate blocks.
@@ -3251,6 +3287,8 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   ExtraRegInfo.clear();
   ExtraRegInfo.resize(MRI->getNumVirtRegs());
   NextCascade = 1;
+  NumEvictAttempts = 0;
+  NumRegionSplitAttempts = 0;
   IntfCache.init(MF, Matrix->getLiveUnions(), Indexes, LIS, TRI);
   GlobalCand.resize(32);  // This will grow as needed.
   SetOfBrokenHints.clear();
@@ -1027,8 +1027,19 @@ SelectionDAG::~SelectionDAG() {
 void SelectionDAG::allnodes_clear() {
   assert(&*AllNodes.begin() == &EntryNode);
   AllNodes.remove(AllNodes.begin());
-  while (!AllNodes.empty())
-    DeallocateNode(&AllNodes.front());
+  // Unlike DeallocateNode, don't hand operand lists back to the recycler or
+  // forget each node's debug values one at a time: every caller drops the
+  // operand recycler and the debug info wholesale right after this. The
+  // nodes themselves go back to NodeAllocator and are reused by the next
+  // block.
+  while (!AllNodes.empty()) {
+    SDNode *N = AllNodes.remove(AllNodes.begin());
+    N->NumOperands = 0;
+    N->OperandList = nullptr;
+    NodeAllocator.Deallocate(N);
+    __asan_unpoison_memory_region(&N->NodeType, sizeof(N->NodeType));
+    N->NodeType = ISD::DELETED_NODE;
+  }
 #ifndef NDEBUG
   NextPersistentId = 0;
 #endif
@@ -176,13 +176,17 @@ DWARFDebugLoclists::parseOneLocationList(DataExtractor Data, unsigned *Offset,
     case dwarf::DW_LLE_base_address:
       E.Value0 = Data.getAddress(Offset);
       break;
+    case dwarf::DW_LLE_base_addressx:
+      E.Value0 = Data.getULEB128(Offset);
+      break;
     default:
       WithColor::error() << "dumping support for LLE of kind " << (int)Kind
                          << " not implemented\n";
       return None;
     }
 
-    if (Kind != dwarf::DW_LLE_base_address) {
+    if (Kind != dwarf::DW_LLE_base_address &&
+        Kind != dwarf::DW_LLE_base_addressx) {
       unsigned Bytes =
           Version >= 5 ? Data.getULEB128(Offset) : Data.getU16(Offset);
       // A single location description describing the location of the object...
@@ -249,6 +253,17 @@ void DWARFDebugLoclists::LocationList::dump(raw_ostream &OS, uint64_t BaseAddr,
     case dwarf::DW_LLE_base_address:
       BaseAddr = E.Value0;
       break;
+    case dwarf::DW_LLE_base_addressx:
+      // Without the unit the index can't be resolved; print it instead.
+      if (Optional<object::SectionedAddress> SA =
+              U ? U->getAddrOffsetSectionItem(E.Value0) : None) {
+        BaseAddr = SA->Address;
+      } else {
+        OS << '\n';
+        OS.indent(Indent);
+        OS << "Base addr idx " << E.Value0;
+      }
+      break;
     default:
       llvm_unreachable("unreachable locations list kind");
     }
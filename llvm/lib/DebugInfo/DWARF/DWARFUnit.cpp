@@ -401,9 +401,16 @@ void DWARFUnit::extractDIEsToVector(
 }
 
 size_t DWARFUnit::extractDIEsIfNeeded(bool CUDieOnly) {
-  if ((CUDieOnly && !DieArray.empty()) ||
-      DieArray.size() > 1)
-    return 0; // Already parsed.
+  {
+    sys::ScopedReader Lock(DieArrayMutex);
+    if ((CUDieOnly && !DieArray.empty()) || DieArray.size() > 1)
+      return 0; // Already parsed.
+  }
+
+  sys::ScopedWriter Lock(DieArrayMutex);
+  // Another thread may have parsed it since we looked.
+  if ((CUDieOnly && !DieArray.empty()) || DieArray.size() > 1)
+    return 0;
 
   bool HasCUDie = !DieArray.empty();
   extractDIEsToVector(!HasCUDie, !CUDieOnly, DieArray);
@@ -411,9 +418,10 @@ size_t DWARFUnit::extractDIEsIfNeeded(bool CUDieOnly) {
   if (DieArray.empty())
     return 0;
 
-  // If CU DIE was just parsed, copy several attribute values from it.
+  // If CU DIE was just parsed, copy several attribute values from it. This
+  // runs with the lock held, so it must not go through getUnitDIE().
   if (!HasCUDie) {
-    DWARFDie UnitDie = getUnitDIE();
+    DWARFDie UnitDie(this, &DieArray[0]);
     if (Optional<uint64_t> DWOId = toUnsigned(UnitDie.find(DW_AT_GNU_dwo_id)))
       Header.setDWOId(*DWOId);
     if (!IsDWO) {
@@ -534,6 +542,7 @@ bool DWARFUnit::parseDWO() {
 }
 
 void DWARFUnit::clearDIEs(bool KeepCUDie) {
+  sys::ScopedWriter Lock(DieArrayMutex);
   if (DieArray.size() > (unsigned)KeepCUDie) {
     DieArray.resize((unsigned)KeepCUDie);
     DieArray.shrink_to_fit();
@@ -621,6 +630,7 @@ void DWARFUnit::updateAddressDieMap(DWARFDie Die) {
 
 DWARFDie DWARFUnit::getSubroutineForAddress(uint64_t Address) {
   extractDIEsIfNeeded(false);
+  std::lock_guard<std::mutex> Lock(AddrDieMapMutex);
   if (AddrDieMap.empty())
     updateAddressDieMap(getUnitDIE());
   auto R = AddrDieMap.upper_bound(Address);
@@ -850,7 +860,9 @@ DWARFUnit::determineStringOffsetsTableContribution(DWARFDataExtractor &DA) {
     if (DA.getData().data() == nullptr)
       return None;
   } else {
-    auto OptOffset = toSectionOffset(getUnitDIE().find(DW_AT_str_offsets_base));
+    // Called while extracting the unit DIE, see extractDIEsIfNeeded().
+    DWARFDie UnitDie(this, &DieArray[0]);
+    auto OptOffset = toSectionOffset(UnitDie.find(DW_AT_str_offsets_base));
     if (!OptOffset)
       return None;
     Offset = *OptOffset;
@@ -142,19 +142,41 @@ uint32_t TpiStream::getNumHashBuckets() const { return Header->NumHashBuckets; }
 uint32_t TpiStream::getHashKeySize() const { return Header->HashKeySize; }
 
 void TpiStream::buildHashMap() {
-  if (!HashMap.empty())
+  if (!HashBucketStarts.empty())
     return;
   if (HashValues.empty())
     return;
 
-  HashMap.resize(Header->NumHashBuckets);
-
+  // Count the types in each bucket, then place them, so that all buckets
+  // share one allocation. Types stay in index order within a bucket.
+  uint32_t NumBuckets = Header->NumHashBuckets;
   TypeIndex TIB{Header->TypeIndexBegin};
   TypeIndex TIE{Header->TypeIndexEnd};
-  while (TIB < TIE) {
-    uint32_t HV = HashValues[TIB.toArrayIndex()];
-    HashMap[HV].push_back(TIB++);
+  std::vector<uint32_t> Starts(NumBuckets + 1);
+  for (TypeIndex TI = TIB; TI < TIE; ++TI) {
+    uint32_t HV = HashValues[TI.toArrayIndex()];
+    if (HV < NumBuckets)
+      ++Starts[HV + 1];
+  }
+  for (uint32_t I = 0; I != NumBuckets; ++I)
+    Starts[I + 1] += Starts[I];
+
+  std::vector<uint32_t> Next(Starts.begin(), Starts.end() - 1);
+  HashBuckets.resize(Starts.back());
+  for (TypeIndex TI = TIB; TI < TIE; ++TI) {
+    uint32_t HV = HashValues[TI.toArrayIndex()];
+    if (HV < NumBuckets)
+      HashBuckets[Next[HV]++] = TI;
   }
+  HashBucketStarts = std::move(Starts);
+}
+
+ArrayRef<TypeIndex> TpiStream::getHashBucket(uint32_t Bucket) const {
+  if (Bucket + 1 >= HashBucketStarts.size())
+    return {};
+  return makeArrayRef(HashBuckets)
+      .slice(HashBucketStarts[Bucket],
+             HashBucketStarts[Bucket + 1] - HashBucketStarts[Bucket]);
 }
 
 std::vector<TypeIndex> TpiStream::findRecordsByName(StringRef Name) const {
@@ -162,11 +184,8 @@ std::vector<TypeIndex> TpiStream::findRecordsByName(StringRef Name) const {
     const_cast<TpiStream*>(this)->buildHashMap();
 
   uint32_t Bucket = hashStringV1(Name) % Header->NumHashBuckets;
-  if (Bucket > HashMap.size())
-    return {};
-
   std::vector<TypeIndex> Result;
-  for (TypeIndex TI : HashMap[Bucket]) {
+  for (TypeIndex TI : getHashBucket(Bucket)) {
     std::string ThisName = computeTypeName(*Types, TI);
     if (ThisName == Name)
       Result.push_back(TI);
@@ -174,7 +193,9 @@ std::vector<TypeIndex> TpiStream::findRecordsByName(StringRef Name) const {
   return Result;
 }
 
-bool TpiStream::supportsTypeLookup() const { return !HashMap.empty(); }
+bool TpiStream::supportsTypeLookup() const {
+  return !HashBucketStarts.empty();
+}
 
 Expected<TypeIndex>
 TpiStream::findFullDeclForForwardRef(TypeIndex ForwardRefTI) const {
@@ -191,7 +212,7 @@ TpiStream::findFullDeclForForwardRef(TypeIndex ForwardRefTI) const {
 
   uint32_t BucketIdx = ForwardTRH->FullRecordHash % Header->NumHashBuckets;
 
-  for (TypeIndex TI : HashMap[BucketIdx]) {
+  for (TypeIndex TI : getHashBucket(BucketIdx)) {
     CVType CVT = Types->getType(TI);
     if (CVT.kind() != F.kind())
       continue;
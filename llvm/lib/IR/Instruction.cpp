@@ -20,6 +20,12 @@
 #include "llvm/IR/Type.h"
 using namespace llvm;
 
+// An Instruction is a User plus its position in the parent block's list, the
+// parent block and the debug location. Instructions dominate IR memory, so
+// add an assert to prevent people from accidentally growing them.
+static_assert(sizeof(Instruction) == sizeof(User) + 4 * sizeof(void *),
+              "unexpected Instruction size growth");
+
 Instruction::Instruction(Type *ty, unsigned it, Use *Ops, unsigned NumOps,
                          Instruction *InsertBefore)
   : User(ty, Value::InstructionVal + it, Ops, NumOps), Parent(nullptr) {
@@ -3870,7 +3870,9 @@ SwitchInst::CaseIt SwitchInst::removeCase(CaseIt I) {
 ///
 void SwitchInst::growOperands() {
   unsigned e = getNumOperands();
-  unsigned NumOps = e*3;
+  // Doubling is enough to keep addCase() amortized constant time, and wastes
+  // less memory on the 24-byte Uses than tripling did.
+  unsigned NumOps = e*2;
 
   ReservedSpace = NumOps;
   growHungoffUses(ReservedSpace);
@@ -13,6 +13,12 @@
 
 namespace llvm {
 
+// A Use is the operand of a User and a link in its Value's use list. There is
+// one for every operand in the module, so keep it from growing: the User is
+// found by waymarking instead of being stored (see getImpliedUser()).
+static_assert(sizeof(Use) == 3 * sizeof(void *),
+              "unexpected Use size growth");
+
 void Use::swap(Use &RHS) {
   if (Val == RHS.Val)
     return;
@@ -27,8 +27,43 @@
 using namespace llvm;
 using namespace llvm::lto;
 
+// Copies an object fetched from the remote cache into the local cache. This
+// is best effort; the object is added to the link whether or not it succeeds.
+static void addToLocalCache(StringRef CacheDirectoryPath, StringRef EntryPath,
+                            StringRef Object) {
+  SmallString<64> TempFilenameModel;
+  sys::path::append(TempFilenameModel, CacheDirectoryPath, "Thin-%%%%%%.tmp.o");
+  Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+      TempFilenameModel, sys::fs::owner_read | sys::fs::owner_write);
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+  {
+    raw_fd_ostream OS(Temp->FD, /* ShouldClose */ false);
+    OS << Object;
+    OS.flush();
+    // Don't leave a truncated object in the cache.
+    if (OS.has_error()) {
+      OS.clear_error();
+      consumeError(Temp->discard());
+      return;
+    }
+  }
+  if (Error E = Temp->keep(EntryPath)) {
+    consumeError(std::move(E));
+    consumeError(Temp->discard());
+  }
+}
+
 Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
                                             AddBufferFn AddBuffer) {
+  return localCache(CacheDirectoryPath, std::move(AddBuffer), RemoteCache());
+}
+
+Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
+                                            AddBufferFn AddBuffer,
+                                            RemoteCache Remote) {
   if (std::error_code EC = sys::fs::create_directories(CacheDirectoryPath))
     return errorCodeToError(EC);
 
@@ -67,6 +102,15 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
       report_fatal_error(Twine("Failed to open cache file ") + EntryPath +
                          ": " + EC.message() + "\n");
 
+    // Next, try the remote cache.
+    if (Remote.Fetch) {
+      if (std::unique_ptr<MemoryBuffer> MB = Remote.Fetch(Key)) {
+        addToLocalCache(CacheDirectoryPath, EntryPath, MB->getBuffer());
+        AddBuffer(Task, std::move(MB));
+        return AddStreamFn();
+      }
+    }
+
     // This native object stream is responsible for commiting the resulting
     // file to the cache and calling AddBuffer to add it to the link.
     struct CacheStream : NativeObjectStream {
@@ -74,13 +118,17 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
       sys::fs::TempFile TempFile;
       std::string EntryPath;
       unsigned Task;
+      std::function<void(StringRef, MemoryBufferRef)> Store;
+      std::string Key;
 
       CacheStream(std::unique_ptr<raw_pwrite_stream> OS, AddBufferFn AddBuffer,
                   sys::fs::TempFile TempFile, std::string EntryPath,
-                  unsigned Task)
+                  unsigned Task,
+                  std::function<void(StringRef, MemoryBufferRef)> Store,
+                  std::string Key)
           : NativeObjectStream(std::move(OS)), AddBuffer(std::move(AddBuffer)),
             TempFile(std::move(TempFile)), EntryPath(std::move(EntryPath)),
-            Task(Task) {}
+            Task(Task), Store(std::move(Store)), Key(std::move(Key)) {}
 
       ~CacheStream() {
         // Make sure the stream is closed before committing it.
@@ -126,6 +174,8 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
                              TempFile.TmpName + " to " + EntryPath + ": " +
                              toString(std::move(E)) + "\n");
 
+        if (Store)
+          Store(Key, (*MBOrErr)->getMemBufferRef());
         AddBuffer(Task, std::move(*MBOrErr));
       }
     };
@@ -144,7 +194,8 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
       // This CacheStream will move the temporary file into the cache when done.
       return llvm::make_unique<CacheStream>(
           llvm::make_unique<raw_fd_ostream>(Temp->FD, /* ShouldClose */ false),
-          AddBuffer, std::move(*Temp), EntryPath.str(), Task);
+          AddBuffer, std::move(*Temp), EntryPath.str(), Task, Remote.Store,
+          Key.str());
     };
   };
 }
@@ -30,6 +30,7 @@
 #include "llvm/Linker/IRMover.h"
 #include "llvm/Object/IRObjectFile.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -47,6 +48,7 @@
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
 #include "llvm/Transforms/Utils/SplitModule.h"
 
+#include <chrono>
 #include <set>
 
 using namespace llvm;
@@ -59,6 +61,18 @@ static cl::opt<bool>
     DumpThinCGSCCs("dump-thin-cg-sccs", cl::init(false), cl::Hidden,
                    cl::desc("Dump the SCCs in the ThinLTO index's callgraph"));
 
+/// Start in-process ThinLTO backend jobs with the largest estimated cost first.
+static cl::opt<bool> ThinLTOScheduleByCost(
+    "thinlto-schedule-by-cost", cl::init(true), cl::Hidden,
+    cl::desc("Start in-process ThinLTO backend jobs in decreasing order of "
+             "their estimated cost"));
+
+/// Report the wall time and estimated cost of every in-process ThinLTO job.
+static cl::opt<bool> ThinLTOReportJobTimes(
+    "thinlto-report-job-times", cl::init(false), cl::Hidden,
+    cl::desc("Print the wall time and estimated cost of each in-process "
+             "ThinLTO backend job, in the order the jobs were started"));
+
 /// Enable global value internalization in LTO.
 cl::opt<bool> EnableLTOInternalization(
     "enable-lto-internalization", cl::init(true), cl::Hidden,
@@ -1027,6 +1041,24 @@ public:
   virtual Error wait() = 0;
 };
 
+// Estimates the cost of a ThinLTO backend job as the number of instructions
+// in the functions its module defines plus those it imports.
+static uint64_t
+estimateBackendCost(const ModuleSummaryIndex &Index,
+                    const GVSummaryMapTy &DefinedGlobals,
+                    const FunctionImporter::ImportMapTy &ImportList) {
+  uint64_t Cost = 0;
+  for (auto &Def : DefinedGlobals)
+    if (auto *FS = dyn_cast<FunctionSummary>(Def.second))
+      Cost += FS->instCount();
+  for (auto &Src : ImportList)
+    for (GlobalValue::GUID GUID : Src.second)
+      if (auto *FS = dyn_cast_or_null<FunctionSummary>(
+              Index.findSummaryInModule(GUID, Src.first())))
+        Cost += FS->instCount();
+  return Cost;
+}
+
 namespace {
 class InProcessThinBackend : public ThinBackendProc {
   ThreadPool BackendThreadPool;
@@ -1038,6 +1070,17 @@ class InProcessThinBackend : public ThinBackendProc {
   Optional<Error> Err;
   std::mutex ErrMu;
 
+  // Jobs are queued by start() and submitted to the thread pool by wait(), so
+  // that the most expensive ones can be started first. Otherwise a huge module
+  // that happens to come last on the command line determines the wall time.
+  struct BackendJob {
+    StringRef ModuleID;
+    uint64_t Cost;
+    std::function<void()> Run;
+    double Seconds = 0;
+  };
+  std::vector<BackendJob> Jobs;
+
 public:
   InProcessThinBackend(
       Config &Conf, ModuleSummaryIndex &CombinedIndex,
@@ -1103,7 +1146,9 @@ public:
     assert(ModuleToDefinedGVSummaries.count(ModulePath));
     const GVSummaryMapTy &DefinedGlobals =
         ModuleToDefinedGVSummaries.find(ModulePath)->second;
-    BackendThreadPool.async(
+    uint64_t Cost =
+        estimateBackendCost(CombinedIndex, DefinedGlobals, ImportList);
+    auto Run = std::bind(
         [=](BitcodeModule BM, ModuleSummaryIndex &CombinedIndex,
             const FunctionImporter::ImportMapTy &ImportList,
             const FunctionImporter::ExportSetTy &ExportList,
@@ -1124,11 +1169,41 @@ public:
         },
         BM, std::ref(CombinedIndex), std::ref(ImportList), std::ref(ExportList),
         std::ref(ResolvedODR), std::ref(DefinedGlobals), std::ref(ModuleMap));
+    Jobs.push_back({ModulePath, Cost, std::move(Run)});
     return Error::success();
   }
 
   Error wait() override {
+    std::vector<BackendJob *> Order;
+    for (BackendJob &Job : Jobs)
+      Order.push_back(&Job);
+    if (ThinLTOScheduleByCost)
+      llvm::stable_sort(Order, [](const BackendJob *A, const BackendJob *B) {
+        return A->Cost > B->Cost;
+      });
+
+    for (BackendJob *Job : Order) {
+      BackendThreadPool.async([Job] {
+        auto Start = std::chrono::steady_clock::now();
+        Job->Run();
+        Job->Seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - Start)
+                           .count();
+      });
+    }
     BackendThreadPool.wait();
+
+    // The jobs are listed in the order they were started, so the report also
+    // shows the effect of -thinlto-schedule-by-cost.
+    if (ThinLTOReportJobTimes) {
+      errs() << "ThinLTO backend jobs in start order "
+                "(wall time, estimated cost, module):\n";
+      for (BackendJob *Job : Order)
+        errs() << format("%10.3fs %12llu ", Job->Seconds,
+                         (unsigned long long)Job->Cost)
+               << Job->ModuleID << "\n";
+    }
+
     if (Err)
       return std::move(*Err);
     else
@@ -1174,16 +1249,25 @@ class WriteIndexesThinBackend : public ThinBackendProc {
   raw_fd_ostream *LinkedObjectsFile;
   lto::IndexWriteCallback OnWrite;
 
+  // The per-module index files only read the combined index, so they are
+  // written concurrently. OnWrite is called from wait() in module order.
+  ThreadPool BackendThreadPool;
+  std::vector<std::string> WrittenModules;
+  Optional<Error> Err;
+  std::mutex ErrMu;
+
 public:
   WriteIndexesThinBackend(
       Config &Conf, ModuleSummaryIndex &CombinedIndex,
       const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
       std::string OldPrefix, std::string NewPrefix, bool ShouldEmitImportsFiles,
-      raw_fd_ostream *LinkedObjectsFile, lto::IndexWriteCallback OnWrite)
+      raw_fd_ostream *LinkedObjectsFile, lto::IndexWriteCallback OnWrite,
+      unsigned ParallelismLevel)
       : ThinBackendProc(Conf, CombinedIndex, ModuleToDefinedGVSummaries),
         OldPrefix(OldPrefix), NewPrefix(NewPrefix),
         ShouldEmitImportsFiles(ShouldEmitImportsFiles),
-        LinkedObjectsFile(LinkedObjectsFile), OnWrite(OnWrite) {}
+        LinkedObjectsFile(LinkedObjectsFile), OnWrite(OnWrite),
+        BackendThreadPool(ParallelismLevel) {}
 
   Error start(
       unsigned Task, BitcodeModule BM,
@@ -1198,6 +1282,36 @@ public:
     if (LinkedObjectsFile)
       *LinkedObjectsFile << NewModulePath << '\n';
 
+    if (OnWrite)
+      WrittenModules.push_back(ModulePath);
+
+    BackendThreadPool.async(
+        [=](const FunctionImporter::ImportMapTy &ImportList) {
+          Error E = emitFiles(ImportList, ModulePath, NewModulePath);
+          if (E) {
+            std::unique_lock<std::mutex> L(ErrMu);
+            if (Err)
+              Err = joinErrors(std::move(*Err), std::move(E));
+            else
+              Err = std::move(E);
+          }
+        },
+        std::ref(ImportList));
+    return Error::success();
+  }
+
+  Error wait() override {
+    BackendThreadPool.wait();
+    if (Err)
+      return std::move(*Err);
+    for (const std::string &ModulePath : WrittenModules)
+      OnWrite(ModulePath);
+    return Error::success();
+  }
+
+private:
+  Error emitFiles(const FunctionImporter::ImportMapTy &ImportList,
+                  StringRef ModulePath, const std::string &NewModulePath) {
     std::map<std::string, GVSummaryMapTy> ModuleToSummariesForIndex;
     gatherImportedSummariesForModule(ModulePath, ModuleToDefinedGVSummaries,
                                      ImportList, ModuleToSummariesForIndex);
@@ -1215,25 +1329,21 @@ public:
       if (EC)
         return errorCodeToError(EC);
     }
-
-    if (OnWrite)
-      OnWrite(ModulePath);
     return Error::success();
   }
-
-  Error wait() override { return Error::success(); }
 };
 } // end anonymous namespace
 
 ThinBackend lto::createWriteIndexesThinBackend(
     std::string OldPrefix, std::string NewPrefix, bool ShouldEmitImportsFiles,
-    raw_fd_ostream *LinkedObjectsFile, IndexWriteCallback OnWrite) {
+    raw_fd_ostream *LinkedObjectsFile, IndexWriteCallback OnWrite,
+    unsigned ParallelismLevel) {
   return [=](Config &Conf, ModuleSummaryIndex &CombinedIndex,
              const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
              AddStreamFn AddStream, NativeObjectCache Cache) {
     return llvm::make_unique<WriteIndexesThinBackend>(
         Conf, CombinedIndex, ModuleToDefinedGVSummaries, OldPrefix, NewPrefix,
-        ShouldEmitImportsFiles, LinkedObjectsFile, OnWrite);
+        ShouldEmitImportsFiles, LinkedObjectsFile, OnWrite, ParallelismLevel);
   };
 }
 
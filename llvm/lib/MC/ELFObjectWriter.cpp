@@ -45,6 +45,7 @@
 #include "llvm/Support/Host.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SMLoc.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/SwapByteOrder.h"
@@ -151,6 +152,15 @@ struct ELFWriter {
   std::vector<const MCSectionELF *> SectionTable;
   unsigned addToSectionTable(const MCSectionELF *Sec);
 
+  /// The contents of a .debug_* section, before and after compression.
+  struct CompressedSectionData {
+    SmallVector<char, 0> Uncompressed;
+    SmallVector<char, 0> Compressed;
+    bool Failed = false;
+  };
+  // Debug sections compressed ahead of time by compressDebugSections.
+  DenseMap<const MCSectionELF *, CompressedSectionData> CompressedSections;
+
   // TargetObjectWriter wrappers.
   bool is64Bit() const;
   bool hasRelocationAddend() const;
@@ -161,6 +171,11 @@ struct ELFWriter {
                              SmallVectorImpl<char> &CompressedContents,
                              bool ZLibStyle, unsigned Alignment);
 
+  bool shouldCompressSection(const MCAssembler &Asm,
+                             const MCSectionELF &Section) const;
+  void compressDebugSections(const MCAssembler &Asm,
+                             const MCAsmLayout &Layout);
+
 public:
   ELFWriter(ELFObjectWriter &OWriter, raw_pwrite_stream &OS,
             bool IsLittleEndian, DwoMode Mode)
@@ -847,6 +862,59 @@ bool ELFWriter::maybeWriteCompression(
   return true;
 }
 
+bool ELFWriter::shouldCompressSection(const MCAssembler &Asm,
+                                      const MCSectionELF &Section) const {
+  const MCAsmInfo *MAI = Asm.getContext().getAsmInfo();
+  if (MAI->compressDebugSections() == DebugCompressionType::None)
+    return false;
+
+  // Compressing debug_frame requires handling alignment fragments which is
+  // more work (possibly generalizing MCAssembler.cpp:writeFragment to allow
+  // for writing to arbitrary buffers) for little benefit.
+  StringRef SectionName = Section.getSectionName();
+  return SectionName.startswith(".debug_") && SectionName != ".debug_frame";
+}
+
+// Compress all the debug sections that will be written, before any of them
+// is. The contents are rendered serially, since that is little more than a
+// copy of the fragments, and then compressed in parallel, which is where the
+// time goes.
+void ELFWriter::compressDebugSections(const MCAssembler &Asm,
+                                      const MCAsmLayout &Layout) {
+  for (const MCSection &Sec : Asm) {
+    const auto &Section = static_cast<const MCSectionELF &>(Sec);
+    if (Mode == NonDwoOnly && isDwoSection(Section))
+      continue;
+    if (Mode == DwoOnly && !isDwoSection(Section))
+      continue;
+    if (!shouldCompressSection(Asm, Section))
+      continue;
+
+    CompressedSectionData &Data = CompressedSections[&Section];
+    raw_svector_ostream VecOS(Data.Uncompressed);
+    Asm.writeSectionData(VecOS, &Section, Layout);
+  }
+
+  // The map does not move its entries once it stops growing.
+  std::vector<CompressedSectionData *> Work;
+  for (auto &Entry : CompressedSections)
+    Work.push_back(&Entry.second);
+  auto Compress = [&](size_t I) {
+    CompressedSectionData &Data = *Work[I];
+    if (Error E = zlib::compress(
+            StringRef(Data.Uncompressed.data(), Data.Uncompressed.size()),
+            Data.Compressed)) {
+      consumeError(std::move(E));
+      Data.Failed = true;
+    }
+  };
+#if LLVM_ENABLE_THREADS
+  parallel::for_each_n(parallel::par, size_t(0), Work.size(), Compress);
+#else
+  parallel::for_each_n(parallel::seq, size_t(0), Work.size(), Compress);
+#endif
+}
+
 void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
                                  const MCAsmLayout &Layout) {
   MCSectionELF &Section = static_cast<MCSectionELF &>(Sec);
@@ -855,13 +923,8 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
   auto &MC = Asm.getContext();
   const auto &MAI = MC.getAsmInfo();
 
-  // Compressing debug_frame requires handling alignment fragments which is
-  // more work (possibly generalizing MCAssembler.cpp:writeFragment to allow
-  // for writing to arbitrary buffers) for little benefit.
-  bool CompressionEnabled =
-      MAI->compressDebugSections() != DebugCompressionType::None;
-  if (!CompressionEnabled || !SectionName.startswith(".debug_") ||
-      SectionName == ".debug_frame") {
+  auto It = CompressedSections.find(&Section);
+  if (It == CompressedSections.end()) {
     Asm.writeSectionData(W.OS, &Section, Layout);
     return;
   }
@@ -870,15 +933,9 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
           MAI->compressDebugSections() == DebugCompressionType::GNU) &&
          "expected zlib or zlib-gnu style compression");
 
-  SmallVector<char, 128> UncompressedData;
-  raw_svector_ostream VecOS(UncompressedData);
-  Asm.writeSectionData(VecOS, &Section, Layout);
-
-  SmallVector<char, 128> CompressedContents;
-  if (Error E = zlib::compress(
-          StringRef(UncompressedData.data(), UncompressedData.size()),
-          CompressedContents)) {
-    consumeError(std::move(E));
+  SmallVectorImpl<char> &UncompressedData = It->second.Uncompressed;
+  SmallVectorImpl<char> &CompressedContents = It->second.Compressed;
+  if (It->second.Failed) {
     W.OS << UncompressedData;
     return;
   }
@@ -1089,6 +1146,8 @@ uint64_t ELFWriter::writeObject(MCAssembler &Asm, const MCAsmLayout &Layout) {
   // Write out the ELF header ...
   writeHeader(Asm);
 
+  compressDebugSections(Asm, Layout);
+
   // ... then the sections ...
   SectionOffsetsTy SectionOffsets;
   std::vector<MCSectionELF *> Groups;
@@ -26,6 +26,10 @@ using namespace llvm;
 MCAsmBackend::MCAsmBackend(support::endianness Endian)
     : CodePadder(new MCCodePadder()), Endian(Endian) {}
 
+MCAsmBackend::MCAsmBackend(support::endianness Endian,
+                           std::unique_ptr<MCCodePadder> CodePadder)
+    : CodePadder(std::move(CodePadder)), Endian(Endian) {}
+
 MCAsmBackend::~MCAsmBackend() = default;
 
 std::unique_ptr<MCObjectWriter>
@@ -97,6 +97,7 @@ MCAssembler::~MCAssembler() = default;
 
 void MCAssembler::reset() {
   Sections.clear();
+  RelaxableSections.clear();
   Symbols.clear();
   IndirectSymbols.clear();
   DataRegions.clear();
@@ -754,6 +755,22 @@ MCAssembler::handleFixup(const MCAsmLayout &Layout, MCFragment &F,
   return std::make_tuple(Target, FixedValue, IsResolved);
 }
 
+/// Return true if the size of \p F may change in layoutSectionOnce.
+static bool mayRelax(const MCFragment &F) {
+  switch (F.getKind()) {
+  case MCFragment::FT_Relaxable:
+  case MCFragment::FT_Dwarf:
+  case MCFragment::FT_DwarfFrame:
+  case MCFragment::FT_LEB:
+  case MCFragment::FT_Padding:
+  case MCFragment::FT_CVInlineLines:
+  case MCFragment::FT_CVDefRange:
+    return true;
+  default:
+    return false;
+  }
+}
+
 void MCAssembler::layout(MCAsmLayout &Layout) {
   assert(getBackendPtr() && "Expected assembler backend");
   DEBUG_WITH_TYPE("mc-dump", {
@@ -771,6 +788,15 @@ void MCAssembler::layout(MCAsmLayout &Layout) {
     Sec.setOrdinal(SectionIndex++);
   }
 
+  // Find the sections that can change size during relaxation, so that
+  // layoutOnce does not rescan the others. With -mrelax-all, which is the
+  // default at -O0, instructions are emitted relaxed into data fragments and
+  // most code sections end up here with nothing to relax.
+  RelaxableSections.clear();
+  for (MCSection &Sec : *this)
+    if (any_of(Sec, [](const MCFragment &F) { return mayRelax(F); }))
+      RelaxableSections.push_back(&Sec);
+
   // Assign layout order indices to sections and fragments.
   for (unsigned i = 0, e = Layout.getSectionOrder().size(); i != e; ++i) {
     MCSection *Sec = Layout.getSectionOrder()[i];
@@ -1109,11 +1135,9 @@ bool MCAssembler::layoutOnce(MCAsmLayout &Layout) {
   ++stats::RelaxationSteps;
 
   bool WasRelaxed = false;
-  for (iterator it = begin(), ie = end(); it != ie; ++it) {
-    MCSection &Sec = *it;
-    while (layoutSectionOnce(Layout, Sec))
+  for (MCSection *Sec : RelaxableSections)
+    while (layoutSectionOnce(Layout, *Sec))
       WasRelaxed = true;
-  }
 
   return WasRelaxed;
 }
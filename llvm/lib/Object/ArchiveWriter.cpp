@@ -12,6 +12,7 @@
 
 #include "llvm/Object/ArchiveWriter.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
 #include "llvm/IR/LLVMContext.h"
@@ -23,6 +24,7 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_ostream.h"
@@ -384,6 +386,15 @@ getSymbols(MemoryBufferRef Buf, raw_ostream &SymNames, bool &HasObject) {
   return Ret;
 }
 
+namespace {
+// The archive symbols of one member. The offsets are relative to Names.
+struct MemberSymbols {
+  std::string Names;
+  Optional<Expected<std::vector<unsigned>>> Offsets;
+  bool HasObject = false;
+};
+} // namespace
+
 static Expected<std::vector<MemberData>>
 computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                   object::Archive::Kind Kind, bool Thin, bool Deterministic,
@@ -452,7 +463,26 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
-  for (const NewArchiveMember &M : NewMembers) {
+  // Reading the symbol table of a member means parsing it as an object file,
+  // which dominates the time spent here for large archives. The members are
+  // independent, so parse them in parallel into per-member buffers, and splice
+  // the results together in member order below.
+  std::vector<MemberSymbols> AllSymbols(NewMembers.size());
+  parallel::for_each_n(parallel::par, size_t(0), NewMembers.size(),
+                       [&](size_t I) {
+                         MemberSymbols &Syms = AllSymbols[I];
+                         raw_string_ostream Names(Syms.Names);
+                         Syms.Offsets.emplace(
+                             getSymbols(NewMembers[I].Buf->getMemBufferRef(),
+                                        Names, Syms.HasObject));
+                       });
+  auto ConsumeSymbolErrors = [&](size_t From) {
+    for (size_t I = From, E = AllSymbols.size(); I != E; ++I)
+      consumeError(AllSymbols[I].Offsets->takeError());
+  };
+
+  for (size_t I = 0, E = NewMembers.size(); I != E; ++I) {
+    const NewArchiveMember &M = NewMembers[I];
     std::string Header;
     raw_string_ostream Out(Header);
 
@@ -479,6 +509,7 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
     if (Size > object::Archive::MaxMemberSize) {
       std::string StringMsg =
           "File " + M.MemberName.str() + " exceeds size limit";
+      ConsumeSymbolErrors(I);
       return make_error<object::GenericBinaryError>(
           std::move(StringMsg), object::object_error::parse_failed);
     }
@@ -487,13 +518,20 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                       ModTime, Size);
     Out.flush();
 
-    Expected<std::vector<unsigned>> Symbols =
-        getSymbols(Buf, SymNames, HasObject);
-    if (auto E = Symbols.takeError())
+    MemberSymbols &Syms = AllSymbols[I];
+    if (Error E = Syms.Offsets->takeError()) {
+      ConsumeSymbolErrors(I + 1);
       return std::move(E);
+    }
+    std::vector<unsigned> Symbols = std::move(**Syms.Offsets);
+    uint64_t NamesOffset = SymNames.tell();
+    for (unsigned &Offset : Symbols)
+      Offset += NamesOffset;
+    SymNames << Syms.Names;
+    HasObject |= Syms.HasObject;
 
     Pos += Header.size() + Data.size() + Padding.size();
-    Ret.push_back({std::move(*Symbols), std::move(Header), Data, Padding});
+    Ret.push_back({std::move(Symbols), std::move(Header), Data, Padding});
   }
   // If there are no symbols, emit an empty symbol table, to satisfy Solaris
   // tools, older versions of which expect a symbol table in a non-empty
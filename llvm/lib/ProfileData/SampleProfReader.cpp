@@ -354,11 +354,14 @@ ErrorOr<StringRef> SampleProfileReaderRawBinary::readStringFromTable() {
 }
 
 ErrorOr<StringRef> SampleProfileReaderCompactBinary::readStringFromTable() {
-  auto Idx = readStringIndex(NameTable);
+  auto Idx = readStringIndex(GUIDTable);
   if (std::error_code EC = Idx.getError())
     return EC;
 
-  return StringRef(NameTable[*Idx]);
+  std::string &Name = NameTable[*Idx];
+  if (Name.empty())
+    Name = std::to_string(GUIDTable[*Idx]);
+  return StringRef(Name);
 }
 
 std::error_code
@@ -469,8 +472,7 @@ std::error_code SampleProfileReaderBinary::read() {
 
 std::error_code SampleProfileReaderCompactBinary::read() {
   for (auto Name : FuncsToUse) {
-    auto GUID = std::to_string(MD5Hash(Name));
-    auto iter = FuncOffsetTable.find(StringRef(GUID));
+    auto iter = FuncOffsetTable.find(MD5Hash(Name));
     if (iter == FuncOffsetTable.end())
       continue;
     const uint8_t *SavedData = Data;
@@ -515,13 +517,16 @@ std::error_code SampleProfileReaderCompactBinary::readNameTable() {
   auto Size = readNumber<uint64_t>();
   if (std::error_code EC = Size.getError())
     return EC;
-  NameTable.reserve(*Size);
+  GUIDTable.reserve(*Size);
   for (uint32_t I = 0; I < *Size; ++I) {
     auto FID = readNumber<uint64_t>();
     if (std::error_code EC = FID.getError())
       return EC;
-    NameTable.push_back(std::to_string(*FID));
+    GUIDTable.push_back(*FID);
   }
+  // Strings are only built on demand by readStringFromTable. The table is
+  // never resized afterwards, so returned StringRefs stay valid.
+  NameTable.resize(GUIDTable.size());
   return sampleprof_error::success;
 }
 
@@ -575,15 +580,17 @@ std::error_code SampleProfileReaderCompactBinary::readFuncOffsetTable() {
 
   FuncOffsetTable.reserve(*Size);
   for (uint32_t I = 0; I < *Size; ++I) {
-    auto FName(readStringFromTable());
-    if (std::error_code EC = FName.getError())
+    // Key the table by GUID rather than going through readStringFromTable,
+    // which would materialize the name of every function in the profile.
+    auto Idx = readStringIndex(GUIDTable);
+    if (std::error_code EC = Idx.getError())
       return EC;
 
     auto Offset = readNumber<uint64_t>();
     if (std::error_code EC = Offset.getError())
       return EC;
 
-    FuncOffsetTable[*FName] = *Offset;
+    FuncOffsetTable[GUIDTable[*Idx]] = *Offset;
   }
   End = TableStart;
   Data = SavedData;
@@ -85,6 +85,49 @@ uint32_t zlib::crc32(StringRef Buffer) {
   return ::crc32(0, (const Bytef *)Buffer.data(), Buffer.size());
 }
 
+Error zlib::compressShard(StringRef InputBuffer,
+                          SmallVectorImpl<char> &CompressedBuffer, bool IsLast,
+                          int Level) {
+  // Negative windowBits tells zlib to produce a raw deflate stream.
+  z_stream S = {};
+  int Res = ::deflateInit2(&S, Level, Z_DEFLATED, -MAX_WBITS, 8,
+                           Z_DEFAULT_STRATEGY);
+  if (Res != Z_OK)
+    return createError(convertZlibCodeToString(Res));
+
+  // deflateBound() doesn't account for the empty stored block that
+  // Z_SYNC_FLUSH emits to align the output to a byte boundary.
+  CompressedBuffer.resize(::deflateBound(&S, InputBuffer.size()) + 8);
+  S.next_in = (Bytef *)InputBuffer.data();
+  S.avail_in = InputBuffer.size();
+  S.next_out = (Bytef *)CompressedBuffer.data();
+  S.avail_out = CompressedBuffer.size();
+
+  // Non-last shards are flushed to a byte boundary without setting the
+  // final block bit so that the next shard can be appended to them.
+  Res = ::deflate(&S, IsLast ? Z_FINISH : Z_SYNC_FLUSH);
+  bool Done = IsLast ? Res == Z_STREAM_END : Res == Z_OK && S.avail_out != 0;
+  size_t CompressedSize = CompressedBuffer.size() - S.avail_out;
+  ::deflateEnd(&S);
+  if (!Done)
+    return createError(convertZlibCodeToString(
+        (Res == Z_OK || Res == Z_STREAM_END) ? Z_BUF_ERROR : Res));
+
+  // Tell MemorySanitizer that zlib output buffer is fully initialized.
+  // This avoids a false report when running LLVM with uninstrumented ZLib.
+  __msan_unpoison(CompressedBuffer.data(), CompressedSize);
+  CompressedBuffer.set_size(CompressedSize);
+  return Error::success();
+}
+
+uint32_t zlib::adler32(uint32_t Adler, StringRef Buffer) {
+  return ::adler32(Adler, (const Bytef *)Buffer.data(), Buffer.size());
+}
+
+uint32_t zlib::adler32Combine(uint32_t Adler1, uint32_t Adler2, size_t Len2) {
+  return ::adler32_combine(Adler1, Adler2, Len2);
+}
+
 #else
 bool zlib::isAvailable() { return false; }
 Error zlib::compress(StringRef InputBuffer,
@@ -103,4 +146,15 @@ Error zlib::uncompress(StringRef InputBuffer,
 uint32_t zlib::crc32(StringRef Buffer) {
   llvm_unreachable("zlib::crc32 is unavailable");
 }
+Error zlib::compressShard(StringRef InputBuffer,
+                          SmallVectorImpl<char> &CompressedBuffer, bool IsLast,
+                          int Level) {
+  llvm_unreachable("zlib::compressShard is unavailable");
+}
+uint32_t zlib::adler32(uint32_t Adler, StringRef Buffer) {
+  llvm_unreachable("zlib::adler32 is unavailable");
+}
+uint32_t zlib::adler32Combine(uint32_t Adler1, uint32_t Adler2, size_t Len2) {
+  llvm_unreachable("zlib::adler32Combine is unavailable");
+}
 #endif
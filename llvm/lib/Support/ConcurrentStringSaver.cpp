@@ -0,0 +1,110 @@
+//===-- ConcurrentStringSaver.cpp -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ConcurrentStringSaver.h"
+#include "llvm/Support/xxhash.h"
+#include <cstring>
+
+using namespace llvm;
+
+ConcurrentUniqueStringSaver::Table *
+ConcurrentUniqueStringSaver::createTable(BumpPtrAllocator &Alloc,
+                                         size_t NumSlots) {
+  assert(isPowerOf2_64(NumSlots));
+  void *Mem = Alloc.Allocate(
+      sizeof(Table) + NumSlots * sizeof(std::atomic<const Entry *>),
+      alignof(Table));
+  Table *T = new (Mem) Table;
+  T->Mask = NumSlots - 1;
+  std::atomic<const Entry *> *Slots = T->getSlots();
+  for (size_t I = 0; I < NumSlots; ++I)
+    new (&Slots[I]) std::atomic<const Entry *>(nullptr);
+  return T;
+}
+
+const ConcurrentUniqueStringSaver::Entry *
+ConcurrentUniqueStringSaver::find(Table *T, uint64_t Hash, StringRef S) {
+  std::atomic<const Entry *> *Slots = T->getSlots();
+  // The low bits picked the shard, use the high bits for the slot.
+  for (size_t I = Hash >> 32, Probe = 1;; I += Probe++) {
+    const Entry *E = Slots[I & T->Mask].load(std::memory_order_acquire);
+    if (!E)
+      return nullptr;
+    if (E->Hash == Hash && E->getKey() == S)
+      return E;
+  }
+}
+
+void ConcurrentUniqueStringSaver::insert(Table *T, const Entry *E) {
+  std::atomic<const Entry *> *Slots = T->getSlots();
+  for (size_t I = E->Hash >> 32, Probe = 1;; I += Probe++) {
+    std::atomic<const Entry *> &Slot = Slots[I & T->Mask];
+    if (!Slot.load(std::memory_order_relaxed)) {
+      // Publishes the entry's contents to lock-free readers.
+      Slot.store(E, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+StringRef ConcurrentUniqueStringSaver::save(StringRef S) {
+  uint64_t Hash = xxh3_64bits(S);
+  Shard &Sh = Shards[Hash & ((1 << NumShardsLog2) - 1)];
+
+  // Fast path: the string is usually already there.
+  if (Table *T = Sh.Tab.load(std::memory_order_acquire))
+    if (const Entry *E = find(T, Hash, S))
+      return E->getKey();
+
+  std::lock_guard<std::mutex> Lock(Sh.Mu);
+  Table *T = Sh.Tab.load(std::memory_order_relaxed);
+  // Another thread may have inserted it since we looked.
+  if (T)
+    if (const Entry *E = find(T, Hash, S))
+      return E->getKey();
+
+  // Keep the load factor at most 3/4. The old table is left in the allocator
+  // because readers may still be probing it.
+  size_t NumSlots = T ? T->Mask + 1 : 0;
+  if ((Sh.NumEntries + 1) * 4 > NumSlots * 3) {
+    Table *NewT = createTable(Sh.Alloc, NumSlots ? NumSlots * 2 : 16);
+    for (size_t I = 0; I < NumSlots; ++I)
+      if (const Entry *E = T->getSlots()[I].load(std::memory_order_relaxed))
+        insert(NewT, E);
+    Sh.Tab.store(NewT, std::memory_order_release);
+    T = NewT;
+  }
+
+  void *Mem = Sh.Alloc.Allocate(sizeof(Entry) + S.size() + 1, alignof(Entry));
+  Entry *E = new (Mem) Entry{Hash, S.size()};
+  char *Data = const_cast<char *>(E->getData());
+  if (!S.empty())
+    memcpy(Data, S.data(), S.size());
+  Data[S.size()] = '\0';
+  insert(T, E);
+  ++Sh.NumEntries;
+  return E->getKey();
+}
+
+size_t ConcurrentUniqueStringSaver::size() const {
+  size_t Size = 0;
+  for (const Shard &Sh : Shards) {
+    std::lock_guard<std::mutex> Lock(Sh.Mu);
+    Size += Sh.NumEntries;
+  }
+  return Size;
+}
+
+size_t ConcurrentUniqueStringSaver::getMemorySize() const {
+  size_t Size = 0;
+  for (const Shard &Sh : Shards) {
+    std::lock_guard<std::mutex> Lock(Sh.Mu);
+    Size += Sh.Alloc.getTotalMemory();
+  }
+  return Size;
+}
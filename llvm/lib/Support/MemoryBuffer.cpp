@@ -17,6 +17,7 @@
 #include "llvm/Support/Errno.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Program.h"
@@ -232,6 +233,51 @@ MemoryBuffer::getFile(const Twine &Filename, int64_t FileSize,
                                   RequiresNullTerminator, IsVolatile);
 }
 
+// Reads one byte from every page of a mapped buffer, so that the kernel
+// reads the file in now, on this thread.
+static void prefetchMappedBuffer(const MemoryBuffer &Buffer) {
+  if (Buffer.getBufferKind() != MemoryBuffer::MemoryBuffer_MMap)
+    return;
+  static const size_t PageSize = sys::Process::getPageSizeEstimate();
+  volatile char Sink = 0;
+  for (const char *P = Buffer.getBufferStart(), *E = Buffer.getBufferEnd();
+       P < E; P += PageSize)
+    Sink += *P;
+  (void)Sink;
+}
+
+SmallVector<ErrorOr<std::unique_ptr<MemoryBuffer>>, 0>
+MemoryBuffer::getFiles(ArrayRef<std::string> Filenames,
+                       bool RequiresNullTerminator, bool IsVolatile) {
+  std::vector<std::unique_ptr<MemoryBuffer>> Buffers(Filenames.size());
+  std::vector<std::error_code> Errors(Filenames.size());
+  auto Load = [&](size_t I) {
+    auto BufOrErr = getFile(Filenames[I], -1, RequiresNullTerminator,
+                            IsVolatile);
+    if (!BufOrErr) {
+      Errors[I] = BufOrErr.getError();
+      return;
+    }
+    prefetchMappedBuffer(**BufOrErr);
+    Buffers[I] = std::move(*BufOrErr);
+  };
+#if LLVM_ENABLE_THREADS
+  parallel::for_each_n(parallel::par, size_t(0), Filenames.size(), Load);
+#else
+  parallel::for_each_n(parallel::seq, size_t(0), Filenames.size(), Load);
+#endif
+
+  SmallVector<ErrorOr<std::unique_ptr<MemoryBuffer>>, 0> Result;
+  Result.reserve(Filenames.size());
+  for (size_t I = 0, E = Filenames.size(); I != E; ++I) {
+    if (Errors[I])
+      Result.emplace_back(Errors[I]);
+    else
+      Result.emplace_back(std::move(Buffers[I]));
+  }
+  return Result;
+}
+
 template <typename MB>
 static ErrorOr<std::unique_ptr<MB>>
 getOpenFileImpl(sys::fs::file_t FD, const Twine &Filename, uint64_t FileSize,
@@ -14,8 +14,9 @@
 #include "llvm/Support/Threading.h"
 
 #include <atomic>
-#include <stack>
+#include <deque>
 #include <thread>
+#include <vector>
 
 namespace llvm {
 namespace parallel {
@@ -29,6 +30,13 @@ public:
   virtual ~Executor() = default;
   virtual void add(std::function<void()> func) = 0;
 
+  /// Blocks until \p L is done. Executors may run other queued tasks on the
+  /// calling thread meanwhile.
+  virtual void runUntilDone(const Latch &L) { L.sync(); }
+
+  /// Called after a task spawned by a TaskGroup has finished.
+  virtual void taskDone() {}
+
   static Executor *getDefaultExecutor();
 };
 
@@ -60,19 +68,29 @@ Executor *Executor::getDefaultExecutor() {
 }
 
 #else
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// The index of the ThreadPoolExecutor worker running on this thread, or -1
+/// for threads that don't belong to the pool.
+static LLVM_THREAD_LOCAL int WorkerIndex = -1;
+
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Each worker owns a deque of tasks. Tasks spawned by a worker go to the back
+/// of its own deque, and the worker takes tasks from the back again (filo
+/// order, which keeps recursive divide-and-conquer depth-first). An idle
+/// worker steals from the front of other workers' deques, where the oldest and
+/// usually largest tasks are. Tasks added by threads outside the pool go to a
+/// shared queue.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(unsigned ThreadCount = hardware_concurrency())
-      : Done(ThreadCount) {
+      : Queues(ThreadCount + 1), Done(ThreadCount) {
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     std::thread([&, ThreadCount] {
       for (size_t i = 1; i < ThreadCount; ++i) {
-        std::thread([=] { work(); }).detach();
+        std::thread([=] { work(i); }).detach();
       }
-      work();
+      work(0);
     }).detach();
   }
 
@@ -85,31 +103,106 @@ public:
   }
 
   void add(std::function<void()> F) override {
-    std::unique_lock<std::mutex> Lock(Mutex);
-    WorkStack.push(F);
-    Lock.unlock();
+    WorkQueue &Q = WorkerIndex < 0 ? Queues.back() : Queues[WorkerIndex];
+    {
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      Q.Tasks.push_back(std::move(F));
+    }
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      ++Pending;
+      if (Helpers)
+        HelperCond.notify_all();
+    }
     Cond.notify_one();
   }
 
+  // Rather than blocking the thread, run queued tasks until L is done. The
+  // tasks L is waiting for may be queued, possibly behind other tasks.
+  void runUntilDone(const Latch &L) override {
+    while (!L.done()) {
+      std::function<void()> Task;
+      if (pop(Task)) {
+        Task();
+        continue;
+      }
+      // Nothing is queued, so the rest of L's tasks are running elsewhere.
+      // Wait for them to finish, or for them to spawn something we can run.
+      std::unique_lock<std::mutex> Lock(Mutex);
+      ++Helpers;
+      HelperCond.wait(Lock, [&] { return Pending > 0 || L.done(); });
+      --Helpers;
+    }
+  }
+
+  void taskDone() override {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (Helpers)
+      HelperCond.notify_all();
+  }
+
 private:
-  void work() {
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<std::function<void()>> Tasks;
+  };
+
+  /// Takes the next task for the calling thread: the newest one from its own
+  /// deque, or else the oldest one from another queue.
+  bool pop(std::function<void()> &Task) {
+    size_t N = Queues.size();
+    size_t Self = WorkerIndex < 0 ? N - 1 : WorkerIndex;
+    {
+      WorkQueue &Q = Queues[Self];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (!Q.Tasks.empty()) {
+        Task = std::move(Q.Tasks.back());
+        Q.Tasks.pop_back();
+        --Pending;
+        return true;
+      }
+    }
+    for (size_t I = 1; I < N; ++I) {
+      WorkQueue &Q = Queues[(Self + I) % N];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (!Q.Tasks.empty()) {
+        Task = std::move(Q.Tasks.front());
+        Q.Tasks.pop_front();
+        --Pending;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void work(int Index) {
+    WorkerIndex = Index;
     while (true) {
+      std::function<void()> Task;
+      if (pop(Task)) {
+        Task();
+        continue;
+      }
       std::unique_lock<std::mutex> Lock(Mutex);
-      Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
+      Cond.wait(Lock, [&] { return Stop || Pending > 0; });
       if (Stop)
         break;
-      auto Task = WorkStack.top();
-      WorkStack.pop();
-      Lock.unlock();
-      Task();
     }
     Done.dec();
   }
 
   std::atomic<bool> Stop{false};
-  std::stack<std::function<void()>> WorkStack;
+  /// The number of queued tasks. It may briefly go negative, as a task can be
+  /// taken between being queued and being counted.
+  std::atomic<int> Pending{0};
+  std::vector<WorkQueue> Queues;
   std::mutex Mutex;
+  /// Idle workers wait on Cond.
   std::condition_variable Cond;
+  /// Threads in runUntilDone() wait on HelperCond, for new tasks or for tasks
+  /// to finish.
+  std::condition_variable HelperCond;
+  unsigned Helpers = 0;
   parallel::detail::Latch Done;
 };
 
@@ -120,6 +213,7 @@ Executor *Executor::getDefaultExecutor() {
 #endif
 }
 
+#if defined(_MSC_VER)
 static std::atomic<int> TaskGroupInstances;
 
 // Latch::sync() called by the dtor may cause one thread to block. If is a dead
@@ -127,14 +221,33 @@ static std::atomic<int> TaskGroupInstances;
 // lock, only allow the first TaskGroup to run tasks parallelly. In the scenario
 // of nested parallel_for_each(), only the outermost one runs parallelly.
 TaskGroup::TaskGroup() : Parallel(TaskGroupInstances++ == 0) {}
-TaskGroup::~TaskGroup() { --TaskGroupInstances; }
+TaskGroup::~TaskGroup() {
+  sync();
+  --TaskGroupInstances;
+}
+
+void TaskGroup::sync() const {
+  Executor::getDefaultExecutor()->runUntilDone(L);
+}
+#else
+// Threads waiting in sync() run queued tasks instead of blocking, so nested
+// task groups can't starve the executor and may all run in parallel.
+TaskGroup::TaskGroup() : Parallel(true) {}
+TaskGroup::~TaskGroup() { sync(); }
+
+void TaskGroup::sync() const {
+  Executor::getDefaultExecutor()->runUntilDone(L);
+}
+#endif
 
 void TaskGroup::spawn(std::function<void()> F) {
   if (Parallel) {
     L.inc();
-    Executor::getDefaultExecutor()->add([&, F] {
+    Executor *E = Executor::getDefaultExecutor();
+    E->add([&, E, F] {
       F();
       L.dec();
+      E->taskDone();
     });
   } else {
     F();
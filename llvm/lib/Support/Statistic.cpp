@@ -32,6 +32,8 @@
 #include "llvm/Support/YAMLTraits.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <chrono>
+#include <cinttypes>
 #include <cstring>
 using namespace llvm;
 
@@ -51,6 +53,16 @@ static bool Enabled;
 static bool PrintOnExit;
 
 namespace {
+/// The number of AlwaysOnStatistics that get a slot in each thread's counters.
+/// Any beyond that share an atomic counter instead.
+constexpr unsigned MaxAlwaysOnStatistics = 256;
+
+/// The values of all AlwaysOnStatistics for one thread. Only that thread
+/// writes them, anyone holding StatLock may read them.
+struct ThreadCounters {
+  std::atomic<uint64_t> Values[MaxAlwaysOnStatistics];
+};
+
 /// This class is used in a ManagedStatic so that it is created on demand (when
 /// the first statistic is bumped) and destroyed only when llvm_shutdown is
 /// called. We print statistics from the destructor.
@@ -58,6 +70,13 @@ namespace {
 /// use LLVM.
 class StatisticInfo {
   std::vector<Statistic*> Stats;
+  /// Indexed by AlwaysOnStatistic::Slot. These stay registered across
+  /// reset(), so that their slots are never reused.
+  std::vector<AlwaysOnStatistic *> AlwaysOnStats;
+  /// The counters of every thread that has updated an AlwaysOnStatistic.
+  /// There is no portable hook to run when a thread exits, so they are kept
+  /// until shutdown. LLVM's threads are mostly long-lived pool threads.
+  std::vector<std::unique_ptr<ThreadCounters>> Threads;
 
   friend void llvm::PrintStatistics();
   friend void llvm::PrintStatistics(raw_ostream &OS);
@@ -75,6 +94,25 @@ public:
     Stats.push_back(S);
   }
 
+  /// Returns the slot assigned to S.
+  int addAlwaysOnStatistic(AlwaysOnStatistic *S) {
+    AlwaysOnStats.push_back(S);
+    return AlwaysOnStats.size() - 1;
+  }
+
+  ThreadCounters *addThread() {
+    Threads.push_back(llvm::make_unique<ThreadCounters>());
+    return Threads.back().get();
+  }
+
+  /// Returns the value of S including the base that reset() subtracts.
+  uint64_t getTotal(const AlwaysOnStatistic &S) const;
+
+  /// Returns the always-on statistics that were updated since the last
+  /// reset(), sorted like sort() sorts Stats, with their values.
+  std::vector<std::pair<const AlwaysOnStatistic *, uint64_t>>
+  getAlwaysOnValues() const;
+
   const_iterator begin() const { return Stats.begin(); }
   const_iterator end() const { return Stats.end(); }
   iterator_range<const_iterator> statistics() const {
@@ -114,6 +152,81 @@ void Statistic::RegisterStatistic() {
   }
 }
 
+static LLVM_THREAD_LOCAL ThreadCounters *CurrentThreadCounters = nullptr;
+
+int AlwaysOnStatistic::registerStatistic() {
+  // See Statistic::RegisterStatistic for the lock order.
+  sys::SmartMutex<true> &Lock = *StatLock;
+  StatisticInfo &SI = *StatInfo;
+  sys::SmartScopedLock<true> Writer(Lock);
+  int S = Slot.load(std::memory_order_relaxed);
+  if (S < 0) {
+    S = SI.addAlwaysOnStatistic(this);
+    Slot.store(S, std::memory_order_relaxed);
+  }
+  return S;
+}
+
+uint64_t AlwaysOnStatistic::addToThreadValue(uint64_t V) {
+  int S = Slot.load(std::memory_order_relaxed);
+  if (LLVM_UNLIKELY(S < 0))
+    S = registerStatistic();
+  if (LLVM_UNLIKELY(S >= int(MaxAlwaysOnStatistics)))
+    return Overflow.fetch_add(V, std::memory_order_relaxed) + V;
+
+  ThreadCounters *TC = CurrentThreadCounters;
+  if (LLVM_UNLIKELY(!TC)) {
+    sys::SmartMutex<true> &Lock = *StatLock;
+    StatisticInfo &SI = *StatInfo;
+    sys::SmartScopedLock<true> Writer(Lock);
+    TC = CurrentThreadCounters = SI.addThread();
+  }
+  // This thread is the only writer, so this needs no read-modify-write.
+  std::atomic<uint64_t> &Value = TC->Values[S];
+  uint64_t NewValue = Value.load(std::memory_order_relaxed) + V;
+  Value.store(NewValue, std::memory_order_relaxed);
+  return NewValue;
+}
+
+uint64_t StatisticInfo::getTotal(const AlwaysOnStatistic &S) const {
+  int Slot = S.Slot.load(std::memory_order_relaxed);
+  uint64_t Total = S.Overflow.load(std::memory_order_relaxed);
+  if (Slot >= 0 && Slot < int(MaxAlwaysOnStatistics))
+    for (const auto &TC : Threads)
+      Total += TC->Values[Slot].load(std::memory_order_relaxed);
+  return Total;
+}
+
+std::vector<std::pair<const AlwaysOnStatistic *, uint64_t>>
+StatisticInfo::getAlwaysOnValues() const {
+  using Entry = std::pair<const AlwaysOnStatistic *, uint64_t>;
+  std::vector<Entry> Values;
+  for (const AlwaysOnStatistic *S : AlwaysOnStats)
+    if (uint64_t V = getTotal(*S) - S->Base.load(std::memory_order_relaxed))
+      Values.emplace_back(S, V);
+  llvm::sort(Values, [](const Entry &L, const Entry &R) {
+    if (int Cmp = std::strcmp(L.first->DebugType, R.first->DebugType))
+      return Cmp < 0;
+    if (int Cmp = std::strcmp(L.first->Name, R.first->Name))
+      return Cmp < 0;
+    return std::strcmp(L.first->Desc, R.first->Desc) < 0;
+  });
+  return Values;
+}
+
+uint64_t AlwaysOnStatistic::getValue() const {
+  sys::SmartMutex<true> &Lock = *StatLock;
+  StatisticInfo &SI = *StatInfo;
+  sys::SmartScopedLock<true> Reader(Lock);
+  return SI.getTotal(*this) - Base.load(std::memory_order_relaxed);
+}
+
+uint64_t SampledScopedTimer::now() {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
 StatisticInfo::StatisticInfo() {
   // Ensure timergroup lists are created first so they are destructed after us.
   TimerGroup::ConstructTimerLists();
@@ -160,6 +273,11 @@ void StatisticInfo::reset() {
     Stat->Value = 0;
   }
 
+  // Per-thread counters can only be written by their own thread, so rebase
+  // the always-on statistics instead of zeroing them.
+  for (AlwaysOnStatistic *Stat : AlwaysOnStats)
+    Stat->Base = getTotal(*Stat);
+
   // Clear the registration list and release the lock once we're done. Any
   // pending updates from other threads will safely take effect after we return.
   // That might not be what the user wants if they're measuring a compilation
@@ -179,6 +297,13 @@ void llvm::PrintStatistics(raw_ostream &OS) {
     MaxDebugTypeLen = std::max(MaxDebugTypeLen,
                          (unsigned)std::strlen(Stats.Stats[i]->getDebugType()));
   }
+  std::vector<std::pair<const AlwaysOnStatistic *, uint64_t>> AlwaysOn =
+      Stats.getAlwaysOnValues();
+  for (const auto &Stat : AlwaysOn) {
+    MaxValLen = std::max(MaxValLen, (unsigned)utostr(Stat.second).size());
+    MaxDebugTypeLen = std::max(MaxDebugTypeLen,
+                               (unsigned)std::strlen(Stat.first->DebugType));
+  }
 
   Stats.sort();
 
@@ -193,6 +318,9 @@ void llvm::PrintStatistics(raw_ostream &OS) {
                  MaxValLen, Stats.Stats[i]->getValue(),
                  MaxDebugTypeLen, Stats.Stats[i]->getDebugType(),
                  Stats.Stats[i]->getDesc());
+  for (const auto &Stat : AlwaysOn)
+    OS << format("%*" PRIu64 " %-*s - %s\n", MaxValLen, Stat.second,
+                 MaxDebugTypeLen, Stat.first->DebugType, Stat.first->Desc);
 
   OS << '\n';  // Flush the output stream.
   OS.flush();
@@ -217,6 +345,17 @@ void llvm::PrintStatisticsJSON(raw_ostream &OS) {
        << Stat->getValue();
     delim = ",\n";
   }
+  for (const auto &Stat : Stats.getAlwaysOnValues()) {
+    OS << delim;
+    assert(yaml::needsQuotes(Stat.first->DebugType) ==
+               yaml::QuotingType::None &&
+           "Statistic group/type name is simple.");
+    assert(yaml::needsQuotes(Stat.first->Name) == yaml::QuotingType::None &&
+           "Statistic name is simple");
+    OS << "\t\"" << Stat.first->DebugType << '.' << Stat.first->Name
+       << "\": " << Stat.second;
+    delim = ",\n";
+  }
   // Print timers.
   TimerGroup::printAllJSONValues(OS, delim);
 
@@ -225,12 +364,11 @@ void llvm::PrintStatisticsJSON(raw_ostream &OS) {
 }
 
 void llvm::PrintStatistics() {
-#if LLVM_ENABLE_STATS
   sys::SmartScopedLock<true> Reader(*StatLock);
   StatisticInfo &Stats = *StatInfo;
-
+#if LLVM_ENABLE_STATS
   // Statistics not enabled?
-  if (Stats.Stats.empty()) return;
+  if (Stats.Stats.empty() && Stats.AlwaysOnStats.empty()) return;
 
   // Get the stream to write to.
   std::unique_ptr<raw_ostream> OutStream = CreateInfoOutputFile();
@@ -242,12 +380,17 @@ void llvm::PrintStatistics() {
 #else
   // Check if the -stats option is set instead of checking
   // !Stats.Stats.empty().  In release builds, Statistics operators
-  // do nothing, so stats are never Registered.
-  if (Stats) {
+  // do nothing, so stats are never Registered. AlwaysOnStatistics still are.
+  if (::Stats) {
     // Get the stream to write to.
     std::unique_ptr<raw_ostream> OutStream = CreateInfoOutputFile();
-    (*OutStream) << "Statistics are disabled.  "
-                 << "Build with asserts or with -DLLVM_ENABLE_STATS\n";
+    if (StatsAsJSON)
+      PrintStatisticsJSON(*OutStream);
+    else if (!Stats.AlwaysOnStats.empty())
+      PrintStatistics(*OutStream);
+    else
+      (*OutStream) << "Statistics are disabled.  "
+                   << "Build with asserts or with -DLLVM_ENABLE_STATS\n";
   }
 #endif
 }
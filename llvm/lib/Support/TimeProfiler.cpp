@@ -36,6 +36,8 @@ struct Entry {
   DurationType Duration;
   std::string Name;
   std::string Detail;
+  /// The detail without template arguments; only set when summarizing.
+  std::string SummaryKey;
 
   Entry(time_point<steady_clock> &&S, DurationType &&D, std::string &&N,
         std::string &&Dt)
@@ -43,6 +45,42 @@ struct Entry {
         Detail(std::move(Dt)){};
 };
 
+std::string timeTraceSummaryKey(StringRef Detail) {
+  std::string Key;
+  Key.reserve(Detail.size());
+  unsigned Depth = 0;
+  for (size_t I = 0, E = Detail.size(); I != E; ++I) {
+    char C = Detail[I];
+    // Operator names contain angle brackets that don't open a template
+    // argument list; copy them through verbatim.
+    if (Depth == 0 && StringRef(Key).endswith("operator")) {
+      StringRef Rest = Detail.substr(I);
+      for (StringRef Op : {"<=>", "<<=", ">>=", "->*", "<<", ">>", "<=", ">=",
+                           "->", "<", ">"}) {
+        if (Rest.startswith(Op)) {
+          Key += Op;
+          I += Op.size() - 1;
+          C = 0;
+          break;
+        }
+      }
+      if (!C)
+        continue;
+    }
+    if (C == '<') {
+      ++Depth;
+      continue;
+    }
+    if (C == '>' && Depth) {
+      --Depth;
+      continue;
+    }
+    if (!Depth)
+      Key += C;
+  }
+  return Key;
+}
+
 struct TimeTraceProfiler {
   TimeTraceProfiler() {
     StartTime = steady_clock::now();
@@ -51,6 +89,8 @@ struct TimeTraceProfiler {
   void begin(std::string Name, llvm::function_ref<std::string()> Detail) {
     Stack.emplace_back(steady_clock::now(), DurationType{}, std::move(Name),
                        Detail());
+    if (SummaryLimit)
+      Stack.back().SummaryKey = timeTraceSummaryKey(Stack.back().Detail);
   }
 
   void end() {
@@ -59,9 +99,21 @@ struct TimeTraceProfiler {
     E.Duration = steady_clock::now() - E.Start;
 
     // Only include sections longer than TimeTraceGranularity msec.
-    if (duration_cast<microseconds>(E.Duration).count() > TimeTraceGranularity)
+    if (!SummaryOnly &&
+        duration_cast<microseconds>(E.Duration).count() > TimeTraceGranularity)
       Entries.emplace_back(E);
 
+    // Summaries include every section regardless of the granularity, again
+    // only counting the topmost one for each key.
+    if (SummaryLimit && !E.SummaryKey.empty() &&
+        std::find_if(++Stack.rbegin(), Stack.rend(), [&](const Entry &Val) {
+          return Val.Name == E.Name && Val.SummaryKey == E.SummaryKey;
+        }) == Stack.rend()) {
+      auto &CountAndTotal = SummaryPerName[E.Name][E.SummaryKey];
+      CountAndTotal.first++;
+      CountAndTotal.second += E.Duration;
+    }
+
     // Track total time taken by each "name", but only the topmost levels of
     // them; e.g. if there's a template instantiation that instantiates other
     // templates from within, we only want to add the topmost one. "topmost"
@@ -135,6 +187,50 @@ struct TimeTraceProfiler {
       ++Tid;
     }
 
+    // Emit the most expensive summary keys for each name, laid out one after
+    // the other on a "thread" of their own, sorted from longest one.
+    std::vector<StringRef> SummaryNames;
+    for (const auto &E : SummaryPerName)
+      SummaryNames.push_back(E.getKey());
+    llvm::sort(SummaryNames);
+    for (StringRef Name : SummaryNames) {
+      std::vector<NameAndCountAndDurationType> SortedKeys;
+      for (const auto &E : SummaryPerName[Name])
+        SortedKeys.emplace_back(E.getKey(), E.getValue());
+      llvm::sort(SortedKeys.begin(), SortedKeys.end(),
+                 [](const NameAndCountAndDurationType &A,
+                    const NameAndCountAndDurationType &B) {
+                   if (A.second.second != B.second.second)
+                     return A.second.second > B.second.second;
+                   return A.first < B.first;
+                 });
+      if (SortedKeys.size() > SummaryLimit)
+        SortedKeys.resize(SummaryLimit);
+
+      int64_t StartUs = 0;
+      for (const auto &E : SortedKeys) {
+        auto DurUs = duration_cast<microseconds>(E.second.second).count();
+        auto Count = E.second.first;
+
+        J.object([&] {
+          J.attribute("pid", 1);
+          J.attribute("tid", Tid);
+          J.attribute("ph", "X");
+          J.attribute("ts", StartUs);
+          J.attribute("dur", DurUs);
+          J.attribute("name", "Summary " + Name.str());
+          J.attributeObject("args", [&] {
+            J.attribute("detail", E.first);
+            J.attribute("count", int64_t(Count));
+            J.attribute("avg ms", int64_t(DurUs / Count / 1000));
+          });
+        });
+        StartUs += DurUs;
+      }
+
+      ++Tid;
+    }
+
     // Emit metadata event with process name.
     J.object([&] {
       J.attribute("cat", "");
@@ -154,17 +250,27 @@ struct TimeTraceProfiler {
   SmallVector<Entry, 16> Stack;
   SmallVector<Entry, 128> Entries;
   StringMap<CountAndDurationType> CountAndTotalPerName;
+  StringMap<StringMap<CountAndDurationType>> SummaryPerName;
   time_point<steady_clock> StartTime;
 
   // Minimum time granularity (in microseconds)
   unsigned TimeTraceGranularity;
+
+  // Number of summary keys written per name; zero disables summaries.
+  unsigned SummaryLimit = 0;
+
+  // Whether to leave out the individual sections.
+  bool SummaryOnly = false;
 };
 
-void timeTraceProfilerInitialize(unsigned TimeTraceGranularity) {
+void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
+                                 unsigned SummaryLimit, bool SummaryOnly) {
   assert(TimeTraceProfilerInstance == nullptr &&
          "Profiler should not be initialized");
   TimeTraceProfilerInstance = new TimeTraceProfiler();
   TimeTraceProfilerInstance->TimeTraceGranularity = TimeTraceGranularity;
+  TimeTraceProfilerInstance->SummaryLimit = SummaryLimit;
+  TimeTraceProfilerInstance->SummaryOnly = SummaryOnly;
 }
 
 void timeTraceProfilerCleanup() {
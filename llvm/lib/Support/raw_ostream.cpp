@@ -889,6 +889,56 @@ void raw_svector_ostream::pwrite_impl(const char *Ptr, size_t Size,
   memcpy(OS.data() + Offset, Ptr, Size);
 }
 
+//===----------------------------------------------------------------------===//
+//  raw_region_ostream
+//===----------------------------------------------------------------------===//
+
+raw_region_ostream::raw_region_ostream(MutableArrayRef<uint8_t> Region)
+    : Region(Region) {
+  if (Region.empty())
+    SetUnbuffered();
+  else
+    SetBuffer(reinterpret_cast<char *>(Region.data()), Region.size());
+}
+
+raw_region_ostream::~raw_region_ostream() { flush(); }
+
+void raw_region_ostream::write_impl(const char *Ptr, size_t Size) {
+  if (Pos < Region.size()) {
+    // When flushing, Ptr is the buffer, which is already in place.
+    char *Dest = reinterpret_cast<char *>(Region.data()) + Pos;
+    size_t N = std::min(Size, Region.size() - Pos);
+    if (Ptr != Dest)
+      memcpy(Dest, Ptr, N);
+    Pos += N;
+    Ptr += N;
+    Size -= N;
+
+    // Point the buffer at the unused rest of the region. Once it's full,
+    // fall back to appending to Overflow directly, like raw_svector_ostream.
+    if (Pos < Region.size())
+      SetBuffer(Dest + N, Region.size() - Pos);
+    else
+      SetUnbuffered();
+  }
+  Overflow.append(Ptr, Ptr + Size);
+}
+
+void raw_region_ostream::pwrite_impl(const char *Ptr, size_t Size,
+                                     uint64_t Offset) {
+  // Bytes still in the buffer are already in the region, so the region can be
+  // patched without flushing.
+  if (Offset < Region.size()) {
+    size_t N = std::min<uint64_t>(Size, Region.size() - Offset);
+    memcpy(Region.data() + Offset, Ptr, N);
+    Ptr += N;
+    Size -= N;
+    Offset += N;
+  }
+  if (Size)
+    memcpy(Overflow.data() + (Offset - Region.size()), Ptr, Size);
+}
+
 //===----------------------------------------------------------------------===//
 //  raw_null_ostream
 //===----------------------------------------------------------------------===//
@@ -16,13 +16,29 @@
 #include "SIInstrInfo.h"
 #include "SIMachineFunctionInfo.h"
 #include "SIRegisterInfo.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/RegisterClassInfo.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MathExtras.h"
 
 #define DEBUG_TYPE "machine-scheduler"
 
 using namespace llvm;
 
+STATISTIC(NumRegionsNotRescheduled,
+          "Number of regions kept from the first scheduling pass");
+
+static cl::opt<bool> SingleSchedulingPass(
+    "amdgpu-sched-single-pass", cl::Hidden, cl::init(false),
+    cl::desc("Schedule each region once, even if the function occupancy "
+             "dropped while scheduling"));
+
+static cl::opt<unsigned> MaxRescheduledInstrs(
+    "amdgpu-sched-max-rescheduled-instrs", cl::Hidden, cl::init(0),
+    cl::desc("Maximum number of instructions scheduled again at the lowered "
+             "occupancy; the remaining regions keep their first schedule "
+             "(0 = no limit)"));
+
 GCNMaxOccupancySchedStrategy::GCNMaxOccupancySchedStrategy(
     const MachineSchedContext *C) :
     GenericScheduler(C), TargetOccupancy(0), MF(nullptr) { }
@@ -508,6 +524,7 @@ void GCNScheduleDAGMILive::finalizeSchedule() {
   if (!Regions.empty())
     BBLiveInMap = getBBLiveInMap();
 
+  unsigned NumRescheduledInstrs = 0;
   do {
     Stage++;
     RegionIdx = 0;
@@ -519,7 +536,7 @@ void GCNScheduleDAGMILive::finalizeSchedule() {
       // to schedule low register pressure blocks.
       // Code is partially copied from MachineSchedulerBase::scheduleRegions().
 
-      if (!LIS || StartingOccupancy <= MinOccupancy)
+      if (!LIS || StartingOccupancy <= MinOccupancy || SingleSchedulingPass)
         break;
 
       LLVM_DEBUG(
@@ -551,6 +568,18 @@ void GCNScheduleDAGMILive::finalizeSchedule() {
         continue;
       }
 
+      // Out of budget for the second pass: keep the first schedule, which
+      // already meets the lowered occupancy.
+      if (Stage > 1 && MaxRescheduledInstrs &&
+          NumRescheduledInstrs + NumRegionInstrs > MaxRescheduledInstrs) {
+        ++NumRegionsNotRescheduled;
+        exitRegion();
+        ++RegionIdx;
+        continue;
+      }
+      if (Stage > 1)
+        NumRescheduledInstrs += NumRegionInstrs;
+
       LLVM_DEBUG(dbgs() << "********** MI Scheduling **********\n");
       LLVM_DEBUG(dbgs() << MF.getName() << ":" << printMBBReference(*MBB) << " "
                         << MBB->getName() << "\n  From: " << *begin()
@@ -44,6 +44,12 @@ static cl::opt<bool>
                                cl::desc("Disable load/store vectorizer"),
                                cl::init(false), cl::Hidden);
 
+static cl::opt<bool> EnableLateLoadStoreVectorizer(
+    "nvptx-late-load-store-vectorizer",
+    cl::desc("Run the load/store vectorizer again after the straight-line "
+             "scalar optimizations and LSR"),
+    cl::init(false), cl::Hidden);
+
 // TODO: Remove this flag when we are confident with no regressions.
 static cl::opt<bool> DisableRequireStructuredCFG(
     "disable-nvptx-require-structured-cfg",
@@ -295,8 +301,14 @@ void NVPTXPassConfig::addIRPasses() {
   //   %1 = shl %a, 2
   //
   // but EarlyCSE can do neither of them.
-  if (getOptLevel() != CodeGenOpt::None)
+  if (getOptLevel() != CodeGenOpt::None) {
     addEarlyCSEOrGVNPass();
+    // SeparateConstOffsetFromGEP, SLSR and LSR rewrite addresses as a common
+    // base plus constant offsets, which exposes adjacent accesses that the
+    // first vectorizer run could not see.
+    if (!DisableLoadStoreVectorizer && EnableLateLoadStoreVectorizer)
+      addPass(createLoadStoreVectorizerPass());
+  }
 }
 
 bool NVPTXPassConfig::addInstSelector() {
@@ -75,6 +75,11 @@ public:
   const SelectionDAGTargetInfo *getSelectionDAGInfo() const override {
     return &TSInfo;
   }
+  // Only use the machine scheduler for CPUs with a real scheduling model; the
+  // generic CPUs keep the SelectionDAG source order.
+  bool enableMachineScheduler() const override {
+    return getSchedModel().hasInstrSchedModel();
+  }
   bool hasStdExtM() const { return HasStdExtM; }
   bool hasStdExtA() const { return HasStdExtA; }
   bool hasStdExtF() const { return HasStdExtF; }
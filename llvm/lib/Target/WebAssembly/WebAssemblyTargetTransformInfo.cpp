@@ -80,3 +80,27 @@ unsigned WebAssemblyTTIImpl::getVectorInstrCost(unsigned Opcode, Type *Val,
 
   return Cost;
 }
+
+unsigned WebAssemblyTTIImpl::getShuffleCost(TTI::ShuffleKind Kind, Type *Tp,
+                                            int Index, Type *SubTp) {
+  // v8x16.shuffle takes two vectors and an arbitrary constant byte mask, so
+  // every whole-vector permutation is a single instruction once legalized.
+  // The base implementation prices them as per-element extracts and inserts.
+  switch (Kind) {
+  case TTI::SK_Broadcast:
+  case TTI::SK_Reverse:
+  case TTI::SK_Select:
+  case TTI::SK_Transpose:
+  case TTI::SK_PermuteSingleSrc:
+  case TTI::SK_PermuteTwoSrc:
+    if (getST()->hasSIMD128()) {
+      std::pair<int, MVT> LT = TLI->getTypeLegalizationCost(DL, Tp);
+      if (LT.second.is128BitVector())
+        return LT.first * TargetTransformInfo::TCC_Basic;
+    }
+    break;
+  default:
+    break;
+  }
+  return BasicTTIImplBase::getShuffleCost(Kind, Tp, Index, SubTp);
+}
@@ -12,20 +12,31 @@
 #include "llvm/BinaryFormat/ELF.h"
 #include "llvm/BinaryFormat/MachO.h"
 #include "llvm/MC/MCAsmBackend.h"
+#include "llvm/MC/MCAssembler.h"
+#include "llvm/MC/MCCodePadder.h"
 #include "llvm/MC/MCDwarf.h"
 #include "llvm/MC/MCELFObjectWriter.h"
 #include "llvm/MC/MCExpr.h"
 #include "llvm/MC/MCFixupKindInfo.h"
 #include "llvm/MC/MCInst.h"
+#include "llvm/MC/MCInstrInfo.h"
 #include "llvm/MC/MCMachObjectWriter.h"
+#include "llvm/MC/MCObjectStreamer.h"
 #include "llvm/MC/MCObjectWriter.h"
 #include "llvm/MC/MCRegisterInfo.h"
 #include "llvm/MC/MCSectionMachO.h"
 #include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/raw_ostream.h"
 using namespace llvm;
 
+static cl::opt<bool> AlignBranchBoundary(
+    "x86-align-branch-boundary", cl::Hidden, cl::init(false),
+    cl::desc("Pad jumps, calls and returns with nops so that none of them "
+             "crosses or ends at a 32-byte boundary (Intel JCC erratum)"));
+
 static unsigned getFixupKindSize(unsigned Kind) {
   switch (Kind) {
   default:
@@ -69,11 +80,81 @@ public:
     : MCELFObjectTargetWriter(is64Bit, OSABI, EMachine, HasRelocationAddend) {}
 };
 
+/// Penalizes branches that cross or end at a 32-byte boundary. On Skylake
+/// derived cores with the JCC erratum microcode update, such branches are not
+/// cached in the decoded ICache and run from the legacy decoders.
+class X86BranchBoundaryPolicy : public MCCodePaddingPolicy {
+public:
+  static const uint64_t Kind =
+      MCPaddingFragment::FirstTargetPerfNopFragmentKind;
+  static const uint64_t BoundarySize = 32;
+
+  X86BranchBoundaryPolicy(const MCInstrInfo &MCII)
+      : MCCodePaddingPolicy(Kind, BoundarySize, false), MCII(MCII) {}
+
+  bool instructionRequiresPaddingFragment(const MCInst &Inst) const override {
+    return isBranch(MCII, Inst);
+  }
+
+  static bool isBranch(const MCInstrInfo &MCII, const MCInst &Inst) {
+    const MCInstrDesc &Desc = MCII.get(Inst.getOpcode());
+    return Desc.isBranch() || Desc.isCall() || Desc.isReturn();
+  }
+
+protected:
+  double computeWindowPenaltyWeight(const MCPFRange &Window, uint64_t Offset,
+                                    MCAsmLayout &Layout) const override {
+    double Weight = 0.0;
+    for (const MCPaddingFragment *Fragment : Window) {
+      uint64_t Start = getNextFragmentOffset(Fragment, Layout) + Offset;
+      uint64_t End = Start + Fragment->getInstSize();
+      if (Start / BoundarySize != End / BoundarySize)
+        Weight += 1.0;
+    }
+    return Weight;
+  }
+
+private:
+  const MCInstrInfo &MCII;
+};
+
+/// Puts a padding insertion point in front of every branch, call and return,
+/// so that X86BranchBoundaryPolicy can push it past the next boundary.
+class X86CodePadder : public MCCodePadder {
+  std::unique_ptr<const MCInstrInfo> MCII;
+  bool IsPaddingActive = false;
+
+public:
+  X86CodePadder(const Target &T) : MCII(T.createMCInstrInfo()) {
+    addPolicy(new X86BranchBoundaryPolicy(*MCII));
+  }
+
+protected:
+  bool usePoliciesForBasicBlock(const MCCodePaddingContext &Context) override {
+    IsPaddingActive = Context.IsPaddingActive;
+    return IsPaddingActive;
+  }
+
+  bool instructionRequiresInsertionPoint(const MCInst &Inst) override {
+    // Padding right after an alignment fragment would undo the alignment,
+    // and bundles are laid out by their own rules.
+    return IsPaddingActive && !OS->getAssembler().isBundlingEnabled() &&
+           OS->getCurrentFragment()->getKind() != MCFragment::FT_Align &&
+           X86BranchBoundaryPolicy::isBranch(*MCII, Inst);
+  }
+};
+
+static std::unique_ptr<MCCodePadder> createX86CodePadder(const Target &T) {
+  if (AlignBranchBoundary)
+    return llvm::make_unique<X86CodePadder>(T);
+  return llvm::make_unique<MCCodePadder>();
+}
+
 class X86AsmBackend : public MCAsmBackend {
   const MCSubtargetInfo &STI;
 public:
   X86AsmBackend(const Target &T, const MCSubtargetInfo &STI)
-      : MCAsmBackend(support::little), STI(STI) {}
+      : MCAsmBackend(support::little, createX86CodePadder(T)), STI(STI) {}
 
   unsigned getNumFixupKinds() const override {
     return X86::NumTargetFixupKinds;
@@ -129,6 +129,10 @@ InstructionSelector *createX86InstructionSelector(const X86TargetMachine &TM,
 
 FunctionPass *createX86SpeculativeLoadHardeningPass();
 
+/// This pass uses profile data to choose between 256-bit and 512-bit
+/// preferred vector widths per function, ahead of the vectorizers.
+FunctionPass *createX86VectorWidthPreferencePass(const X86TargetMachine &TM);
+
 void initializeEvexToVexInstPassPass(PassRegistry &);
 void initializeFixupBWInstPassPass(PassRegistry &);
 void initializeFixupLEAPassPass(PassRegistry &);
@@ -143,6 +147,7 @@ void initializeX86DomainReassignmentPass(PassRegistry &);
 void initializeX86ExecutionDomainFixPass(PassRegistry &);
 void initializeX86FlagsCopyLoweringPassPass(PassRegistry &);
 void initializeX86SpeculativeLoadHardeningPassPass(PassRegistry &);
+void initializeX86VectorWidthPreferencePass(PassRegistry &);
 
 } // End llvm namespace
 
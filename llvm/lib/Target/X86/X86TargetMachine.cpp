@@ -38,6 +38,7 @@
 #include "llvm/IR/Attributes.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/LegacyPassManager.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/CodeGen.h"
@@ -46,6 +47,7 @@
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Target/TargetLoweringObjectFile.h"
 #include "llvm/Target/TargetOptions.h"
+#include "llvm/Transforms/IPO/PassManagerBuilder.h"
 #include <memory>
 #include <string>
 
@@ -60,6 +62,11 @@ static cl::opt<bool> EnableCondBrFoldingPass("x86-condbr-folding",
                                         "folding pass"),
                                cl::init(false), cl::Hidden);
 
+static cl::opt<bool> ProfileGuidedVectorWidth(
+    "x86-profile-guided-vector-width", cl::Hidden, cl::init(false),
+    cl::desc("Use profile data to prefer 512-bit vectors in functions "
+             "dominated by long-running loops"));
+
 extern "C" void LLVMInitializeX86Target() {
   // Register the target.
   RegisterTargetMachine<X86TargetMachine> X(getTheX86_32Target());
@@ -81,6 +88,7 @@ extern "C" void LLVMInitializeX86Target() {
   initializeX86SpeculativeLoadHardeningPassPass(PR);
   initializeX86FlagsCopyLoweringPassPass(PR);
   initializeX86CondBrFoldingPassPass(PR);
+  initializeX86VectorWidthPreferencePass(PR);
 }
 
 static std::unique_ptr<TargetLoweringObjectFile> createTLOF(const Triple &TT) {
@@ -336,6 +344,16 @@ X86TargetMachine::getTargetTransformInfo(const Function &F) {
   return TargetTransformInfo(X86TTIImpl(this, F));
 }
 
+void X86TargetMachine::adjustPassManager(PassManagerBuilder &PMB) {
+  if (!ProfileGuidedVectorWidth)
+    return;
+  PMB.addExtension(
+      PassManagerBuilder::EP_VectorizerStart,
+      [&](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+        PM.add(createX86VectorWidthPreferencePass(*this));
+      });
+}
+
 //===----------------------------------------------------------------------===//
 // Pass Pipeline Configuration
 //===----------------------------------------------------------------------===//
@@ -46,6 +46,8 @@ public:
 
   TargetTransformInfo getTargetTransformInfo(const Function &F) override;
 
+  void adjustPassManager(PassManagerBuilder &PMB) override;
+
   // Set up the pass pipeline.
   TargetPassConfig *createPassConfig(PassManagerBase &PM) override;
 
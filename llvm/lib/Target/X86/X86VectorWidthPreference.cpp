@@ -0,0 +1,176 @@
+//===-- X86VectorWidthPreference.cpp - Profile-guided vector width --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// On AVX-512 targets that prefer 256-bit vectors, 512-bit instructions win on
+// throughput only when they run long enough to amortize the frequency drop
+// they cause. This pass uses the profile to pick the preferred vector width
+// per function before the vectorizers run: hot functions whose profiled work
+// is dominated by long-running loops get "prefer-vector-width"="512", the
+// others keep the subtarget's default.
+//
+//===----------------------------------------------------------------------===//
+
+#include "X86.h"
+#include "X86Subtarget.h"
+#include "X86TargetMachine.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
+#include "llvm/CodeGen/TargetPassConfig.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "x86-vector-width"
+
+static cl::opt<unsigned> MinLoopTripCount(
+    "x86-vector-width-min-trip-count", cl::Hidden, cl::init(128),
+    cl::desc("The estimated trip count from which an innermost loop counts "
+             "as long-running when choosing the preferred vector width"));
+
+static cl::opt<unsigned> MinLoopWeightPercent(
+    "x86-vector-width-min-loop-weight", cl::Hidden, cl::init(80),
+    cl::desc("The share of a function's profiled instruction count that must "
+             "be in long-running loops for it to prefer 512-bit vectors"));
+
+namespace {
+
+class X86VectorWidthPreference : public FunctionPass {
+  const X86TargetMachine *TM;
+
+public:
+  static char ID; // Pass identification, replacement for typeid.
+
+  X86VectorWidthPreference(const X86TargetMachine *TM = nullptr)
+      : FunctionPass(ID), TM(TM) {}
+
+  bool runOnFunction(Function &F) override;
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.addRequired<BlockFrequencyInfoWrapperPass>();
+    AU.addRequired<LoopInfoWrapperPass>();
+    AU.addRequired<OptimizationRemarkEmitterWrapperPass>();
+    AU.addRequired<ProfileSummaryInfoWrapperPass>();
+    AU.setPreservesAll();
+  }
+
+  StringRef getPassName() const override {
+    return "X86 profile-guided vector width preference";
+  }
+};
+
+} // end anonymous namespace
+
+char X86VectorWidthPreference::ID = 0;
+
+INITIALIZE_PASS_BEGIN(X86VectorWidthPreference, DEBUG_TYPE,
+                      "X86 profile-guided vector width preference", false,
+                      false)
+INITIALIZE_PASS_DEPENDENCY(BlockFrequencyInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(OptimizationRemarkEmitterWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(ProfileSummaryInfoWrapperPass)
+INITIALIZE_PASS_END(X86VectorWidthPreference, DEBUG_TYPE,
+                    "X86 profile-guided vector width preference", false,
+                    false)
+
+FunctionPass *
+llvm::createX86VectorWidthPreferencePass(const X86TargetMachine &TM) {
+  return new X86VectorWidthPreference(&TM);
+}
+
+/// Estimate the trip count of \p L as the ratio of the header frequency to the
+/// preheader frequency.
+static uint64_t getEstimatedTripCount(const Loop &L,
+                                      const BlockFrequencyInfo &BFI) {
+  BasicBlock *Preheader = L.getLoopPreheader();
+  if (!Preheader)
+    return 0;
+  uint64_t PreheaderFreq = BFI.getBlockFreq(Preheader).getFrequency();
+  if (!PreheaderFreq)
+    return 0;
+  return BFI.getBlockFreq(L.getHeader()).getFrequency() / PreheaderFreq;
+}
+
+bool X86VectorWidthPreference::runOnFunction(Function &F) {
+  // When not created by X86TargetMachine, e.g. in opt, find the target
+  // machine through the pass config.
+  if (!TM)
+    if (auto *TPC = getAnalysisIfAvailable<TargetPassConfig>())
+      TM = &TPC->getTM<X86TargetMachine>();
+
+  // An explicit preference always wins.
+  if (!TM || skipFunction(F) || !F.hasProfileData() ||
+      F.hasFnAttribute("prefer-vector-width"))
+    return false;
+
+  // Only targets that have 512-bit vectors but default to 256 have a choice.
+  const X86Subtarget &ST = *TM->getSubtargetImpl(F);
+  if (!ST.hasAVX512() || ST.getPreferVectorWidth() >= 512)
+    return false;
+
+  auto &BFI = getAnalysis<BlockFrequencyInfoWrapperPass>().getBFI();
+  auto &LI = getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+  auto &ORE = getAnalysis<OptimizationRemarkEmitterWrapperPass>().getORE();
+  auto &PSI = getAnalysis<ProfileSummaryInfoWrapperPass>().getPSI();
+
+  if (!PSI.isFunctionHotInCallGraph(&F, BFI)) {
+    ORE.emit([&]() {
+      return OptimizationRemarkMissed(DEBUG_TYPE, "NotHot", F.getSubprogram(),
+                                      &F.getEntryBlock())
+             << "keeping " << ore::NV("VectorWidth", ST.getPreferVectorWidth())
+             << "-bit vectors: function is not hot";
+    });
+    return false;
+  }
+
+  // Weigh every block by its profiled frequency times its size, and find the
+  // share of that weight spent in long-running innermost loops.
+  double TotalWeight = 0.0;
+  for (BasicBlock &BB : F)
+    TotalWeight += double(BFI.getBlockFreq(&BB).getFrequency()) * BB.size();
+
+  double LoopWeight = 0.0;
+  for (Loop *L : LI.getLoopsInPreorder()) {
+    if (!L->empty() || getEstimatedTripCount(*L, BFI) < MinLoopTripCount)
+      continue;
+    for (BasicBlock *BB : L->blocks())
+      LoopWeight += double(BFI.getBlockFreq(BB).getFrequency()) * BB->size();
+  }
+
+  unsigned Percent =
+      TotalWeight > 0.0 ? unsigned(LoopWeight * 100.0 / TotalWeight) : 0;
+  LLVM_DEBUG(dbgs() << "X86VectorWidthPreference: " << F.getName() << ": "
+                    << Percent << "% of the weight in long-running loops\n");
+
+  if (Percent < MinLoopWeightPercent) {
+    ORE.emit([&]() {
+      return OptimizationRemarkMissed(DEBUG_TYPE, "ShortLoops",
+                                      F.getSubprogram(), &F.getEntryBlock())
+             << "keeping " << ore::NV("VectorWidth", ST.getPreferVectorWidth())
+             << "-bit vectors: only " << ore::NV("LoopWeightPercent", Percent)
+             << "% of the profiled instructions are in loops running at least "
+             << ore::NV("MinTripCount", MinLoopTripCount) << " iterations";
+    });
+    return false;
+  }
+
+  ORE.emit([&]() {
+    return OptimizationRemark(DEBUG_TYPE, "LongLoops", &F)
+           << "preferring " << ore::NV("VectorWidth", 512u)
+           << "-bit vectors: " << ore::NV("LoopWeightPercent", Percent)
+           << "% of the profiled instructions are in loops running at least "
+           << ore::NV("MinTripCount", MinLoopTripCount) << " iterations";
+  });
+  F.addFnAttr("prefer-vector-width", "512");
+  return true;
+}
@@ -69,12 +69,17 @@ void InterfaceFile::addUUID(Architecture Arch, uint8_t UUID[16]) {
 
 void InterfaceFile::addSymbol(SymbolKind Kind, StringRef Name,
                               ArchitectureSet Archs, SymbolFlags Flags) {
+  // Stubs commonly list the same symbol once per architecture section, so
+  // look it up before copying the name into the allocator.
+  auto It = Symbols.find(SymbolsMapKey{Kind, Name});
+  if (It != Symbols.end()) {
+    It->second->addArchitectures(Archs);
+    return;
+  }
+
   Name = copyString(Name);
-  auto result = Symbols.try_emplace(SymbolsMapKey{Kind, Name}, nullptr);
-  if (result.second)
-    result.first->second = new (Allocator) Symbol{Kind, Name, Archs, Flags};
-  else
-    result.first->second->addArchitectures(Archs);
+  Symbols.try_emplace(SymbolsMapKey{Kind, Name},
+                      new (Allocator) Symbol{Kind, Name, Archs, Flags});
 }
 
 } // end namespace MachO.
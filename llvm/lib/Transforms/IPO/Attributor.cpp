@@ -86,6 +86,16 @@ static cl::opt<unsigned>
                           cl::desc("Maximal number of fixpoint iterations."),
                           cl::init(32));
 
+// The number of iterations says little about the work done: one iteration
+// may update a handful of attributes or all of them. Bound the total number
+// of updates instead, which is deterministic, unlike a time limit, and scales
+// with the module. Zero means no limit.
+static cl::opt<unsigned> MaxFixpointUpdates(
+    "attributor-max-updates", cl::Hidden,
+    cl::desc("Maximal number of abstract attribute updates during the "
+             "fixpoint iteration (0 = no limit)."),
+    cl::init(0));
+
 static cl::opt<bool> DisableAttributor(
     "attributor-disable", cl::Hidden,
     cl::desc("Disable the attributor inter-procedural deduction pass."),
@@ -2028,6 +2038,7 @@ ChangeStatus Attributor::run() {
   // the abstract analysis.
 
   unsigned IterationCounter = 1;
+  unsigned NumUpdates = 0;
 
   SmallVector<AbstractAttribute *, 64> ChangedAAs;
   SetVector<AbstractAttribute *> Worklist;
@@ -2052,17 +2063,22 @@ ChangeStatus Attributor::run() {
     for (AbstractAttribute *AA : Worklist)
       if (AA->update(*this) == ChangeStatus::CHANGED)
         ChangedAAs.push_back(AA);
+    NumUpdates += Worklist.size();
 
     // Reset the work list and repopulate with the changed abstract attributes.
     // Note that dependent ones are added above.
     Worklist.clear();
     Worklist.insert(ChangedAAs.begin(), ChangedAAs.end());
 
-  } while (!Worklist.empty() && ++IterationCounter < MaxFixpointIterations);
+    // Only stop between iterations: the ones changed in the last iteration
+    // and their dependents are reverted below, which covers everything that
+    // would have been updated next.
+  } while (!Worklist.empty() && ++IterationCounter < MaxFixpointIterations &&
+           (!MaxFixpointUpdates || NumUpdates < MaxFixpointUpdates));
 
   LLVM_DEBUG(dbgs() << "\n[Attributor] Fixpoint iteration done after: "
                     << IterationCounter << "/" << MaxFixpointIterations
-                    << " iterations\n");
+                    << " iterations, " << NumUpdates << " updates\n");
 
   bool FinishedAtFixpoint = Worklist.empty();
 
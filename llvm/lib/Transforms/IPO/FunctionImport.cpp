@@ -67,6 +67,10 @@ STATISTIC(NumImportedCriticalFunctionsThinLink,
           "Number of critical functions thin link decided to import");
 STATISTIC(NumImportedGlobalVarsThinLink,
           "Number of global variables thin link decided to import");
+STATISTIC(NumImportedInstrsThinLink,
+          "Number of instructions in functions thin link decided to import");
+STATISTIC(NumBudgetRejectedThinLink,
+          "Number of functions not imported due to the module budget");
 STATISTIC(NumImportedFunctions, "Number of functions imported in backend");
 STATISTIC(NumImportedGlobalVars,
           "Number of global variables imported in backend");
@@ -79,6 +83,12 @@ static cl::opt<unsigned> ImportInstrLimit(
     "import-instr-limit", cl::init(100), cl::Hidden, cl::value_desc("N"),
     cl::desc("Only import functions with less than N instructions"));
 
+/// Limit on the total instruction count of functions imported into a module.
+static cl::opt<unsigned> ImportModuleInstrBudget(
+    "import-module-instr-budget", cl::init(0), cl::Hidden, cl::value_desc("N"),
+    cl::desc("Stop importing into a module once the imported functions add "
+             "up to N instructions (default 0 = unlimited)"));
+
 static cl::opt<int> ImportCutoff(
     "import-cutoff", cl::init(-1), cl::Hidden, cl::value_desc("N"),
     cl::desc("Only import first N functions if N>=0 (default -1)"));
@@ -337,6 +347,8 @@ getFailureName(FunctionImporter::ImportFailureReason Reason) {
     return "NotEligible";
   case FunctionImporter::ImportFailureReason::NoInline:
     return "NoInline";
+  case FunctionImporter::ImportFailureReason::BudgetExhausted:
+    return "BudgetExhausted";
   }
   llvm_unreachable("invalid reason");
 }
@@ -350,7 +362,8 @@ static void computeImportForFunction(
     SmallVectorImpl<EdgeInfo> &Worklist,
     FunctionImporter::ImportMapTy &ImportList,
     StringMap<FunctionImporter::ExportSetTy> *ExportLists,
-    FunctionImporter::ImportThresholdsTy &ImportThresholds) {
+    FunctionImporter::ImportThresholdsTy &ImportThresholds,
+    unsigned &ImportedInstrs) {
   computeImportForReferencedGlobals(Summary, DefinedGVSummaries, ImportList,
                                     ExportLists);
   static int ImportCount = 0;
@@ -433,6 +446,22 @@ static void computeImportForFunction(
       FunctionImporter::ImportFailureReason Reason;
       CalleeSummary = selectCallee(Index, VI.getSummaryList(), NewThreshold,
                                    Summary.modulePath(), Reason, VI.getGUID());
+
+      // Enforce the module budget. A function that was already imported into
+      // this module (e.g. through another alias) doesn't count twice.
+      if (CalleeSummary && ImportModuleInstrBudget) {
+        auto *FS = cast<FunctionSummary>(CalleeSummary->getBaseObject());
+        auto It = ImportList.find(FS->modulePath());
+        bool AlreadyImported =
+            It != ImportList.end() && It->second.count(VI.getGUID());
+        if (!AlreadyImported &&
+            ImportedInstrs + FS->instCount() > ImportModuleInstrBudget) {
+          CalleeSummary = nullptr;
+          Reason = FunctionImporter::ImportFailureReason::BudgetExhausted;
+          NumBudgetRejectedThinLink++;
+        }
+      }
+
       if (!CalleeSummary) {
         // Update with new larger threshold if this was a retry (otherwise
         // we would have already inserted with NewThreshold above). Also
@@ -471,6 +500,8 @@ static void computeImportForFunction(
       // inserted in the set of imports from the exporting module.
       bool PreviouslyImported = !ILI.second;
       if (!PreviouslyImported) {
+        ImportedInstrs += ResolvedCalleeSummary->instCount();
+        NumImportedInstrsThinLink += ResolvedCalleeSummary->instCount();
         NumImportedFunctionsThinLink++;
         if (IsHotCallsite)
           NumImportedHotFunctionsThinLink++;
@@ -530,6 +561,9 @@ static void ComputeImportForModule(
   // we will analyse the callees and may import further down the callgraph.
   SmallVector<EdgeInfo, 128> Worklist;
   FunctionImporter::ImportThresholdsTy ImportThresholds;
+  // Total instruction count of the functions imported into this module, which
+  // approximates the extra work its backend has to do.
+  unsigned ImportedInstrs = 0;
 
   // Populate the worklist with the import for the functions in the current
   // module
@@ -551,7 +585,7 @@ static void ComputeImportForModule(
     LLVM_DEBUG(dbgs() << "Initialize import for " << VI << "\n");
     computeImportForFunction(*FuncSummary, Index, ImportInstrLimit,
                              DefinedGVSummaries, Worklist, ImportList,
-                             ExportLists, ImportThresholds);
+                             ExportLists, ImportThresholds, ImportedInstrs);
   }
 
   // Process the newly imported functions and add callees to the worklist.
@@ -562,9 +596,12 @@ static void ComputeImportForModule(
 
     computeImportForFunction(*Summary, Index, Threshold, DefinedGVSummaries,
                              Worklist, ImportList, ExportLists,
-                             ImportThresholds);
+                             ImportThresholds, ImportedInstrs);
   }
 
+  LLVM_DEBUG(dbgs() << "Imported " << ImportedInstrs
+                    << " instructions into module " << ModName << "\n");
+
   // Print stats about functions considered but rejected for importing
   // when requested.
   if (PrintImportFailures) {
@@ -84,6 +84,17 @@ static cl::opt<int>
                        cl::desc("Base penalty for splitting cold code (as a "
                                 "multiple of TCC_Basic)"));
 
+static cl::opt<bool> EnableColdSection(
+    "enable-cold-section", cl::init(false), cl::Hidden,
+    cl::desc("Place functions extracted by hot-cold splitting into a "
+             "separate section"));
+
+static cl::opt<std::string>
+    ColdSectionName("hotcoldsplit-cold-section-name", cl::init("__llvm_cold"),
+                    cl::Hidden,
+                    cl::desc("Name of the section holding cold functions "
+                             "extracted by hot-cold splitting"));
+
 namespace {
 
 /// A sequence of basic blocks.
@@ -362,6 +373,13 @@ Function *HotColdSplitting::extractColdRegion(const BlockSequence &Region,
 
     markFunctionCold(*OutF, BFI != nullptr);
 
+    // Keep the cold code away from the hot code it was split from. Without a
+    // dedicated section, stay in the parent's explicit section, if any.
+    if (EnableColdSection)
+      OutF->setSection(ColdSectionName);
+    else if (OrigF->hasSection())
+      OutF->setSection(OrigF->getSection());
+
     LLVM_DEBUG(llvm::dbgs() << "Outlined Region: " << *OutF);
     ORE.emit([&]() {
       return OptimizationRemark(DEBUG_TYPE, "HotColdSplit",
@@ -81,6 +81,7 @@ STATISTIC(NumMergedAllocas, "Number of allocas merged together");
 // to inline a function A into B, we analyze the callers of B in order to see
 // if those would be more profitable and blocked inline steps.
 STATISTIC(NumCallerCallersAnalyzed, "Number of caller-callers analyzed");
+STATISTIC(NumCachedCosts, "Number of inline costs reused from the cache");
 
 /// Flag to disable manual alloca merging.
 ///
@@ -1002,15 +1003,31 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
       return FAM.getResult<BlockFrequencyAnalysis>(F);
     };
 
+    // shouldInline asks for the cost of inlining F into each of its callers
+    // once per candidate call site in F, and those answers only change when
+    // something is inlined into F. Remember them until then. The cache is
+    // bypassed when remarks are enabled so that they are all still emitted.
+    DenseMap<Instruction *, InlineCost> CachedCosts;
     auto GetInlineCost = [&](CallSite CS) {
       Function &Callee = *CS.getCalledFunction();
       auto &CalleeTTI = FAM.getResult<TargetIRAnalysis>(Callee);
       bool RemarksEnabled =
           Callee.getContext().getDiagHandlerPtr()->isMissedOptRemarkEnabled(
               DEBUG_TYPE);
-      return getInlineCost(cast<CallBase>(*CS.getInstruction()), Params,
-                           CalleeTTI, GetAssumptionCache, {GetBFI}, PSI,
-                           RemarksEnabled ? &ORE : nullptr);
+      if (RemarksEnabled)
+        return getInlineCost(cast<CallBase>(*CS.getInstruction()), Params,
+                             CalleeTTI, GetAssumptionCache, {GetBFI}, PSI,
+                             &ORE);
+      auto It = CachedCosts.find(CS.getInstruction());
+      if (It != CachedCosts.end()) {
+        ++NumCachedCosts;
+        return It->second;
+      }
+      InlineCost IC =
+          getInlineCost(cast<CallBase>(*CS.getInstruction()), Params,
+                        CalleeTTI, GetAssumptionCache, {GetBFI}, PSI, nullptr);
+      CachedCosts.insert({CS.getInstruction(), IC});
+      return IC;
     };
 
     // Now process as many calls as we have within this caller in the sequnece.
@@ -1082,6 +1099,7 @@ PreservedAnalyses InlinerPass::run(LazyCallGraph::SCC &InitialC,
       }
       DidInline = true;
       InlinedCallees.insert(&Callee);
+      CachedCosts.clear();
 
       ++NumInlined;
 
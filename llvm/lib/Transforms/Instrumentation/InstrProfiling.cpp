@@ -37,6 +37,7 @@
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
+#include "llvm/IR/ValueHandle.h"
 #include "llvm/Pass.h"
 #include "llvm/ProfileData/InstrProf.h"
 #include "llvm/Support/Casting.h"
@@ -102,6 +103,12 @@ cl::opt<bool> AtomicCounterUpdateAll(
     cl::desc("Make all profile counter updates atomic (for testing only)"),
     cl::init(false));
 
+cl::opt<bool> AtomicCounterUpdate(
+    "instrprof-atomic-counter-update", cl::ZeroOrMore,
+    cl::desc("Make profile counter updates atomic, as is done for "
+             "-fsanitize=thread. Unlike -instrprof-atomic-counter-update-all, "
+             "this still allows counter promotion"));
+
 cl::opt<bool> AtomicCounterUpdatePromoted(
     "atomic-counter-update-promoted", cl::ZeroOrMore,
     cl::desc("Do counter update using atomic fetch add "
@@ -180,9 +187,10 @@ public:
       BasicBlock *PH, ArrayRef<BasicBlock *> ExitBlocks,
       ArrayRef<Instruction *> InsertPts,
       DenseMap<Loop *, SmallVector<LoadStorePair, 8>> &LoopToCands,
-      LoopInfo &LI)
+      LoopInfo &LI, bool Atomic)
       : LoadAndStorePromoter({L, S}, SSA), Store(S), ExitBlocks(ExitBlocks),
-        InsertPts(InsertPts), LoopToCandidates(LoopToCands), LI(LI) {
+        InsertPts(InsertPts), LoopToCandidates(LoopToCands), LI(LI),
+        Atomic(Atomic) {
     assert(isa<LoadInst>(L));
     assert(isa<StoreInst>(S));
     SSA.AddAvailableValue(PH, Init);
@@ -199,7 +207,7 @@ public:
       Value *Addr = cast<StoreInst>(Store)->getPointerOperand();
       Type *Ty = LiveInValue->getType();
       IRBuilder<> Builder(InsertPos);
-      if (AtomicCounterUpdatePromoted)
+      if (Atomic || AtomicCounterUpdatePromoted)
         // automic update currently can only be promoted across the current
         // loop, not the whole loop nest.
         Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, LiveInValue,
@@ -225,6 +233,7 @@ private:
   ArrayRef<Instruction *> InsertPts;
   DenseMap<Loop *, SmallVector<LoadStorePair, 8>> &LoopToCandidates;
   LoopInfo &LI;
+  bool Atomic;
 };
 
 /// A helper class to do register promotion for all profile counter
@@ -234,9 +243,9 @@ class PGOCounterPromoter {
 public:
   PGOCounterPromoter(
       DenseMap<Loop *, SmallVector<LoadStorePair, 8>> &LoopToCands,
-      Loop &CurLoop, LoopInfo &LI, BlockFrequencyInfo *BFI)
+      Loop &CurLoop, LoopInfo &LI, BlockFrequencyInfo *BFI, bool Atomic)
       : LoopToCandidates(LoopToCands), ExitBlocks(), InsertPts(), L(CurLoop),
-        LI(LI), BFI(BFI) {
+        LI(LI), BFI(BFI), Atomic(Atomic) {
 
     SmallVector<BasicBlock *, 8> LoopExitBlocks;
     SmallPtrSet<BasicBlock *, 8> BlockSet;
@@ -281,7 +290,8 @@ public:
 
       PGOCounterPromoterHelper Promoter(Cand.first, Cand.second, SSA, InitVal,
                                         L.getLoopPreheader(), ExitBlocks,
-                                        InsertPts, LoopToCandidates, LI);
+                                        InsertPts, LoopToCandidates, LI,
+                                        Atomic);
       Promoter.run(SmallVector<Instruction *, 2>({Cand.first, Cand.second}));
       Promoted++;
       if (Promoted >= MaxProm)
@@ -365,6 +375,7 @@ private:
   Loop &L;
   LoopInfo &LI;
   BlockFrequencyInfo *BFI;
+  bool Atomic;
 };
 
 } // end anonymous namespace
@@ -419,7 +430,16 @@ bool InstrProfiling::lowerIntrinsics(Function *F) {
   if (!MadeChange)
     return false;
 
+  // With atomic updates, the counters are lowered to plain loads and stores
+  // so that the ones in loops can be kept in registers and flushed with one
+  // atomic add per loop exit. Whatever stays behind is made atomic again.
+  SmallVector<WeakVH, 8> AtomicCounterStores;
+  if (isAtomicCounterUpdateEnabled() && isCounterPromotionEnabled())
+    for (const auto &LoadStore : PromotionCandidates)
+      AtomicCounterStores.push_back(LoadStore.second);
+
   promoteCounterLoadStores(F);
+  makeUnpromotedCountersAtomic(AtomicCounterStores);
   return true;
 }
 
@@ -430,6 +450,13 @@ bool InstrProfiling::isCounterPromotionEnabled() const {
   return Options.DoCounterPromotion;
 }
 
+bool InstrProfiling::isAtomicCounterUpdateEnabled() const {
+  if (AtomicCounterUpdate.getNumOccurrences() > 0)
+    return AtomicCounterUpdate;
+
+  return Options.Atomic;
+}
+
 void InstrProfiling::promoteCounterLoadStores(Function *F) {
   if (!isCounterPromotionEnabled())
     return;
@@ -460,11 +487,30 @@ void InstrProfiling::promoteCounterLoadStores(Function *F) {
   // Do a post-order traversal of the loops so that counter updates can be
   // iteratively hoisted outside the loop nest.
   for (auto *Loop : llvm::reverse(Loops)) {
-    PGOCounterPromoter Promoter(LoopPromotionCandidates, *Loop, LI, BFI.get());
+    PGOCounterPromoter Promoter(LoopPromotionCandidates, *Loop, LI, BFI.get(),
+                                isAtomicCounterUpdateEnabled());
     Promoter.run(&TotalCountersPromoted);
   }
 }
 
+void InstrProfiling::makeUnpromotedCountersAtomic(
+    ArrayRef<WeakVH> CounterStores) {
+  for (Value *V : CounterStores) {
+    // The promoter has deleted the stores it moved out of loops.
+    auto *Store = cast_or_null<StoreInst>(V);
+    if (!Store)
+      continue;
+    auto *Add = cast<BinaryOperator>(Store->getValueOperand());
+    auto *Load = cast<LoadInst>(Add->getOperand(0));
+    IRBuilder<> Builder(Store);
+    Builder.CreateAtomicRMW(AtomicRMWInst::Add, Store->getPointerOperand(),
+                            Add->getOperand(1), AtomicOrdering::Monotonic);
+    Store->eraseFromParent();
+    Add->eraseFromParent();
+    Load->eraseFromParent();
+  }
+}
+
 /// Check if the module contains uses of any profiling intrinsics.
 static bool containsProfilingIntrinsics(Module &M) {
   if (auto *F = M.getFunction(
@@ -631,7 +677,8 @@ void InstrProfiling::lowerIncrement(InstrProfIncrementInst *Inc) {
   Value *Addr = Builder.CreateConstInBoundsGEP2_64(Counters->getValueType(),
                                                    Counters, 0, Index);
 
-  if (Options.Atomic || AtomicCounterUpdateAll) {
+  if (AtomicCounterUpdateAll ||
+      (isAtomicCounterUpdateEnabled() && !isCounterPromotionEnabled())) {
     Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, Inc->getStep(),
                             AtomicOrdering::Monotonic);
   } else {
@@ -65,6 +65,7 @@
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/ProfileSummaryInfo.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/IR/Attributes.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/CFG.h"
@@ -237,6 +238,14 @@ static cl::opt<bool>
                   cl::desc("Use this option to turn on/off "
                            "memory intrinsic size profiling."));
 
+// Command line option to also value profile the size of memcmp and bcmp
+// calls. Off by default: it changes the number of memop value sites, so the
+// instrumented and the optimizing builds need to agree on it.
+static cl::opt<bool>
+    PGOInstrMemcmpBcmp("pgo-instr-memcmp-bcmp", cl::init(false), cl::Hidden,
+                       cl::desc("Use this option to turn on/off "
+                                "memcmp and bcmp size profiling."));
+
 // Emit branch probability as optimization remarks.
 static cl::opt<bool>
     EmitBranchProbability("pgo-emit-branch-prob", cl::init(false), cl::Hidden,
@@ -359,8 +368,14 @@ struct MemIntrinsicVisitor : public InstVisitor<MemIntrinsicVisitor> {
   uint64_t FuncHash = 0;
   PGOUseFunc *UseFunc = nullptr;
   std::vector<Instruction *> Candidates;
+  // Only built when memcmp and bcmp are profiled.
+  std::unique_ptr<TargetLibraryInfoImpl> TLII;
 
-  MemIntrinsicVisitor(Function &Func) : F(Func) {}
+  MemIntrinsicVisitor(Function &Func) : F(Func) {
+    if (PGOInstrMemcmpBcmp)
+      TLII = llvm::make_unique<TargetLibraryInfoImpl>(
+          Triple(Func.getParent()->getTargetTriple()));
+  }
 
   void countMemIntrinsics(Function &Func) {
     NMemIs = 0;
@@ -385,10 +400,17 @@ struct MemIntrinsicVisitor : public InstVisitor<MemIntrinsicVisitor> {
   }
 
   // Visit the IR stream and annotate all mem intrinsic call instructions.
-  void instrumentOneMemIntrinsic(MemIntrinsic &MI);
+  void instrumentOneMemIntrinsic(Instruction &I, Value *Length);
+
+  // Perform tasks on memory operation \p I of size \p Length according to
+  // visit mode.
+  void visitMemOp(Instruction &I, Value *Length);
 
   // Visit \p MI instruction and perform tasks according to visit mode.
-  void visitMemIntrinsic(MemIntrinsic &SI);
+  void visitMemIntrinsic(MemIntrinsic &MI) { visitMemOp(MI, MI.getLength()); }
+
+  // Visit calls to memcmp and bcmp when they are profiled.
+  void visitCallInst(CallInst &CI);
 
   unsigned getNumOfMemIntrinsics() const { return NMemIs; }
 };
@@ -1433,12 +1455,12 @@ void SelectInstVisitor::visitSelectInst(SelectInst &SI) {
   llvm_unreachable("Unknown visiting mode");
 }
 
-void MemIntrinsicVisitor::instrumentOneMemIntrinsic(MemIntrinsic &MI) {
+void MemIntrinsicVisitor::instrumentOneMemIntrinsic(Instruction &I,
+                                                    Value *Length) {
   Module *M = F.getParent();
-  IRBuilder<> Builder(&MI);
+  IRBuilder<> Builder(&I);
   Type *Int64Ty = Builder.getInt64Ty();
   Type *I8PtrTy = Builder.getInt8PtrTy();
-  Value *Length = MI.getLength();
   assert(!isa<ConstantInt>(Length));
   Builder.CreateCall(
       Intrinsic::getDeclaration(M, Intrinsic::instrprof_value_profile),
@@ -1448,10 +1470,9 @@ void MemIntrinsicVisitor::instrumentOneMemIntrinsic(MemIntrinsic &MI) {
   ++CurCtrId;
 }
 
-void MemIntrinsicVisitor::visitMemIntrinsic(MemIntrinsic &MI) {
+void MemIntrinsicVisitor::visitMemOp(Instruction &I, Value *Length) {
   if (!PGOInstrMemOP)
     return;
-  Value *Length = MI.getLength();
   // Not instrument constant length calls.
   if (dyn_cast<ConstantInt>(Length))
     return;
@@ -1461,15 +1482,26 @@ void MemIntrinsicVisitor::visitMemIntrinsic(MemIntrinsic &MI) {
     NMemIs++;
     return;
   case VM_instrument:
-    instrumentOneMemIntrinsic(MI);
+    instrumentOneMemIntrinsic(I, Length);
     return;
   case VM_annotate:
-    Candidates.push_back(&MI);
+    Candidates.push_back(&I);
     return;
   }
   llvm_unreachable("Unknown visiting mode");
 }
 
+void MemIntrinsicVisitor::visitCallInst(CallInst &CI) {
+  if (!TLII)
+    return;
+  TargetLibraryInfo TLI(*TLII);
+  LibFunc Func;
+  if (!TLI.getLibFunc(ImmutableCallSite(&CI), Func) ||
+      (Func != LibFunc_memcmp && Func != LibFunc_bcmp))
+    return;
+  visitMemOp(CI, CI.getArgOperand(2));
+}
+
 // Traverse all valuesites and annotate the instructions for all value kind.
 void PGOUseFunc::annotateValueSites() {
   if (DisableValueProfiling)
@@ -35,6 +35,8 @@
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/MemoryBuiltins.h"
 #include "llvm/Analysis/MemoryDependenceAnalysis.h"
+#include "llvm/Analysis/MemorySSA.h"
+#include "llvm/Analysis/MemorySSAUpdater.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/PHITransAddr.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
@@ -100,6 +102,21 @@ static cl::opt<bool> EnablePRE("enable-pre",
 static cl::opt<bool> EnableLoadPRE("enable-load-pre", cl::init(true));
 static cl::opt<bool> EnableMemDep("enable-gvn-memdep", cl::init(true));
 
+// MemoryDependenceAnalysis answers non-local load queries by walking every
+// predecessor path, which is what makes GVN slow on very large functions.
+// With this option, loads are instead eliminated using the clobbering access
+// MemorySSA finds for them. That only catches redundancy with a single
+// dominating source, and there is no load PRE.
+static cl::opt<bool> EnableMemorySSA(
+    "enable-gvn-memoryssa", cl::init(false), cl::Hidden,
+    cl::desc("Use MemorySSA instead of MemoryDependenceAnalysis to eliminate "
+             "redundant loads in GVN"));
+
+static cl::opt<unsigned> MemorySSAUseScanLimit(
+    "gvn-memoryssa-use-scan-limit", cl::init(100), cl::Hidden,
+    cl::desc("Max number of other uses of a load's clobbering access GVN "
+             "looks through to find an equivalent load"));
+
 // Maximum allowed recursion depth.
 static cl::opt<uint32_t>
 MaxRecurseDepth("gvn-max-recurse-depth", cl::Hidden, cl::init(1000), cl::ZeroOrMore,
@@ -619,7 +636,9 @@ PreservedAnalyses GVN::run(Function &F, FunctionAnalysisManager &AM) {
   auto &MemDep = AM.getResult<MemoryDependenceAnalysis>(F);
   auto *LI = AM.getCachedResult<LoopAnalysis>(F);
   auto &ORE = AM.getResult<OptimizationRemarkEmitterAnalysis>(F);
-  bool Changed = runImpl(F, AC, DT, TLI, AA, &MemDep, LI, &ORE);
+  auto *MSSA =
+      EnableMemorySSA ? &AM.getResult<MemorySSAAnalysis>(F).getMSSA() : nullptr;
+  bool Changed = runImpl(F, AC, DT, TLI, AA, &MemDep, LI, &ORE, MSSA);
   if (!Changed)
     return PreservedAnalyses::all();
   PreservedAnalyses PA;
@@ -1433,10 +1452,75 @@ static void patchAndReplaceAllUsesWith(Instruction *I, Value *Repl) {
   I->replaceAllUsesWith(Repl);
 }
 
+/// Attempt to eliminate a load using the access MemorySSA finds clobbering
+/// it: a store or memory intrinsic we can forward from, or an earlier load of
+/// the same pointer with the same clobber.
+bool GVN::processLoadWithMemorySSA(LoadInst *L) {
+  MemorySSA *MSSA = MSSAU->getMemorySSA();
+  MemoryUseOrDef *LoadAccess = MSSA->getMemoryAccess(L);
+  if (!LoadAccess)
+    return false;
+  MemoryAccess *Clobber =
+      MSSA->getWalker()->getClobberingMemoryAccess(LoadAccess);
+
+  Value *Repl = nullptr;
+  if (auto *Def = dyn_cast<MemoryDef>(Clobber)) {
+    if (!MSSA->isLiveOnEntryDef(Def)) {
+      Instruction *DepInst = Def->getMemoryInst();
+      MemDepResult Dep = MemDepResult::getClobber(DepInst);
+      // Mirror MemoryDependenceAnalysis: a must-aliasing store is a Def.
+      if (auto *S = dyn_cast<StoreInst>(DepInst))
+        if (VN.getAliasAnalysis()->isMustAlias(MemoryLocation::get(S),
+                                               MemoryLocation::get(L)))
+          Dep = MemDepResult::getDef(DepInst);
+
+      AvailableValue AV;
+      if ((isa<StoreInst>(DepInst) || isa<MemIntrinsic>(DepInst)) &&
+          AnalyzeLoadAvailability(L, Dep, L->getPointerOperand(), AV))
+        Repl = AV.MaterializeAdjustedValue(L, L, *this);
+    }
+  }
+
+  // Otherwise look for an earlier load of the same pointer that MemorySSA
+  // found the same clobber for. Only reuse loads of the same type, so nothing
+  // needs to be re-loaded.
+  if (!Repl) {
+    unsigned Scanned = 0;
+    for (User *U : Clobber->users()) {
+      if (++Scanned > MemorySSAUseScanLimit)
+        break;
+      // Every path from Clobber to L passes through a dominating load, and
+      // nothing on those paths clobbers L, so the load's value is still
+      // current at L.
+      auto *OtherUse = dyn_cast<MemoryUse>(U);
+      if (!OtherUse || OtherUse == LoadAccess)
+        continue;
+      auto *Other = dyn_cast_or_null<LoadInst>(OtherUse->getMemoryInst());
+      if (!Other || Other->getPointerOperand() != L->getPointerOperand() ||
+          Other->getType() != L->getType() || !Other->isUnordered() ||
+          Other->isAtomic() < L->isAtomic() ||
+          !MSSA->dominates(OtherUse, LoadAccess))
+        continue;
+      Repl = Other;
+      break;
+    }
+  }
+
+  if (!Repl)
+    return false;
+
+  // Replace the load!
+  patchAndReplaceAllUsesWith(L, Repl);
+  markInstructionForDeletion(L);
+  ++NumGVNLoad;
+  reportLoadElim(L, Repl, ORE);
+  return true;
+}
+
 /// Attempt to eliminate a load, first by eliminating it
 /// locally, and then attempting non-local elimination if that fails.
 bool GVN::processLoad(LoadInst *L) {
-  if (!MD)
+  if (!MD && !MSSAU)
     return false;
 
   // This code hasn't been audited for ordered or volatile memory access
@@ -1448,6 +1532,9 @@ bool GVN::processLoad(LoadInst *L) {
     return true;
   }
 
+  if (MSSAU)
+    return processLoadWithMemorySSA(L);
+
   // ... to a pointer that has been loaded from before...
   MemDepResult Dep = MD->getDependency(L);
 
@@ -1967,7 +2054,7 @@ bool GVN::processInstruction(Instruction *I) {
 bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
                   const TargetLibraryInfo &RunTLI, AAResults &RunAA,
                   MemoryDependenceResults *RunMD, LoopInfo *LI,
-                  OptimizationRemarkEmitter *RunORE) {
+                  OptimizationRemarkEmitter *RunORE, MemorySSA *MSSA) {
   AC = &RunAC;
   DT = &RunDT;
   VN.setDomTree(DT);
@@ -1979,6 +2066,10 @@ bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
   VN.setMemDep(MD);
   ORE = RunORE;
   InvalidBlockRPONumbers = true;
+  std::unique_ptr<MemorySSAUpdater> Updater;
+  if (MSSA)
+    Updater = llvm::make_unique<MemorySSAUpdater>(MSSA);
+  MSSAU = Updater.get();
 
   bool Changed = false;
   bool ShouldContinue = true;
@@ -1989,7 +2080,7 @@ bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
   for (Function::iterator FI = F.begin(), FE = F.end(); FI != FE; ) {
     BasicBlock *BB = &*FI++;
 
-    bool removedBlock = MergeBlockIntoPredecessor(BB, &DTU, LI, nullptr, MD);
+    bool removedBlock = MergeBlockIntoPredecessor(BB, &DTU, LI, MSSAU, MD);
     if (removedBlock)
       ++NumGVNBlocks;
 
@@ -2025,6 +2116,10 @@ bool GVN::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
   // iteration.
   DeadBlocks.clear();
 
+  if (MSSA && VerifyMemorySSA)
+    MSSA->verifyMemorySSA();
+  MSSAU = nullptr;
+
   return Changed;
 }
 
@@ -2064,6 +2159,8 @@ bool GVN::processBlock(BasicBlock *BB) {
       LLVM_DEBUG(dbgs() << "GVN removed: " << *I << '\n');
       salvageDebugInfo(*I);
       if (MD) MD->removeInstruction(I);
+      if (MSSAU)
+        MSSAU->removeMemoryAccess(I);
       LLVM_DEBUG(verifyRemoved(I));
       ICF->removeInstruction(I);
       I->eraseFromParent();
@@ -2294,6 +2391,8 @@ bool GVN::performScalarPRE(Instruction *CurInst) {
   LLVM_DEBUG(dbgs() << "GVN PRE removed: " << *CurInst << '\n');
   if (MD)
     MD->removeInstruction(CurInst);
+  if (MSSAU)
+    MSSAU->removeMemoryAccess(CurInst);
   LLVM_DEBUG(verifyRemoved(CurInst));
   // FIXME: Intended to be markInstructionForDeletion(CurInst), but it causes
   // some assertion failures.
@@ -2335,7 +2434,8 @@ bool GVN::performPRE(Function &F) {
 /// the block inserted to the critical edge.
 BasicBlock *GVN::splitCriticalEdges(BasicBlock *Pred, BasicBlock *Succ) {
   BasicBlock *BB =
-      SplitCriticalEdge(Pred, Succ, CriticalEdgeSplittingOptions(DT));
+      SplitCriticalEdge(Pred, Succ, CriticalEdgeSplittingOptions(DT, nullptr,
+                                                                 MSSAU));
   if (MD)
     MD->invalidateCachedPredecessors();
   InvalidBlockRPONumbers = true;
@@ -2350,7 +2450,7 @@ bool GVN::splitCriticalEdges() {
   do {
     std::pair<Instruction *, unsigned> Edge = toSplit.pop_back_val();
     SplitCriticalEdge(Edge.first, Edge.second,
-                      CriticalEdgeSplittingOptions(DT));
+                      CriticalEdgeSplittingOptions(DT, nullptr, MSSAU));
   } while (!toSplit.empty());
   if (MD) MD->invalidateCachedPredecessors();
   InvalidBlockRPONumbers = true;
@@ -2549,7 +2649,9 @@ public:
         NoMemDepAnalysis ? nullptr
                 : &getAnalysis<MemoryDependenceWrapperPass>().getMemDep(),
         LIWP ? &LIWP->getLoopInfo() : nullptr,
-        &getAnalysis<OptimizationRemarkEmitterWrapperPass>().getORE());
+        &getAnalysis<OptimizationRemarkEmitterWrapperPass>().getORE(),
+        EnableMemorySSA ? &getAnalysis<MemorySSAWrapperPass>().getMSSA()
+                        : nullptr);
   }
 
   void getAnalysisUsage(AnalysisUsage &AU) const override {
@@ -2558,6 +2660,8 @@ public:
     AU.addRequired<TargetLibraryInfoWrapperPass>();
     if (!NoMemDepAnalysis)
       AU.addRequired<MemoryDependenceWrapperPass>();
+    if (EnableMemorySSA)
+      AU.addRequired<MemorySSAWrapperPass>();
     AU.addRequired<AAResultsWrapperPass>();
 
     AU.addPreserved<DominatorTreeWrapperPass>();
@@ -2576,6 +2680,7 @@ char GVNLegacyPass::ID = 0;
 INITIALIZE_PASS_BEGIN(GVNLegacyPass, "gvn", "Global Value Numbering", false, false)
 INITIALIZE_PASS_DEPENDENCY(AssumptionCacheTracker)
 INITIALIZE_PASS_DEPENDENCY(MemoryDependenceWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(MemorySSAWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(DominatorTreeWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(TargetLibraryInfoWrapperPass)
 INITIALIZE_PASS_DEPENDENCY(AAResultsWrapperPass)
@@ -43,6 +43,7 @@
 #include "llvm/Transforms/Utils.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/LoopUtils.h"
+#include <algorithm>
 #include <cassert>
 #include <utility>
 #include <vector>
@@ -57,6 +58,15 @@ static cl::opt<int> LoopInterchangeCostThreshold(
     "loop-interchange-threshold", cl::init(0), cl::Hidden,
     cl::desc("Interchange if you gain more than this number"));
 
+static cl::opt<bool> EnableCacheCostModel(
+    "loop-interchange-cache-model", cl::init(false), cl::Hidden,
+    cl::desc("Decide profitability by the cache lines the inner loop touches "
+             "per iteration instead of by subscript order"));
+
+static cl::opt<unsigned> CacheLineSize(
+    "loop-interchange-cache-line-size", cl::init(64), cl::Hidden,
+    cl::desc("Cache line size in bytes assumed by the cache cost model"));
+
 namespace {
 
 using LoopVector = SmallVector<Loop *, 8>;
@@ -381,6 +391,7 @@ public:
 
 private:
   int getInstrOrderCost();
+  unsigned getCacheCost(const Loop *Innermost);
 
   Loop *OuterLoop;
   Loop *InnerLoop;
@@ -1078,6 +1089,38 @@ int LoopInterchangeProfitability::getInstrOrderCost() {
   return GoodOrder - BadOrder;
 }
 
+/// Return the bytes of cache lines that the access to \p Ptr touches per
+/// iteration of \p L: 0 if the access does not move with \p L, its stride if
+/// consecutive iterations share a line, and a whole line otherwise. Accesses
+/// that move with \p L in a way SCEV can't describe, such as indirect ones,
+/// are charged a whole line.
+static unsigned getCacheCostOfAccess(const SCEV *Ptr, const Loop *L,
+                                     ScalarEvolution &SE) {
+  // Walk {{Base,+,S1}<Outer>,+,S2}<Inner> to find the step for L.
+  const auto *AR = dyn_cast<SCEVAddRecExpr>(Ptr);
+  while (AR && AR->getLoop() != L)
+    AR = dyn_cast<SCEVAddRecExpr>(AR->getStart());
+  if (!AR)
+    return SE.isLoopInvariant(Ptr, L) ? 0 : CacheLineSize;
+  const auto *Step = dyn_cast<SCEVConstant>(AR->getStepRecurrence(SE));
+  if (!Step)
+    return CacheLineSize;
+  uint64_t Stride = Step->getAPInt().abs().getLimitedValue();
+  return std::min<uint64_t>(Stride, CacheLineSize);
+}
+
+/// Sum the cache cost of all memory accesses in the inner loop body, assuming
+/// \p Innermost is the loop that runs innermost.
+unsigned
+LoopInterchangeProfitability::getCacheCost(const Loop *Innermost) {
+  unsigned Cost = 0;
+  for (BasicBlock *BB : InnerLoop->blocks())
+    for (Instruction &I : *BB)
+      if (Value *Ptr = getLoadStorePointerOperand(&I))
+        Cost += getCacheCostOfAccess(SE->getSCEV(Ptr), Innermost, *SE);
+  return Cost;
+}
+
 static bool isProfitableForVectorization(unsigned InnerLoopId,
                                          unsigned OuterLoopId,
                                          CharMatrix &DepMatrix) {
@@ -1107,8 +1150,19 @@ bool LoopInterchangeProfitability::isProfitable(unsigned InnerLoopId,
 
   // This is rough cost estimation algorithm. It counts the good and bad order
   // of induction variables in the instruction and allows reordering if number
-  // of bad orders is more than good.
-  int Cost = getInstrOrderCost();
+  // of bad orders is more than good. The cache model instead compares the
+  // cache lines touched per innermost iteration in both orders. Either way a
+  // negative cost favors interchange.
+  int Cost;
+  if (EnableCacheCostModel) {
+    unsigned InnerCost = getCacheCost(InnerLoop);
+    unsigned OuterCost = getCacheCost(OuterLoop);
+    LLVM_DEBUG(dbgs() << "Cache cost: " << InnerCost << " as is, " << OuterCost
+                      << " interchanged\n");
+    Cost = int(OuterCost) - int(InnerCost);
+  } else {
+    Cost = getInstrOrderCost();
+  }
   LLVM_DEBUG(dbgs() << "Cost = " << Cost << "\n");
   if (Cost < -LoopInterchangeCostThreshold)
     return true;
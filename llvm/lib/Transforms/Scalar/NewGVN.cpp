@@ -3458,10 +3458,19 @@ bool NewGVN::runGVN() {
                     << " marked reachable\n");
   ReachableBlocks.insert(&F.getEntryBlock());
 
-  iterateTouchedInstructions();
-  verifyMemoryCongruency();
-  verifyIterationSettled(F);
-  verifyStoreExpressions();
+  // Value numbering doesn't change the IR, so all the clobber queries it
+  // makes can share one alias analysis cache.
+  {
+    BatchAAResults BatchAA(*AA);
+    std::unique_ptr<MemorySSAWalker> BatchWalker =
+        MSSA->getBatchWalker(BatchAA);
+    MSSAWalker = BatchWalker.get();
+    iterateTouchedInstructions();
+    verifyMemoryCongruency();
+    verifyIterationSettled(F);
+    verifyStoreExpressions();
+    MSSAWalker = MSSA->getWalker();
+  }
 
   Changed |= eliminateInstructions(F);
 
@@ -15,9 +15,11 @@
 #include "llvm/Transforms/Utils/SplitModule.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/EquivalenceClasses.h"
+#include "llvm/ADT/SCCIterator.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Analysis/CallGraph.h"
 #include "llvm/IR/Comdat.h"
 #include "llvm/IR/Constant.h"
 #include "llvm/IR/Constants.h"
@@ -40,6 +42,7 @@
 #include "llvm/Transforms/Utils/ValueMapper.h"
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <queue>
@@ -91,10 +94,19 @@ static void addAllGlobalValueUsers(ClusterMapType &GVtoClusterMap,
   }
 }
 
+// Estimates the cost of generating code for GV.
+static uint64_t getCodeGenCost(const GlobalValue *GV) {
+  if (const Function *F = dyn_cast<Function>(GV))
+    return std::max(1u, F->getInstructionCount());
+  return 1;
+}
+
 // Find partitions for module in the way that no locals need to be
 // globalized.
-// Try to balance pack those partitions into N files since this roughly equals
-// thread balancing for the backend codegen step.
+// Try to balance pack those partitions into N files by the instruction count
+// of their functions since this roughly equals thread balancing for the
+// backend codegen step. Functions that are part of the same call graph cycle
+// are kept together.
 static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
                            unsigned N) {
   // At this point module should have the proper mix of globals and locals.
@@ -112,10 +124,13 @@ static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
     if (!GV.hasName())
       GV.setName("__llvmsplit_unnamed");
 
-    // Comdat groups must not be partitioned. For comdat groups that contain
-    // locals, record all their members here so we can keep them together.
-    // Comdat groups that only contain external globals are already handled by
-    // the MD5-based partitioning.
+    // Every definition gets a cluster, even if it is not tied to anything
+    // else, so that all of them are balanced below instead of being placed
+    // by name hash.
+    GVtoClusterMap.insert(&GV);
+
+    // Comdat groups must not be partitioned. Their members are merged into
+    // one cluster, so that the whole group is placed together.
     if (const Comdat *C = GV.getComdat()) {
       auto &Member = ComdatMembers[C];
       if (Member)
@@ -147,38 +162,51 @@ static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
   llvm::for_each(M->functions(), recordGVSet);
   llvm::for_each(M->globals(), recordGVSet);
   llvm::for_each(M->aliases(), recordGVSet);
+  llvm::for_each(M->ifuncs(), recordGVSet);
+
+  // Keep mutually recursive functions in the same partition.
+  CallGraph CG(*M);
+  for (scc_iterator<CallGraph *> I = scc_begin(&CG); !I.isAtEnd(); ++I) {
+    const Function *Leader = nullptr;
+    for (CallGraphNode *Node : *I) {
+      const Function *F = Node->getFunction();
+      if (!F || F->isDeclaration())
+        continue;
+      if (Leader)
+        GVtoClusterMap.unionSets(Leader, F);
+      else
+        Leader = F;
+    }
+  }
 
-  // Assigned all GVs to merged clusters while balancing number of objects in
-  // each.
-  auto CompareClusters = [](const std::pair<unsigned, unsigned> &a,
-                            const std::pair<unsigned, unsigned> &b) {
-    if (a.second || b.second)
-      return a.second > b.second;
-    else
-      return a.first > b.first;
-  };
-
-  std::priority_queue<std::pair<unsigned, unsigned>,
-                      std::vector<std::pair<unsigned, unsigned>>,
-                      decltype(CompareClusters)>
-      BalancinQueue(CompareClusters);
+  // Assigned all GVs to merged clusters while balancing the estimated codegen
+  // cost of each. The queue yields the partition with the lowest cost, using
+  // the partition ID to break ties.
+  using PartitionType = std::pair<uint64_t, unsigned>;
+  std::priority_queue<PartitionType, std::vector<PartitionType>,
+                      std::greater<PartitionType>>
+      BalancinQueue;
   // Pre-populate priority queue with N slot blanks.
   for (unsigned i = 0; i < N; ++i)
-    BalancinQueue.push(std::make_pair(i, 0));
+    BalancinQueue.push(std::make_pair(0, i));
 
-  using SortType = std::pair<unsigned, ClusterMapType::iterator>;
+  using SortType = std::pair<uint64_t, ClusterMapType::iterator>;
 
   SmallVector<SortType, 64> Sets;
   SmallPtrSet<const GlobalValue *, 32> Visited;
 
-  // To guarantee determinism, we have to sort SCC according to size.
-  // When size is the same, use leader's name.
+  // To guarantee determinism, we have to sort SCC according to cost.
+  // When cost is the same, use leader's name.
   for (ClusterMapType::iterator I = GVtoClusterMap.begin(),
-                                E = GVtoClusterMap.end(); I != E; ++I)
-    if (I->isLeader())
-      Sets.push_back(
-          std::make_pair(std::distance(GVtoClusterMap.member_begin(I),
-                                       GVtoClusterMap.member_end()), I));
+                                E = GVtoClusterMap.end(); I != E; ++I) {
+    if (!I->isLeader())
+      continue;
+    uint64_t Cost = 0;
+    for (ClusterMapType::member_iterator MI = GVtoClusterMap.member_begin(I);
+         MI != GVtoClusterMap.member_end(); ++MI)
+      Cost += getCodeGenCost(*MI);
+    Sets.push_back(std::make_pair(Cost, I));
+  }
 
   llvm::sort(Sets, [](const SortType &a, const SortType &b) {
     if (a.first == b.first)
@@ -188,11 +216,11 @@ static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
   });
 
   for (auto &I : Sets) {
-    unsigned CurrentClusterID = BalancinQueue.top().first;
-    unsigned CurrentClusterSize = BalancinQueue.top().second;
+    uint64_t CurrentClusterCost = BalancinQueue.top().first;
+    unsigned CurrentClusterID = BalancinQueue.top().second;
     BalancinQueue.pop();
 
-    LLVM_DEBUG(dbgs() << "Root[" << CurrentClusterID << "] cluster_size("
+    LLVM_DEBUG(dbgs() << "Root[" << CurrentClusterID << "] cluster_cost("
                       << I.first << ") ----> " << I.second->getData()->getName()
                       << "\n");
 
@@ -205,10 +233,10 @@ static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
                         << ((*MI)->hasLocalLinkage() ? " l " : " e ") << "\n");
       Visited.insert(*MI);
       ClusterIDMap[*MI] = CurrentClusterID;
-      CurrentClusterSize++;
     }
-    // Add this set size to the number of entries in this cluster.
-    BalancinQueue.push(std::make_pair(CurrentClusterID, CurrentClusterSize));
+    // Add this set's cost to the cost of this cluster.
+    BalancinQueue.push(
+        std::make_pair(CurrentClusterCost + I.first, CurrentClusterID));
   }
 }
 
@@ -68,6 +68,7 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
@@ -6176,6 +6177,105 @@ static unsigned determineVPlanVF(const unsigned WidestVectorRegBits,
   return WidestVectorRegBits / WidestType;
 }
 
+/// Return the cost of \p I widened to \p VF lanes by the VPlan-native path,
+/// which widens every instruction it doesn't know better about.
+static unsigned getVPlanNativeCost(Instruction &I, unsigned VF,
+                                   const TargetTransformInfo &TTI) {
+  assert(VF > 1 && "Outer loops are only costed for vector VFs");
+  Type *VectorTy = ToVectorTy(I.getType(), VF);
+  switch (I.getOpcode()) {
+  case Instruction::GetElementPtr:
+    // As in the legacy model, the address computation is accounted for by
+    // the memory instructions that use it.
+    return 0;
+  case Instruction::Add:
+  case Instruction::FAdd:
+  case Instruction::Sub:
+  case Instruction::FSub:
+  case Instruction::Mul:
+  case Instruction::FMul:
+  case Instruction::UDiv:
+  case Instruction::SDiv:
+  case Instruction::FDiv:
+  case Instruction::URem:
+  case Instruction::SRem:
+  case Instruction::FRem:
+  case Instruction::Shl:
+  case Instruction::LShr:
+  case Instruction::AShr:
+  case Instruction::And:
+  case Instruction::Or:
+  case Instruction::Xor:
+    return TTI.getArithmeticInstrCost(I.getOpcode(), VectorTy);
+  case Instruction::ICmp:
+  case Instruction::FCmp:
+    return TTI.getCmpSelInstrCost(
+        I.getOpcode(), ToVectorTy(I.getOperand(0)->getType(), VF));
+  case Instruction::Select:
+    return TTI.getCmpSelInstrCost(
+        I.getOpcode(), VectorTy,
+        ToVectorTy(I.getOperand(0)->getType(), VF));
+  case Instruction::ZExt:
+  case Instruction::SExt:
+  case Instruction::FPToUI:
+  case Instruction::FPToSI:
+  case Instruction::FPExt:
+  case Instruction::PtrToInt:
+  case Instruction::IntToPtr:
+  case Instruction::SIToFP:
+  case Instruction::UIToFP:
+  case Instruction::Trunc:
+  case Instruction::FPTrunc:
+  case Instruction::BitCast:
+    return TTI.getCastInstrCost(I.getOpcode(), VectorTy,
+                                ToVectorTy(I.getOperand(0)->getType(), VF));
+  default:
+    // Assume anything else is scalarized.
+    return VF * TTI.getInstructionCost(
+                    &I, TargetTransformInfo::TCK_RecipThroughput);
+  }
+}
+
+/// Return the cost of one iteration of the loop body of \p Plan at \p VF,
+/// summing over the recipes VPInstructionsToVPRecipes creates.
+static unsigned getVPlanNativeCost(VPlan &Plan, unsigned VF,
+                                   const TargetTransformInfo &TTI) {
+  unsigned Cost = 0;
+  VPRegionBlock *TopRegion = cast<VPRegionBlock>(Plan.getEntry());
+  ReversePostOrderTraversal<VPBlockBase *> RPOT(TopRegion->getEntry());
+  for (VPBlockBase *Base : RPOT) {
+    // The pre-header and exit blocks are not widened.
+    if (Base->getNumPredecessors() == 0 || Base->getNumSuccessors() == 0)
+      continue;
+
+    for (VPRecipeBase &R : *Base->getEntryBasicBlock()) {
+      if (auto *Widen = dyn_cast<VPWidenRecipe>(&R)) {
+        for (Instruction &I : Widen->getIngredients())
+          Cost += getVPlanNativeCost(I, VF, TTI);
+      } else if (auto *Mem = dyn_cast<VPWidenMemoryInstructionRecipe>(&R)) {
+        // Without a cost model to prove accesses consecutive, the
+        // VPlan-native path emits gathers and scatters.
+        Instruction &I = Mem->getIngredient();
+        Type *ValTy = getMemInstValueType(&I);
+        unsigned Alignment = getLoadStoreAlignment(&I);
+        Type *VectorTy = ToVectorTy(ValTy, VF);
+        Cost += TTI.getAddressComputationCost(VectorTy) +
+                TTI.getGatherScatterOpCost(I.getOpcode(), VectorTy,
+                                           getLoadStorePointerOperand(&I),
+                                           /*VariableMask=*/false, Alignment);
+      } else if (auto *Ind = dyn_cast<VPWidenIntOrFpInductionRecipe>(&R)) {
+        // The vector induction is stepped once per iteration.
+        Type *Ty = Ind->getPHI()->getType();
+        Cost += TTI.getArithmeticInstrCost(
+            Ty->isFloatingPointTy() ? Instruction::FAdd : Instruction::Add,
+            ToVectorTy(Ty, VF));
+      }
+      // Other phis are free.
+    }
+  }
+  return Cost;
+}
+
 VectorizationFactor
 LoopVectorizationPlanner::planInVPlanNativePath(unsigned UserVF) {
   unsigned VF = UserVF;
@@ -6199,15 +6299,42 @@ LoopVectorizationPlanner::planInVPlanNativePath(unsigned UserVF) {
     }
     assert(EnableVPlanNativePath && "VPlan-native path is not enabled.");
     assert(isPowerOf2_32(VF) && "VF needs to be a power of two");
-    LLVM_DEBUG(dbgs() << "LV: Using " << (UserVF ? "user " : "") << "VF " << VF
+
+    // Unless the user picked a VF, cost all widths up to the widest one the
+    // registers allow and take the cheapest per lane. Outer loops are only
+    // vectorized when explicitly requested, so a scalar loop is not an
+    // option here. Predicated plans are not in recipe form yet.
+    bool UseCostModel =
+        !UserVF && !VPlanBuildStressTest && !EnableVPlanPredication && VF > 2;
+    unsigned MinVF = UseCostModel ? 2 : VF;
+    LLVM_DEBUG(dbgs() << "LV: Using " << (UserVF ? "user " : "") << "VF "
+                      << (UseCostModel ? "2 to " : "") << VF
                       << " to build VPlans.\n");
-    buildVPlans(VF, VF);
+    buildVPlans(MinVF, VF);
 
     // For VPlan build stress testing, we bail out after VPlan construction.
     if (VPlanBuildStressTest)
       return VectorizationFactor::Disabled();
 
-    return {VF, 0};
+    if (!UseCostModel)
+      return {VF, 0};
+
+    assert(VPlans.size() == 1 && "Expected one plan for all VFs");
+    VPlan &Plan = *VPlans.front();
+    VectorizationFactor Best = {MinVF, getVPlanNativeCost(Plan, MinVF, *TTI)};
+    LLVM_DEBUG(dbgs() << "LV: VPlan cost for VF " << MinVF << ": "
+                      << Best.Cost << ".\n");
+    for (unsigned Width = MinVF * 2; Width <= VF; Width *= 2) {
+      unsigned Cost = getVPlanNativeCost(Plan, Width, *TTI);
+      LLVM_DEBUG(dbgs() << "LV: VPlan cost for VF " << Width << ": " << Cost
+                        << ".\n");
+      // Compare the costs per lane.
+      if ((uint64_t)Cost * Best.Width < (uint64_t)Best.Cost * Width)
+        Best = {Width, Cost};
+    }
+    LLVM_DEBUG(dbgs() << "LV: VPlan cost model selected VF " << Best.Width
+                      << ".\n");
+    return Best;
   }
 
   LLVM_DEBUG(
@@ -118,6 +118,11 @@ static cl::opt<bool>
 ShouldVectorizeHor("slp-vectorize-hor", cl::init(true), cl::Hidden,
                    cl::desc("Attempt to vectorize horizontal reductions"));
 
+static cl::opt<bool> ShouldVectorizeAcrossBlocks(
+    "slp-vectorize-across-blocks", cl::init(false), cl::Hidden,
+    cl::desc("Attempt to vectorize the operands of an instruction when they "
+             "are defined in a dominating block"));
+
 static cl::opt<bool> ShouldStartVectorizeHorAtStore(
     "slp-vectorize-hor-store", cl::init(false), cl::Hidden,
     cl::desc(
@@ -5424,10 +5429,16 @@ bool SLPVectorizerPass::tryToVectorize(Instruction *I, BoUpSLP &R) {
 
   Value *P = I->getParent();
 
-  // Vectorize in current basic block only.
+  // The operands have to be in one block to form a bundle. Unless
+  // -slp-vectorize-across-blocks is given, that must be I's own block. The
+  // operands' block dominates I, so the vector code placed there reaches I,
+  // and I gets extractelements like any other out-of-tree user.
   auto *Op0 = dyn_cast<Instruction>(I->getOperand(0));
   auto *Op1 = dyn_cast<Instruction>(I->getOperand(1));
-  if (!Op0 || !Op1 || Op0->getParent() != P || Op1->getParent() != P)
+  if (!Op0 || !Op1 || Op0->getParent() != Op1->getParent())
+    return false;
+  BasicBlock *OpBB = Op0->getParent();
+  if (!ShouldVectorizeAcrossBlocks && OpBB != P)
     return false;
 
   // Try to vectorize V.
@@ -5440,9 +5451,9 @@ bool SLPVectorizerPass::tryToVectorize(Instruction *I, BoUpSLP &R) {
   if (B && B->hasOneUse()) {
     auto *B0 = dyn_cast<BinaryOperator>(B->getOperand(0));
     auto *B1 = dyn_cast<BinaryOperator>(B->getOperand(1));
-    if (B0 && B0->getParent() == P && tryToVectorizePair(A, B0, R))
+    if (B0 && B0->getParent() == OpBB && tryToVectorizePair(A, B0, R))
       return true;
-    if (B1 && B1->getParent() == P && tryToVectorizePair(A, B1, R))
+    if (B1 && B1->getParent() == OpBB && tryToVectorizePair(A, B1, R))
       return true;
   }
 
@@ -5450,9 +5461,9 @@ bool SLPVectorizerPass::tryToVectorize(Instruction *I, BoUpSLP &R) {
   if (A && A->hasOneUse()) {
     auto *A0 = dyn_cast<BinaryOperator>(A->getOperand(0));
     auto *A1 = dyn_cast<BinaryOperator>(A->getOperand(1));
-    if (A0 && A0->getParent() == P && tryToVectorizePair(A0, B, R))
+    if (A0 && A0->getParent() == OpBB && tryToVectorizePair(A0, B, R))
       return true;
-    if (A1 && A1->getParent() == P && tryToVectorizePair(A1, B, R))
+    if (A1 && A1->getParent() == OpBB && tryToVectorizePair(A1, B, R))
       return true;
   }
   return false;
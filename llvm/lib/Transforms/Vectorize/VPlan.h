@@ -732,6 +732,11 @@ public:
     return true;
   }
 
+  /// Return the instructions this recipe widens.
+  iterator_range<BasicBlock::iterator> getIngredients() const {
+    return make_range(Begin, End);
+  }
+
   /// Print the recipe.
   void print(raw_ostream &O, const Twine &Indent) const override;
 };
@@ -757,6 +762,9 @@ public:
   /// needed by their users.
   void execute(VPTransformState &State) override;
 
+  /// Return the induction phi.
+  PHINode *getPHI() const { return IV; }
+
   /// Print the recipe.
   void print(raw_ostream &O, const Twine &Indent) const override;
 };
@@ -972,6 +980,9 @@ public:
   /// Generate the wide load/store.
   void execute(VPTransformState &State) override;
 
+  /// Return the load or store this recipe widens.
+  Instruction &getIngredient() const { return Instr; }
+
   /// Print the recipe.
   void print(raw_ostream &O, const Twine &Indent) const override;
 };
@@ -0,0 +1,54 @@
+; RUN: opt < %s -cost-model -analyze -mattr=+simd128 \
+; RUN:   | FileCheck %s --check-prefix=SIMD
+; RUN: opt < %s -cost-model -analyze | FileCheck %s --check-prefix=NOSIMD
+
+; With SIMD128 every whole-vector shuffle of a 128-bit type is a single
+; v8x16.shuffle, so it costs one instruction per legalized vector.
+
+target triple = "wasm32-unknown-unknown"
+
+define void @shuffles(<4 x i32> %a, <4 x i32> %b, <16 x i8> %c,
+                      <8 x i16> %d, <4 x float> %e, <8 x i32> %f) {
+; SIMD-LABEL: 'shuffles'
+; SIMD: cost of 1 for instruction: %broadcast = shufflevector
+; SIMD: cost of 1 for instruction: %reverse = shufflevector
+; SIMD: cost of 1 for instruction: %select = shufflevector
+; SIMD: cost of 1 for instruction: %transpose = shufflevector
+; SIMD: cost of 1 for instruction: %permute = shufflevector
+; SIMD: cost of 1 for instruction: %permute2 = shufflevector
+; SIMD: cost of 1 for instruction: %bytes = shufflevector
+; SIMD: cost of 1 for instruction: %halves = shufflevector
+; SIMD: cost of 1 for instruction: %floats = shufflevector
+; SIMD: cost of 2 for instruction: %wide = shufflevector
+
+; NOSIMD-LABEL: 'shuffles'
+; NOSIMD-NOT: cost of 1 for instruction: %broadcast = shufflevector
+; NOSIMD-NOT: cost of 1 for instruction: %reverse = shufflevector
+; NOSIMD-NOT: cost of 1 for instruction: %permute2 = shufflevector
+  %broadcast = shufflevector <4 x i32> %a, <4 x i32> undef,
+                             <4 x i32> zeroinitializer
+  %reverse = shufflevector <4 x i32> %a, <4 x i32> undef,
+                           <4 x i32> <i32 3, i32 2, i32 1, i32 0>
+  %select = shufflevector <4 x i32> %a, <4 x i32> %b,
+                          <4 x i32> <i32 0, i32 5, i32 2, i32 7>
+  %transpose = shufflevector <4 x i32> %a, <4 x i32> %b,
+                             <4 x i32> <i32 0, i32 4, i32 2, i32 6>
+  %permute = shufflevector <4 x i32> %a, <4 x i32> undef,
+                           <4 x i32> <i32 1, i32 3, i32 0, i32 2>
+  %permute2 = shufflevector <4 x i32> %a, <4 x i32> %b,
+                            <4 x i32> <i32 1, i32 4, i32 7, i32 2>
+  %bytes = shufflevector <16 x i8> %c, <16 x i8> undef,
+                         <16 x i32> <i32 15, i32 14, i32 13, i32 12,
+                                     i32 11, i32 10, i32 9, i32 8,
+                                     i32 7, i32 6, i32 5, i32 4,
+                                     i32 3, i32 2, i32 1, i32 0>
+  %halves = shufflevector <8 x i16> %d, <8 x i16> undef,
+                          <8 x i32> <i32 0, i32 2, i32 4, i32 6,
+                                     i32 1, i32 3, i32 5, i32 7>
+  %floats = shufflevector <4 x float> %e, <4 x float> undef,
+                          <4 x i32> <i32 1, i32 0, i32 3, i32 2>
+  %wide = shufflevector <8 x i32> %f, <8 x i32> undef,
+                        <8 x i32> <i32 7, i32 6, i32 5, i32 4,
+                                   i32 3, i32 2, i32 1, i32 0>
+  ret void
+}
@@ -0,0 +1,28 @@
+; RUN: llc < %s -march=nvptx64 -mcpu=sm_35 -O2 -debug-pass=Structure \
+; RUN:   -o /dev/null 2>&1 | FileCheck %s --check-prefix=DEFAULT
+; RUN: llc < %s -march=nvptx64 -mcpu=sm_35 -O2 -debug-pass=Structure \
+; RUN:   -nvptx-late-load-store-vectorizer -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=LATE
+; RUN: llc < %s -march=nvptx64 -mcpu=sm_35 -O2 -debug-pass=Structure \
+; RUN:   -nvptx-late-load-store-vectorizer -disable-nvptx-load-store-vectorizer \
+; RUN:   -o /dev/null 2>&1 | FileCheck %s --check-prefix=DISABLED
+
+; The load/store vectorizer runs before the straight-line scalar optimizations
+; and LSR, and with -nvptx-late-load-store-vectorizer once more after them.
+
+; DEFAULT:      GPU Load and Store Vectorizer
+; DEFAULT:      Straight line strength reduction
+; DEFAULT:      Loop Strength Reduction
+; DEFAULT-NOT:  GPU Load and Store Vectorizer
+
+; LATE:         GPU Load and Store Vectorizer
+; LATE:         Straight line strength reduction
+; LATE:         Loop Strength Reduction
+; LATE:         GPU Load and Store Vectorizer
+
+; DISABLED-NOT: GPU Load and Store Vectorizer
+
+define void @foo(float* %p) {
+  store float 0.0, float* %p
+  ret void
+}
@@ -0,0 +1,120 @@
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -enable-machine-outliner \
+; RUN:   | FileCheck %s --check-prefix=ONCE
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -enable-machine-outliner \
+; RUN:   -machine-outliner-reruns=1 | FileCheck %s --check-prefix=TWICE
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -enable-machine-outliner \
+; RUN:   -machine-outliner-reruns=5 | FileCheck %s --check-prefix=TWICE
+
+; f1-f3 and f4-f6 are outlined whole in the first round. The stores of 1 to 6
+; are then repeated in OUTLINED_FUNCTION_0 and OUTLINED_FUNCTION_1, which only
+; a second round can outline. A third round finds nothing, so higher rerun
+; counts stop there.
+
+; ONCE-NOT:     OUTLINED_FUNCTION_2_
+
+; TWICE-LABEL:  OUTLINED_FUNCTION_0:
+; TWICE:        {{call|jmp}}{{q?}} OUTLINED_FUNCTION_2_0
+; TWICE-LABEL:  OUTLINED_FUNCTION_1:
+; TWICE:        {{call|jmp}}{{q?}} OUTLINED_FUNCTION_2_0
+; TWICE-LABEL:  OUTLINED_FUNCTION_2_0:
+; TWICE:        movl $1, (%rdi)
+; TWICE:        movl $6, (%rdi)
+; TWICE-NOT:    OUTLINED_FUNCTION_3_
+
+define void @f1(i32* %p) #0 {
+  store volatile i32 11, i32* %p
+  store volatile i32 12, i32* %p
+  store volatile i32 13, i32* %p
+  store volatile i32 14, i32* %p
+  store volatile i32 15, i32* %p
+  store volatile i32 16, i32* %p
+  store volatile i32 1, i32* %p
+  store volatile i32 2, i32* %p
+  store volatile i32 3, i32* %p
+  store volatile i32 4, i32* %p
+  store volatile i32 5, i32* %p
+  store volatile i32 6, i32* %p
+  store volatile i32 21, i32* %p
+  store volatile i32 22, i32* %p
+  store volatile i32 23, i32* %p
+  store volatile i32 24, i32* %p
+  store volatile i32 25, i32* %p
+  store volatile i32 26, i32* %p
+  ret void
+}
+
+define void @f2(i32* %p) #0 {
+  store volatile i32 11, i32* %p
+  store volatile i32 12, i32* %p
+  store volatile i32 13, i32* %p
+  store volatile i32 14, i32* %p
+  store volatile i32 15, i32* %p
+  store volatile i32 16, i32* %p
+  store volatile i32 1, i32* %p
+  store volatile i32 2, i32* %p
+  store volatile i32 3, i32* %p
+  store volatile i32 4, i32* %p
+  store volatile i32 5, i32* %p
+  store volatile i32 6, i32* %p
+  store volatile i32 21, i32* %p
+  store volatile i32 22, i32* %p
+  store volatile i32 23, i32* %p
+  store volatile i32 24, i32* %p
+  store volatile i32 25, i32* %p
+  store volatile i32 26, i32* %p
+  ret void
+}
+
+define void @f3(i32* %p) #0 {
+  store volatile i32 11, i32* %p
+  store volatile i32 12, i32* %p
+  store volatile i32 13, i32* %p
+  store volatile i32 14, i32* %p
+  store volatile i32 15, i32* %p
+  store volatile i32 16, i32* %p
+  store volatile i32 1, i32* %p
+  store volatile i32 2, i32* %p
+  store volatile i32 3, i32* %p
+  store volatile i32 4, i32* %p
+  store volatile i32 5, i32* %p
+  store volatile i32 6, i32* %p
+  store volatile i32 21, i32* %p
+  store volatile i32 22, i32* %p
+  store volatile i32 23, i32* %p
+  store volatile i32 24, i32* %p
+  store volatile i32 25, i32* %p
+  store volatile i32 26, i32* %p
+  ret void
+}
+
+define void @f4(i32* %p) #0 {
+  store volatile i32 1, i32* %p
+  store volatile i32 2, i32* %p
+  store volatile i32 3, i32* %p
+  store volatile i32 4, i32* %p
+  store volatile i32 5, i32* %p
+  store volatile i32 6, i32* %p
+  ret void
+}
+
+define void @f5(i32* %p) #0 {
+  store volatile i32 1, i32* %p
+  store volatile i32 2, i32* %p
+  store volatile i32 3, i32* %p
+  store volatile i32 4, i32* %p
+  store volatile i32 5, i32* %p
+  store volatile i32 6, i32* %p
+  ret void
+}
+
+define void @f6(i32* %p) #0 {
+  store volatile i32 1, i32* %p
+  store volatile i32 2, i32* %p
+  store volatile i32 3, i32* %p
+  store volatile i32 4, i32* %p
+  store volatile i32 5, i32* %p
+  store volatile i32 6, i32* %p
+  ret void
+}
+
+attributes #0 = { noredzone nounwind minsize }
@@ -0,0 +1,113 @@
+; RUN: opt < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx512f,+prefer-256-bit -x86-vector-width -S | FileCheck %s
+; RUN: opt < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx512f,+prefer-256-bit -x86-vector-width -disable-output \
+; RUN:   -pass-remarks=x86-vector-width -pass-remarks-missed=x86-vector-width 2>&1 | FileCheck %s --check-prefix=REMARK
+; RUN: opt < %s -mtriple=x86_64-unknown-linux-gnu -mattr=+avx512f,+prefer-256-bit -x86-vector-width -S \
+; RUN:   -x86-vector-width-min-trip-count=2 | FileCheck %s --check-prefix=LOWTRIP
+
+; The target has 512-bit vectors but prefers 256-bit ones. Only the hot
+; function whose profiled work is in a long-running loop gets 512.
+
+; REMARK: remark: <unknown>:0:0: preferring 512-bit vectors: {{[0-9]+}}% of the profiled instructions are in loops running at least 128 iterations
+; REMARK: remark: <unknown>:0:0: keeping 256-bit vectors: only {{[0-9]+}}% of the profiled instructions are in loops running at least 128 iterations
+; REMARK: remark: <unknown>:0:0: keeping 256-bit vectors: function is not hot
+; REMARK-NOT: remark
+
+; CHECK-LABEL: define void @long_loop(i32* %p) #[[LONG:[0-9]+]] !prof
+; LOWTRIP-LABEL: define void @long_loop(i32* %p) #[[LONG:[0-9]+]] !prof
+define void @long_loop(i32* %p) !prof !15 {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %a = getelementptr inbounds i32, i32* %p, i64 %i
+  %v = load i32, i32* %a
+  %v.inc = add i32 %v, 1
+  store i32 %v.inc, i32* %a
+  %i.next = add nuw nsw i64 %i, 1
+  %c = icmp ult i64 %i.next, 1000
+  br i1 %c, label %loop, label %exit, !prof !16
+
+exit:
+  ret void
+}
+
+; CHECK-LABEL: define void @short_loop(i32* %p) !prof
+; LOWTRIP-LABEL: define void @short_loop(i32* %p) #[[LONG]] !prof
+define void @short_loop(i32* %p) !prof !15 {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %a = getelementptr inbounds i32, i32* %p, i64 %i
+  %v = load i32, i32* %a
+  %v.inc = add i32 %v, 1
+  store i32 %v.inc, i32* %a
+  %i.next = add nuw nsw i64 %i, 1
+  %c = icmp ult i64 %i.next, 4
+  br i1 %c, label %loop, label %exit, !prof !17
+
+exit:
+  ret void
+}
+
+; CHECK-LABEL: define void @cold(i32* %p) !prof
+define void @cold(i32* %p) !prof !18 {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %a = getelementptr inbounds i32, i32* %p, i64 %i
+  store i32 0, i32* %a
+  %i.next = add nuw nsw i64 %i, 1
+  %c = icmp ult i64 %i.next, 1000
+  br i1 %c, label %loop, label %exit, !prof !16
+
+exit:
+  ret void
+}
+
+; An explicit preference is left alone.
+; CHECK-LABEL: define void @explicit(i32* %p) #[[EXPLICIT:[0-9]+]] !prof
+define void @explicit(i32* %p) #0 !prof !15 {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %a = getelementptr inbounds i32, i32* %p, i64 %i
+  store i32 0, i32* %a
+  %i.next = add nuw nsw i64 %i, 1
+  %c = icmp ult i64 %i.next, 1000
+  br i1 %c, label %loop, label %exit, !prof !16
+
+exit:
+  ret void
+}
+
+; CHECK-DAG: attributes #[[LONG]] = { "prefer-vector-width"="512" }
+; CHECK-DAG: attributes #[[EXPLICIT]] = { "prefer-vector-width"="256" }
+
+attributes #0 = { "prefer-vector-width"="256" }
+
+!llvm.module.flags = !{!1}
+!1 = !{i32 1, !"ProfileSummary", !2}
+!2 = !{!3, !4, !5, !6, !7, !8, !9, !10}
+!3 = !{!"ProfileFormat", !"InstrProf"}
+!4 = !{!"TotalCount", i64 10000}
+!5 = !{!"MaxCount", i64 1000}
+!6 = !{!"MaxInternalCount", i64 1}
+!7 = !{!"MaxFunctionCount", i64 1000}
+!8 = !{!"NumCounts", i64 3}
+!9 = !{!"NumFunctions", i64 3}
+!10 = !{!"DetailedSummary", !11}
+!11 = !{!12, !13, !14}
+!12 = !{i32 10000, i64 100, i32 1}
+!13 = !{i32 999000, i64 100, i32 1}
+!14 = !{i32 999999, i64 1, i32 2}
+!15 = !{!"function_entry_count", i64 1000}
+!16 = !{!"branch_weights", i32 999, i32 1}
+!17 = !{!"branch_weights", i32 3, i32 1}
+!18 = !{!"function_entry_count", i64 1}
@@ -0,0 +1,69 @@
+; REQUIRES: asserts
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -verify-machineinstrs \
+; RUN:   -regalloc-greedy-max-evictions=1 -stats -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=BUDGET
+; RUN: llc < %s -mtriple=x86_64-unknown-linux-gnu -verify-machineinstrs \
+; RUN:   -stats -o /dev/null 2>&1 | FileCheck %s --check-prefix=NOBUDGET
+
+; 20 values are live at once in the loop, more than there are registers, so
+; the allocator tries to evict for several of them. With a budget of one
+; eviction attempt, the later live ranges skip eviction and go on to
+; splitting and spilling. The machine verifier checks that the allocation is
+; still complete and correct.
+
+; BUDGET:       {{[0-9]+}} regalloc - Number of eviction attempts skipped over the per-function budget
+; NOBUDGET-NOT: Number of eviction attempts skipped over the per-function budget
+
+define void @pressure(i32* %p, i32* %q, i32 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %a0 = load volatile i32, i32* %p
+  %a1 = load volatile i32, i32* %p
+  %a2 = load volatile i32, i32* %p
+  %a3 = load volatile i32, i32* %p
+  %a4 = load volatile i32, i32* %p
+  %a5 = load volatile i32, i32* %p
+  %a6 = load volatile i32, i32* %p
+  %a7 = load volatile i32, i32* %p
+  %a8 = load volatile i32, i32* %p
+  %a9 = load volatile i32, i32* %p
+  %a10 = load volatile i32, i32* %p
+  %a11 = load volatile i32, i32* %p
+  %a12 = load volatile i32, i32* %p
+  %a13 = load volatile i32, i32* %p
+  %a14 = load volatile i32, i32* %p
+  %a15 = load volatile i32, i32* %p
+  %a16 = load volatile i32, i32* %p
+  %a17 = load volatile i32, i32* %p
+  %a18 = load volatile i32, i32* %p
+  %a19 = load volatile i32, i32* %p
+  store volatile i32 %a0, i32* %q
+  store volatile i32 %a1, i32* %q
+  store volatile i32 %a2, i32* %q
+  store volatile i32 %a3, i32* %q
+  store volatile i32 %a4, i32* %q
+  store volatile i32 %a5, i32* %q
+  store volatile i32 %a6, i32* %q
+  store volatile i32 %a7, i32* %q
+  store volatile i32 %a8, i32* %q
+  store volatile i32 %a9, i32* %q
+  store volatile i32 %a10, i32* %q
+  store volatile i32 %a11, i32* %q
+  store volatile i32 %a12, i32* %q
+  store volatile i32 %a13, i32* %q
+  store volatile i32 %a14, i32* %q
+  store volatile i32 %a15, i32* %q
+  store volatile i32 %a16, i32* %q
+  store volatile i32 %a17, i32* %q
+  store volatile i32 %a18, i32* %q
+  store volatile i32 %a19, i32* %q
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %n
+  br i1 %c, label %loop, label %exit
+
+exit:
+  ret void
+}
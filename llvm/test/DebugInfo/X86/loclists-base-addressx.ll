@@ -0,0 +1,79 @@
+; RUN: llc -mtriple=x86_64-pc-linux -use-dwarf-loclists-base-addressx %s -o - \
+; RUN:   | FileCheck %s --check-prefix=ASM
+; RUN: llc -mtriple=x86_64-pc-linux %s -o - | FileCheck %s --check-prefix=DEFAULT
+; RUN: llc -mtriple=x86_64-pc-linux -use-dwarf-loclists-base-addressx \
+; RUN:   -filetype=obj %s -o %t.o
+; RUN: llvm-dwarfdump -debug-loclists %t.o | FileCheck %s --check-prefix=DUMP
+
+; The functions are in different sections, so the DWARF v5 unit has no base
+; address. With -use-dwarf-loclists-base-addressx the two-entry location list
+; of 'x' starts with a base address and uses offset pairs; by default every
+; entry is a DW_LLE_startx_length.
+
+; ASM-LABEL: .section .debug_loclists
+; ASM:       DW_LLE_base_addressx
+; ASM-NEXT:  base address index
+; ASM-NEXT:  DW_LLE_offset_pair
+; ASM-NEXT:  starting offset
+; ASM-NEXT:  ending offset
+; ASM:       DW_LLE_offset_pair
+; ASM-NEXT:  starting offset
+; ASM-NEXT:  ending offset
+; ASM-NOT:   DW_LLE_startx_length
+; ASM:       DW_LLE_end_of_list
+
+; DEFAULT-LABEL: .section .debug_loclists
+; DEFAULT-NOT:   DW_LLE_base_addressx
+; DEFAULT:       DW_LLE_startx_length
+; DEFAULT:       DW_LLE_startx_length
+; DEFAULT-NOT:   DW_LLE_base_addressx
+; DEFAULT:       DW_LLE_end_of_list
+
+; DUMP:      .debug_loclists contents:
+; DUMP:      0x{{[0-9a-f]+}}:
+; DUMP-NEXT: Base addr idx {{[0-9]+}}
+; DUMP-NEXT: [0x{{[0-9a-f]+}}, 0x{{[0-9a-f]+}}): DW_OP_reg
+; DUMP-NEXT: [0x{{[0-9a-f]+}}, 0x{{[0-9a-f]+}}): DW_OP_reg
+
+define i32 @f(i32 %x) section ".text.f" !dbg !7 {
+entry:
+  call void @llvm.dbg.value(metadata i32 %x, metadata !12, metadata !DIExpression()), !dbg !13
+  %call = call i32 @g(i32 %x), !dbg !14
+  call void @llvm.dbg.value(metadata i32 %call, metadata !12, metadata !DIExpression()), !dbg !13
+  %call1 = call i32 @g(i32 %call), !dbg !15
+  %add = add nsw i32 %call1, 1, !dbg !16
+  ret i32 %add, !dbg !16
+}
+
+define i32 @h() section ".text.h" !dbg !17 {
+entry:
+  ret i32 0, !dbg !18
+}
+
+declare i32 @g(i32)
+
+declare void @llvm.dbg.value(metadata, metadata, metadata)
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!3, !4, !5}
+
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, producer: "clang", isOptimized: true, runtimeVersion: 0, emissionKind: FullDebug, enums: !2)
+!1 = !DIFile(filename: "loclists.c", directory: "/tmp")
+!2 = !{}
+!3 = !{i32 7, !"Dwarf Version", i32 5}
+!4 = !{i32 2, !"Debug Info Version", i32 3}
+!5 = !{i32 1, !"wchar_size", i32 4}
+!7 = distinct !DISubprogram(name: "f", scope: !1, file: !1, line: 2, type: !8, scopeLine: 2, flags: DIFlagPrototyped, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !11)
+!8 = !DISubroutineType(types: !9)
+!9 = !{!10, !10}
+!10 = !DIBasicType(name: "int", size: 32, encoding: DW_ATE_signed)
+!11 = !{!12}
+!12 = !DILocalVariable(name: "x", arg: 1, scope: !7, file: !1, line: 2, type: !10)
+!13 = !DILocation(line: 0, scope: !7)
+!14 = !DILocation(line: 3, column: 7, scope: !7)
+!15 = !DILocation(line: 4, column: 10, scope: !7)
+!16 = !DILocation(line: 4, column: 3, scope: !7)
+!17 = distinct !DISubprogram(name: "h", scope: !1, file: !1, line: 7, type: !19, scopeLine: 7, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !2)
+!18 = !DILocation(line: 7, column: 11, scope: !17)
+!19 = !DISubroutineType(types: !20)
+!20 = !{!10}
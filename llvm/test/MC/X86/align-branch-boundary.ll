@@ -0,0 +1,65 @@
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -filetype=obj \
+; RUN:   -x86-align-branch-boundary < %s \
+; RUN:   | llvm-objdump -d --no-show-raw-insn - | FileCheck %s
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -filetype=obj < %s \
+; RUN:   | llvm-objdump -d --no-show-raw-insn - | FileCheck %s --check-prefix=OFF
+
+; Jumps, calls and returns that cross or end at a 32-byte boundary are pushed
+; past it with nops when -x86-align-branch-boundary is given.
+
+@w = dso_local global i32 0
+@b = dso_local global i8 0
+
+; The stores take 31 bytes, so the ret would end at the boundary.
+; CHECK-LABEL: <ret_at_boundary>:
+; CHECK:       18: movb $3, (%rip)
+; CHECK-NEXT:  1f: nop
+; CHECK-NEXT:  20: retq
+; OFF-LABEL:   <ret_at_boundary>:
+; OFF:         18: movb $3, (%rip)
+; OFF-NEXT:    1f: retq
+define void @ret_at_boundary() nounwind {
+  store volatile i32 1, i32* @w
+  store volatile i8 1, i8* @b
+  store volatile i8 2, i8* @b
+  store volatile i8 3, i8* @b
+  ret void
+}
+
+; The ret ends one byte before the boundary and is left alone.
+; CHECK-LABEL: <ret_before_boundary>:
+; CHECK-NOT:   nop
+; CHECK:       movl $3, (%rip)
+; CHECK-NEXT:  retq
+define void @ret_before_boundary() nounwind {
+  store volatile i32 1, i32* @w
+  store volatile i32 2, i32* @w
+  store volatile i32 3, i32* @w
+  ret void
+}
+
+; Functions can opt out with the "no-code-padding" attribute.
+; CHECK-LABEL: <no_code_padding>:
+; CHECK-NOT:   nop
+; CHECK:       movb $3, (%rip)
+; CHECK-NEXT:  retq
+define void @no_code_padding() nounwind "no-code-padding" {
+  store volatile i32 1, i32* @w
+  store volatile i8 1, i8* @b
+  store volatile i8 2, i8* @b
+  store volatile i8 3, i8* @b
+  ret void
+}
+
+; No padding for -Os either.
+; CHECK-LABEL: <optsize>:
+; CHECK-NOT:   nop
+; CHECK:       movb $3, (%rip)
+; CHECK-NEXT:  retq
+define void @optsize() nounwind optsize {
+  store volatile i32 1, i32* @w
+  store volatile i8 1, i8* @b
+  store volatile i8 2, i8* @b
+  store volatile i8 3, i8* @b
+  ret void
+}
@@ -0,0 +1,12 @@
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @big(i32 %x) {
+  %a = add i32 %x, 1
+  %b = mul i32 %a, 3
+  %c = xor i32 %b, %x
+  %d = add i32 %c, 7
+  %e = mul i32 %d, %a
+  %f = sub i32 %e, %b
+  ret i32 %f
+}
@@ -0,0 +1,27 @@
+; RUN: opt -module-summary %s -o %t1.bc
+; RUN: opt -module-summary %p/Inputs/schedule-by-cost.ll -o %t2.bc
+
+; The module with more instructions is started first, although it comes last
+; on the command line.
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -thinlto-threads=1 \
+; RUN:   -thinlto-report-job-times -r=%t1.bc,small,px -r=%t2.bc,big,px 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=COST
+; COST:      ThinLTO backend jobs in start order
+; COST-NEXT: {{[0-9.]+}}s {{ *}}7 {{.*}}2.bc
+; COST-NEXT: {{[0-9.]+}}s {{ *}}1 {{.*}}1.bc
+
+; -thinlto-schedule-by-cost=false keeps the input order.
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -thinlto-threads=1 \
+; RUN:   -thinlto-report-job-times -thinlto-schedule-by-cost=false \
+; RUN:   -r=%t1.bc,small,px -r=%t2.bc,big,px 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=INPUT
+; INPUT:      ThinLTO backend jobs in start order
+; INPUT-NEXT: {{[0-9.]+}}s {{ *}}1 {{.*}}1.bc
+; INPUT-NEXT: {{[0-9.]+}}s {{ *}}7 {{.*}}2.bc
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @small() {
+  ret void
+}
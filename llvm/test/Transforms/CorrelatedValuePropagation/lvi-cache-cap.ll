@@ -0,0 +1,37 @@
+; REQUIRES: asserts
+; RUN: opt < %s -correlated-propagation -S | FileCheck %s
+; RUN: opt < %s -correlated-propagation -lvi-max-cache-entries=1 -S \
+; RUN:   | FileCheck %s
+; RUN: opt < %s -correlated-propagation -lvi-max-cache-entries=1 -stats \
+; RUN:   -disable-output 2>&1 | FileCheck %s --check-prefix=CAP
+; RUN: opt < %s -correlated-propagation -stats -disable-output 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=NOCAP
+
+; The first query caches the value of %x in two blocks, which is over a cap of
+; one, so the cache is flushed before the second query. That only costs
+; recomputation: both comparisons fold the same way with and without the cap.
+
+; CAP:       {{[0-9]+}} lazy-value-info - Number of times the LVI cache hit its size cap
+; NOCAP-NOT: Number of times the LVI cache hit its size cap
+
+declare void @use(i1)
+
+define void @f(i32 %x) {
+; CHECK-LABEL: @f(
+; CHECK:       then:
+; CHECK-NEXT:    call void @use(i1 true)
+; CHECK-NEXT:    call void @use(i1 false)
+entry:
+  %c = icmp ult i32 %x, 10
+  br i1 %c, label %then, label %else
+
+then:
+  %lt = icmp ult i32 %x, 20
+  call void @use(i1 %lt)
+  %gt = icmp ugt i32 %x, 15
+  call void @use(i1 %gt)
+  ret void
+
+else:
+  ret void
+}
@@ -0,0 +1,35 @@
+; REQUIRES: asserts
+; RUN: opt < %s -attributor -attributor-disable=false -debug-only=attributor \
+; RUN:   -disable-output 2>&1 | FileCheck %s --check-prefix=DEFAULT
+; RUN: opt < %s -attributor -attributor-disable=false -attributor-max-updates=1 \
+; RUN:   -debug-only=attributor -disable-output 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=LIMIT
+
+; The nounwind attribute of @calls_unknown changes in the first iteration, so
+; the one of @calls_caller, which depends on it, is updated in a second one.
+; With -attributor-max-updates=1 the first iteration already uses up the
+; budget, and the fixpoint iteration stops after it. The attributes that were
+; still changing, and the ones depending on them, are then reverted to a
+; pessimistic state.
+
+; DEFAULT:    [Attributor] #Iteration: 1,
+; DEFAULT:    [Attributor] #Iteration: 2,
+; DEFAULT:    [Attributor] Fixpoint iteration done after:
+; DEFAULT-NOT: [Attributor] Finalized
+
+; LIMIT:      [Attributor] #Iteration: 1,
+; LIMIT-NOT:  [Attributor] #Iteration: 2,
+; LIMIT:      [Attributor] Fixpoint iteration done after:
+; LIMIT:      [Attributor] Finalized {{[0-9]+}} abstract attributes.
+
+declare void @unknown()
+
+define void @calls_unknown() {
+  call void @unknown()
+  ret void
+}
+
+define void @calls_caller() {
+  call void @calls_unknown()
+  ret void
+}
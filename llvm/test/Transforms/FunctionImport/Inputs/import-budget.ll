@@ -0,0 +1,15 @@
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+; Three instructions each.
+define i32 @first(i32 %x) {
+  %a = add i32 %x, 1
+  %b = mul i32 %a, 3
+  ret i32 %b
+}
+
+define i32 @second(i32 %x) {
+  %a = add i32 %x, 2
+  %b = mul i32 %a, 5
+  ret i32 %b
+}
@@ -0,0 +1,31 @@
+; RUN: opt -module-summary %s -o %t.bc
+; RUN: opt -module-summary %p/Inputs/import-budget.ll -o %t2.bc
+; RUN: llvm-lto -thinlto -o %t3 %t.bc %t2.bc
+
+; Without a budget both callees are imported.
+; RUN: opt -function-import -print-imports -summary-file %t3.thinlto.bc \
+; RUN:   %t.bc -S 2>&1 | FileCheck %s --check-prefix=ALL
+; ALL-DAG: Import first
+; ALL-DAG: Import second
+
+; A budget of 5 instructions only has room for the first callee. The second is
+; rejected, and reported as such.
+; RUN: opt -function-import -print-imports -print-import-failures \
+; RUN:   -import-module-instr-budget=5 -summary-file %t3.thinlto.bc \
+; RUN:   %t.bc -S 2>&1 | FileCheck %s --check-prefix=BUDGET
+; BUDGET: Missed imports into module
+; BUDGET-NEXT: Reason = BudgetExhausted, Threshold = {{[0-9]+}}, Size = 3
+; BUDGET: Import first
+; BUDGET-NOT: Import second
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @main(i32 %x) {
+  %a = call i32 @first(i32 %x)
+  %b = call i32 @second(i32 %a)
+  ret i32 %b
+}
+
+declare i32 @first(i32)
+declare i32 @second(i32)
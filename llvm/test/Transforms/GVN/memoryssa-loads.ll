@@ -0,0 +1,103 @@
+; RUN: opt < %s -gvn -enable-gvn-memoryssa -verify-memoryssa -S | FileCheck %s
+; RUN: opt < %s -passes=gvn -enable-gvn-memoryssa -verify-memoryssa -S \
+; RUN:   | FileCheck %s
+
+; Load elimination through MemorySSA instead of MemoryDependenceAnalysis.
+
+declare void @clobber()
+
+; The clobbering access is a must-alias store, so its value is forwarded.
+define i32 @store_forward(i32* %p) {
+; CHECK-LABEL: @store_forward(
+; CHECK-NEXT:    store i32 42, i32* %p
+; CHECK-NEXT:    ret i32 42
+  store i32 42, i32* %p
+  %v = load i32, i32* %p
+  ret i32 %v
+}
+
+; Both loads have the same clobber, and the first one dominates the second.
+define i32 @load_reuse(i32* %p, i1 %c) {
+; CHECK-LABEL: @load_reuse(
+; CHECK:         %a = load i32, i32* %p
+; CHECK-NOT:     load
+; CHECK:         %r = add i32 %a, %a
+; CHECK-NEXT:    ret i32 %r
+entry:
+  %a = load i32, i32* %p
+  br i1 %c, label %then, label %exit
+
+then:
+  br label %exit
+
+exit:
+  %b = load i32, i32* %p
+  %r = add i32 %a, %b
+  ret i32 %r
+}
+
+; Both loads have the same clobber, but the first one is only in one
+; predecessor and does not dominate the second.
+define i32 @no_dominating_load_same_clobber(i32* %p, i1 %c) {
+; CHECK-LABEL: @no_dominating_load_same_clobber(
+; CHECK:       then:
+; CHECK-NEXT:    %a = load i32, i32* %p
+; CHECK:       exit:
+; CHECK-NEXT:    %b = load i32, i32* %p
+entry:
+  br i1 %c, label %then, label %exit
+
+then:
+  %a = load i32, i32* %p
+  br label %exit
+
+exit:
+  %b = load i32, i32* %p
+  ret i32 %b
+}
+
+; A load in only one predecessor does not dominate the later load.
+define i32 @no_dominating_load(i32* %p, i1 %c) {
+; CHECK-LABEL: @no_dominating_load(
+; CHECK:       then:
+; CHECK-NEXT:    %a = load i32, i32* %p
+; CHECK:       exit:
+; CHECK-NEXT:    %b = load i32, i32* %p
+entry:
+  br i1 %c, label %then, label %exit
+
+then:
+  %a = load i32, i32* %p
+  call void @clobber()
+  br label %exit
+
+exit:
+  %b = load i32, i32* %p
+  ret i32 %b
+}
+
+; The call may write to %p, so the second load stays.
+define i32 @clobbered(i32* %p) {
+; CHECK-LABEL: @clobbered(
+; CHECK-NEXT:    %a = load i32, i32* %p
+; CHECK-NEXT:    call void @clobber()
+; CHECK-NEXT:    %b = load i32, i32* %p
+; CHECK-NEXT:    %r = add i32 %a, %b
+  %a = load i32, i32* %p
+  call void @clobber()
+  %b = load i32, i32* %p
+  %r = add i32 %a, %b
+  ret i32 %r
+}
+
+; A store of a different type is forwarded through AnalyzeLoadAvailability.
+define i8 @store_forward_narrow(i32* %p) {
+; CHECK-LABEL: @store_forward_narrow(
+; CHECK-NEXT:    store i32 0, i32* %p
+; CHECK-NOT:     load
+; CHECK:         ret i8 0
+  store i32 0, i32* %p
+  %q = bitcast i32* %p to i8*
+  %v = load i8, i8* %q
+  ret i8 %v
+}
@@ -0,0 +1,31 @@
+; REQUIRES: asserts
+; RUN: opt < %s -instcombine -debug-only=instcombine -S 2>&1 \
+; RUN:   | FileCheck %s --check-prefixes=CHECK,DEFAULT
+; RUN: opt < %s -instcombine -instcombine-max-iterations=1 \
+; RUN:   -debug-only=instcombine -S 2>&1 | FileCheck %s --check-prefixes=CHECK,LIMIT
+; RUN: opt < %s -passes=instcombine -instcombine-max-iterations=1 \
+; RUN:   -debug-only=instcombine -S 2>&1 | FileCheck %s --check-prefixes=CHECK,LIMIT
+
+; The first iteration folds the add, so by default a second one runs to
+; confirm the fixpoint. With a limit of 1 the second iteration is skipped.
+; The result is the same, because the first iteration already got there.
+
+; CHECK:          INSTCOMBINE ITERATION #1 on f
+; DEFAULT:        INSTCOMBINE ITERATION #2 on f
+; LIMIT-NOT:      INSTCOMBINE ITERATION #2
+; LIMIT:          [IC] Iteration limit #1 on f reached; stopping before reaching a fixpoint
+; LIMIT-NOT:      INSTCOMBINE ITERATION #2
+
+; CHECK-LABEL: define i32 @f(
+; CHECK-NEXT:    ret i32 %x
+define i32 @f(i32 %x) {
+  %a = add i32 %x, 0
+  ret i32 %a
+}
+
+; -instcombine-verify-fixpoint runs the skipped iteration anyway. It changes
+; nothing here, so the run succeeds.
+; RUN: opt < %s -instcombine -instcombine-max-iterations=1 \
+; RUN:   -instcombine-verify-fixpoint -S | FileCheck %s --check-prefix=VERIFY
+; VERIFY-LABEL: define i32 @f(
+; VERIFY-NEXT:    ret i32 %x
@@ -0,0 +1,49 @@
+; REQUIRES: asserts
+; RUN: opt < %s -basicaa -loop-interchange -loop-interchange-cache-model \
+; RUN:   -debug-only=loop-interchange -pass-remarks=loop-interchange \
+; RUN:   -disable-output 2>&1 | FileCheck %s
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+; for (i = 0; i < 100; ++i)
+;   for (j = 0; j < 100; ++j)
+;     C[j][i] = B[Idx[j]];
+;
+; The load from B moves with both loops in a way SCEV can't describe, so it is
+; charged a whole line in either order. Idx[j] is sequential with j innermost
+; and free with i innermost. C[j][i] costs a line with j innermost and 4 bytes
+; with i innermost.
+
+; CHECK: Cache cost: 132 as is, 68 interchanged
+; CHECK: remark: {{.*}} Loop interchanged with enclosing loop.
+
+define void @indirect(i32* noalias %B, i32* noalias %Idx,
+                      [100 x i32]* noalias %C) {
+entry:
+  br label %for1.header
+
+for1.header:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for1.inc ]
+  br label %for2
+
+for2:
+  %j = phi i64 [ 0, %for1.header ], [ %j.next, %for2 ]
+  %idx.ptr = getelementptr inbounds i32, i32* %Idx, i64 %j
+  %k = load i32, i32* %idx.ptr
+  %k.ext = sext i32 %k to i64
+  %b.ptr = getelementptr inbounds i32, i32* %B, i64 %k.ext
+  %v = load i32, i32* %b.ptr
+  %c.ptr = getelementptr inbounds [100 x i32], [100 x i32]* %C, i64 %j, i64 %i
+  store i32 %v, i32* %c.ptr
+  %j.next = add nuw nsw i64 %j, 1
+  %exitcond = icmp eq i64 %j.next, 100
+  br i1 %exitcond, label %for1.inc, label %for2
+
+for1.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  %exitcond26 = icmp eq i64 %i.next, 100
+  br i1 %exitcond26, label %exit, label %for1.header
+
+exit:
+  ret void
+}
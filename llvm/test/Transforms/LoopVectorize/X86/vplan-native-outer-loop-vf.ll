@@ -0,0 +1,64 @@
+; REQUIRES: asserts
+; RUN: opt < %s -loop-vectorize -enable-vplan-native-path -mtriple=x86_64-unknown-linux-gnu -debug-only=loop-vectorize -S 2>%t.debug | FileCheck %s
+; RUN: FileCheck %s --check-prefix=COST < %t.debug
+
+; Outer loop vectorization without a user VF: the VPlan-native path costs
+; every VF up to the widest that fits the SSE2 registers and picks the
+; cheapest per lane. The i32 arithmetic costs the same at VF 2 and VF 4 and
+; the gathers and scatters scale with the VF, so VF 4 wins.
+;
+; void foo(int *a, int *b, long n) {
+; #pragma clang loop vectorize(enable)
+;   for (long i = 0; i < n; i++) {
+;     int s = a[i];
+;     for (long j = 0; j < 8; j++)
+;       s += b[j] * b[j];
+;     a[i] = s;
+;   }
+; }
+
+; COST: LV: Using VF 2 to 4 to build VPlans.
+; COST: LV: VPlan cost for VF 2: {{[0-9]+}}.
+; COST: LV: VPlan cost for VF 4: {{[0-9]+}}.
+; COST: LV: VPlan cost model selected VF 4.
+
+; CHECK-LABEL: @foo(
+; CHECK: vector.body:
+; CHECK: call <4 x i32> @llvm.masked.gather.v4i32.v4p0i32(
+; CHECK: mul nsw <4 x i32>
+; CHECK: call void @llvm.masked.scatter.v4i32.v4p0i32(
+
+define void @foo(i32* %a, i32* %b, i64 %n) {
+entry:
+  br label %outer
+
+outer:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %outer.latch ]
+  %a.addr = getelementptr inbounds i32, i32* %a, i64 %i
+  %a.i = load i32, i32* %a.addr, align 4
+  br label %inner
+
+inner:
+  %j = phi i64 [ 0, %outer ], [ %j.next, %inner ]
+  %s = phi i32 [ %a.i, %outer ], [ %s.next, %inner ]
+  %b.addr = getelementptr inbounds i32, i32* %b, i64 %j
+  %b.j = load i32, i32* %b.addr, align 4
+  %sq = mul nsw i32 %b.j, %b.j
+  %s.next = add nsw i32 %s, %sq
+  %j.next = add nuw nsw i64 %j, 1
+  %inner.done = icmp eq i64 %j.next, 8
+  br i1 %inner.done, label %outer.latch, label %inner
+
+outer.latch:
+  %s.lcssa = phi i32 [ %s.next, %inner ]
+  store i32 %s.lcssa, i32* %a.addr, align 4
+  %i.next = add nuw nsw i64 %i, 1
+  %outer.done = icmp eq i64 %i.next, %n
+  br i1 %outer.done, label %exit, label %outer, !llvm.loop !0
+
+exit:
+  ret void
+}
+
+!0 = distinct !{!0, !1}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
@@ -0,0 +1,48 @@
+; RUN: opt < %s -instrprof -do-counter-promotion=true -instrprof-atomic-counter-update -S | FileCheck %s
+; RUN: opt < %s -passes=instrprof -do-counter-promotion=true -instrprof-atomic-counter-update -S | FileCheck %s
+
+; With atomic counter updates, counters in the loop are kept in registers and
+; flushed with one atomic add per counter at the loop exit. The counter outside
+; of the loop can't be promoted, so it is updated with an atomic add in place.
+
+$__llvm_profile_raw_version = comdat any
+
+@__llvm_profile_raw_version = constant i64 72057594037927941, comdat
+@__profn_foo = private constant [3 x i8] c"foo"
+
+define void @foo(i32 %n, i32 %m) {
+; CHECK-LABEL: @foo(
+; CHECK-LABEL: entry:
+; CHECK:         atomicrmw add i64* getelementptr inbounds ([3 x i64], [3 x i64]* @__profc_foo, i32 0, i32 0), i64 1 monotonic
+; CHECK-NOT:     @__profc_foo
+; CHECK-LABEL: loop:
+; CHECK-NOT:     @__profc_foo
+; CHECK-LABEL: exit:
+; CHECK-DAG:     atomicrmw add i64* getelementptr inbounds ([3 x i64], [3 x i64]* @__profc_foo, i32 0, i32 1), i64 %{{.*}} seq_cst
+; CHECK-DAG:     atomicrmw add i64* getelementptr inbounds ([3 x i64], [3 x i64]* @__profc_foo, i32 0, i32 2), i64 %{{.*}} seq_cst
+; CHECK-NOT:     @__profc_foo
+; CHECK:         ret void
+entry:
+  call void @llvm.instrprof.increment(i8* getelementptr inbounds ([3 x i8], [3 x i8]* @__profn_foo, i32 0, i32 0), i64 12345, i32 3, i32 0)
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %inc, %latch ]
+  call void @llvm.instrprof.increment(i8* getelementptr inbounds ([3 x i8], [3 x i8]* @__profn_foo, i32 0, i32 0), i64 12345, i32 3, i32 1)
+  %cmp1 = icmp slt i32 %i, %m
+  br i1 %cmp1, label %then, label %latch
+
+then:
+  call void @llvm.instrprof.increment(i8* getelementptr inbounds ([3 x i8], [3 x i8]* @__profn_foo, i32 0, i32 0), i64 12345, i32 3, i32 2)
+  br label %latch
+
+latch:
+  %inc = add nsw i32 %i, 1
+  %cmp = icmp slt i32 %inc, %n
+  br i1 %cmp, label %loop, label %exit
+
+exit:
+  ret void
+}
+
+declare void @llvm.instrprof.increment(i8*, i64, i32, i32)
@@ -0,0 +1,31 @@
+; RUN: opt < %s -pgo-instr-gen -pgo-instr-memcmp-bcmp -S | FileCheck %s
+; RUN: opt < %s -passes=pgo-instr-gen -pgo-instr-memcmp-bcmp -S | FileCheck %s
+; RUN: opt < %s -pgo-instr-gen -S | FileCheck %s --check-prefix=NOCMP
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+; The length of memcmp and bcmp calls is value profiled like the length of
+; memory intrinsics, unless it is a constant.
+
+define i32 @cmp(i8* %a, i8* %b, i64 %n) {
+; CHECK-LABEL: @cmp(
+; CHECK:         call void @llvm.instrprof.value.profile(i8* getelementptr inbounds ([3 x i8], [3 x i8]* @__profn_cmp, i32 0, i32 0), i64 {{[0-9]+}}, i64 %n, i32 1, i32 0)
+; CHECK-NEXT:    %r1 = call i32 @memcmp(i8* %a, i8* %b, i64 %n)
+; CHECK:         call void @llvm.instrprof.value.profile(i8* getelementptr inbounds ([3 x i8], [3 x i8]* @__profn_cmp, i32 0, i32 0), i64 {{[0-9]+}}, i64 %n, i32 1, i32 1)
+; CHECK-NEXT:    %r2 = call i32 @bcmp(i8* %a, i8* %b, i64 %n)
+; CHECK-NOT:     @llvm.instrprof.value.profile
+; CHECK:         %r3 = call i32 @memcmp(i8* %a, i8* %b, i64 16)
+; NOCMP-LABEL: @cmp(
+; NOCMP-NOT:     @llvm.instrprof.value.profile
+entry:
+  %r1 = call i32 @memcmp(i8* %a, i8* %b, i64 %n)
+  %r2 = call i32 @bcmp(i8* %a, i8* %b, i64 %n)
+  %r3 = call i32 @memcmp(i8* %a, i8* %b, i64 16)
+  %s1 = add i32 %r1, %r2
+  %s2 = add i32 %s1, %r3
+  ret i32 %s2
+}
+
+declare i32 @memcmp(i8*, i8*, i64)
+declare i32 @bcmp(i8*, i8*, i64)
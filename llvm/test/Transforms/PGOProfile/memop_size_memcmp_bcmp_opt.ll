@@ -0,0 +1,66 @@
+; RUN: opt < %s -pgo-memop-opt -S | FileCheck %s
+; RUN: opt < %s -passes=pgo-memop-opt -S | FileCheck %s
+; RUN: opt < %s -pgo-memop-opt -pgo-memop-optimize-memcmp-bcmp=false -S | FileCheck %s --check-prefix=NOCMP
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+; Calls to memcmp and bcmp with a hot length are versioned like memory
+; intrinsics, and the results of the versions are merged with a phi.
+
+define i32 @cmp(i8* %a, i8* %b, i64 %n) !prof !0 {
+; CHECK-LABEL: @cmp(
+; CHECK:         switch i64 %n, label %[[DEFAULT:.*]] [
+; CHECK-NEXT:      i64 8, label %[[CASE8:.*]]
+; CHECK-NEXT:    ], !prof
+; CHECK:       [[CASE8]]:
+; CHECK-NEXT:    [[R8:%.*]] = call i32 @memcmp(i8* %a, i8* %b, i64 8)
+; CHECK-NEXT:    br label %[[MERGE:.*]]
+; CHECK:       [[DEFAULT]]:
+; CHECK-NEXT:    %r = call i32 @memcmp(i8* %a, i8* %b, i64 %n)
+; CHECK-NEXT:    br label %[[MERGE]]
+; CHECK:       [[MERGE]]:
+; CHECK-NEXT:    [[PHI:%.*]] = phi i32 [ %r, %[[DEFAULT]] ], [ [[R8]], %[[CASE8]] ]
+; CHECK-NEXT:    ret i32 [[PHI]]
+; NOCMP-LABEL: @cmp(
+; NOCMP-NOT:     switch
+; NOCMP:         ret i32 %r
+entry:
+  %r = call i32 @memcmp(i8* %a, i8* %b, i64 %n), !prof !1
+  ret i32 %r
+}
+
+define i32 @bcmp_two_sizes(i8* %a, i8* %b, i64 %n) !prof !2 {
+; CHECK-LABEL: @bcmp_two_sizes(
+; CHECK:         switch i64 %n, label %[[DEFAULT:.*]] [
+; CHECK-NEXT:      i64 8, label %[[CASE8:.*]]
+; CHECK-NEXT:      i64 4, label %[[CASE4:.*]]
+; CHECK-NEXT:    ], !prof
+; CHECK:       [[CASE8]]:
+; CHECK-NEXT:    [[R8:%.*]] = call i32 @bcmp(i8* %a, i8* %b, i64 8)
+; CHECK-NEXT:    br label %[[MERGE:.*]]
+; CHECK:       [[CASE4]]:
+; CHECK-NEXT:    [[R4:%.*]] = call i32 @bcmp(i8* %a, i8* %b, i64 4)
+; CHECK-NEXT:    br label %[[MERGE]]
+; CHECK:       [[DEFAULT]]:
+; CHECK-NEXT:    %r = call i32 @bcmp(i8* %a, i8* %b, i64 %n)
+; CHECK-NEXT:    br label %[[MERGE]]
+; CHECK:       [[MERGE]]:
+; CHECK-NEXT:    [[PHI:%.*]] = phi i32 [ %r, %[[DEFAULT]] ], [ [[R8]], %[[CASE8]] ], [ [[R4]], %[[CASE4]] ]
+; CHECK-NEXT:    %c = icmp eq i32 [[PHI]], 0
+; NOCMP-LABEL: @bcmp_two_sizes(
+; NOCMP-NOT:     switch
+entry:
+  %r = call i32 @bcmp(i8* %a, i8* %b, i64 %n), !prof !3
+  %c = icmp eq i32 %r, 0
+  %z = zext i1 %c to i32
+  ret i32 %z
+}
+
+declare i32 @memcmp(i8*, i8*, i64)
+declare i32 @bcmp(i8*, i8*, i64)
+
+!0 = !{!"function_entry_count", i64 2000}
+!1 = !{!"VP", i32 1, i64 2000, i64 8, i64 1800, i64 3, i64 200}
+!2 = !{!"function_entry_count", i64 3000}
+!3 = !{!"VP", i32 1, i64 3000, i64 8, i64 1600, i64 4, i64 1200, i64 5, i64 200}
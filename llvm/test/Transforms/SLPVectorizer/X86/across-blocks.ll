@@ -0,0 +1,44 @@
+; RUN: opt < %s -slp-vectorizer -slp-threshold=-100 -S -mtriple=x86_64-unknown-linux-gnu -mcpu=corei7 | FileCheck %s --check-prefix=DEFAULT
+; RUN: opt < %s -slp-vectorizer -slp-threshold=-100 -slp-vectorize-across-blocks -S -mtriple=x86_64-unknown-linux-gnu -mcpu=corei7 | FileCheck %s --check-prefix=ACROSS
+
+; The operands of %s are computed in %entry but only combined in %then.
+; They are only used as a pair when -slp-vectorize-across-blocks is given.
+
+; DEFAULT-LABEL: @operands_in_dominating_block(
+; DEFAULT-NOT:   <2 x double>
+; DEFAULT:       %x0 = fadd double %a0, %b0
+; DEFAULT-NEXT:  %x1 = fadd double %a1, %b1
+; DEFAULT:       then:
+; DEFAULT-NEXT:  %s = fmul double %x0, %x1
+; DEFAULT-NOT:   <2 x double>
+
+; ACROSS-LABEL: @operands_in_dominating_block(
+; ACROSS:       entry:
+; ACROSS:       [[A:%.*]] = load <2 x double>, <2 x double>*
+; ACROSS:       [[B:%.*]] = load <2 x double>, <2 x double>*
+; ACROSS:       [[X:%.*]] = fadd <2 x double> [[A]], [[B]]
+; ACROSS:       then:
+; ACROSS-DAG:   [[X0:%.*]] = extractelement <2 x double> [[X]], i32 0
+; ACROSS-DAG:   [[X1:%.*]] = extractelement <2 x double> [[X]], i32 1
+; ACROSS:       %s = fmul double [[X0]], [[X1]]
+
+define void @operands_in_dominating_block(double* %a, double* %b, double* %out, i1 %c) {
+entry:
+  %a0 = load double, double* %a, align 8
+  %pa1 = getelementptr inbounds double, double* %a, i64 1
+  %a1 = load double, double* %pa1, align 8
+  %b0 = load double, double* %b, align 8
+  %pb1 = getelementptr inbounds double, double* %b, i64 1
+  %b1 = load double, double* %pb1, align 8
+  %x0 = fadd double %a0, %b0
+  %x1 = fadd double %a1, %b1
+  br i1 %c, label %then, label %exit
+
+then:
+  %s = fmul double %x0, %x1
+  store double %s, double* %out, align 8
+  br label %exit
+
+exit:
+  ret void
+}
@@ -0,0 +1,42 @@
+# RUN: llvm-mca -mtriple=riscv64 -mcpu=rocket-rv64 -mattr=+m,+a,+f,+d \
+# RUN:   -instruction-info -iterations=1 < %s | FileCheck %s
+
+add a0, a1, a2
+mul a0, a1, a2
+div a0, a1, a2
+divw a0, a1, a2
+ld a0, 0(a1)
+sd a0, 0(a1)
+amoadd.w a0, a1, (a2)
+fld ft0, 0(a1)
+fadd.s ft0, ft1, ft2
+fadd.d ft0, ft1, ft2
+fmadd.d ft0, ft1, ft2, ft3
+fdiv.s ft0, ft1, ft2
+fsqrt.d ft0, ft1
+beq a0, a1, 0
+
+# CHECK:      [1]    [2]    [3]    [4]    [5]    [6]    Instructions:
+# CHECK-NEXT:  1      1     1.00                        add	a0, a1, a2
+# CHECK-NEXT:  1      4     1.00                        mul	a0, a1, a2
+# CHECK-NEXT:  1      34    34.00                       div	a0, a1, a2
+# CHECK-NEXT:  1      33    33.00                       divw	a0, a1, a2
+# CHECK-NEXT:  1      3     1.00    *                   ld	a0, 0(a1)
+# CHECK-NEXT:  1      1     1.00           *            sd	a0, 0(a1)
+# CHECK-NEXT:  1      3     1.00    *      *            amoadd.w	a0, a1, (a2)
+# CHECK-NEXT:  1      2     1.00    *                   fld	ft0, 0(a1)
+# CHECK-NEXT:  1      4     1.00                        fadd.s	ft0, ft1, ft2
+# CHECK-NEXT:  1      6     1.00                        fadd.d	ft0, ft1, ft2
+# CHECK-NEXT:  1      6     1.00                        fmadd.d	ft0, ft1, ft2, ft3
+# CHECK-NEXT:  1      20    20.00                       fdiv.s	ft0, ft1, ft2
+# CHECK-NEXT:  1      26    26.00                       fsqrt.d	ft0, ft1
+# CHECK-NEXT:  1      1     1.00                        beq	a0, a1, 0
+
+# CHECK:      Resources:
+# CHECK-NEXT: [0]   - RocketUnitALU
+# CHECK-NEXT: [1]   - RocketUnitB
+# CHECK-NEXT: [2]   - RocketUnitFPALU
+# CHECK-NEXT: [3]   - RocketUnitFPDivSqrt
+# CHECK-NEXT: [4]   - RocketUnitIDiv
+# CHECK-NEXT: [5]   - RocketUnitIMul
+# CHECK-NEXT: [6]   - RocketUnitMem
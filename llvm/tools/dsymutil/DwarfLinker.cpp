@@ -430,6 +430,24 @@ static bool isMachOPairedReloc(uint64_t RelocType, uint64_t Arch) {
   }
 }
 
+/// Report \p Warning for \p DMO, or keep it for reportDeferredWarnings() if
+/// warnings are being deferred.
+void DwarfLinker::RelocationManager::reportWarning(const Twine &Warning,
+                                                   const DebugMapObject &DMO) {
+  if (DeferWarnings)
+    DeferredWarnings.push_back(Warning.str());
+  else
+    Linker.reportWarning(Warning, DMO);
+}
+
+void DwarfLinker::RelocationManager::reportDeferredWarnings(
+    const DebugMapObject &DMO) {
+  DeferWarnings = false;
+  for (const std::string &Warning : DeferredWarnings)
+    Linker.reportWarning(Warning, DMO);
+  DeferredWarnings.clear();
+}
+
 /// Iterate over the relocations of the given \p Section and
 /// store the ones that correspond to debug map entries into the
 /// ValidRelocs array.
@@ -439,7 +457,7 @@ void DwarfLinker::RelocationManager::findValidRelocsMachO(
   Expected<StringRef> ContentsOrErr = Section.getContents();
   if (!ContentsOrErr) {
     consumeError(ContentsOrErr.takeError());
-    Linker.reportWarning("error reading section", DMO);
+    reportWarning("error reading section", DMO);
     return;
   }
   DataExtractor Data(*ContentsOrErr, Obj.isLittleEndian(), 0);
@@ -457,16 +475,14 @@ void DwarfLinker::RelocationManager::findValidRelocsMachO(
     if (isMachOPairedReloc(Obj.getAnyRelocationType(MachOReloc),
                            Obj.getArch())) {
       SkipNext = true;
-      Linker.reportWarning("unsupported relocation in debug_info section.",
-                           DMO);
+      reportWarning("unsupported relocation in debug_info section.", DMO);
       continue;
     }
 
     unsigned RelocSize = 1 << Obj.getAnyRelocationLength(MachOReloc);
     uint64_t Offset64 = Reloc.getOffset();
     if ((RelocSize != 4 && RelocSize != 8)) {
-      Linker.reportWarning("unsupported relocation in debug_info section.",
-                           DMO);
+      reportWarning("unsupported relocation in debug_info section.", DMO);
       continue;
     }
     uint32_t Offset = Offset64;
@@ -491,7 +507,7 @@ void DwarfLinker::RelocationManager::findValidRelocsMachO(
       Expected<StringRef> SymbolName = Sym->getName();
       if (!SymbolName) {
         consumeError(SymbolName.takeError());
-        Linker.reportWarning("error getting relocation symbol name.", DMO);
+        reportWarning("error getting relocation symbol name.", DMO);
         continue;
       }
       if (const auto *Mapping = DMO.lookupSymbol(*SymbolName))
@@ -514,7 +530,7 @@ bool DwarfLinker::RelocationManager::findValidRelocs(
   if (auto *MachOObj = dyn_cast<object::MachOObjectFile>(&Obj))
     findValidRelocsMachO(Section, *MachOObj, DMO);
   else
-    Linker.reportWarning(
+    reportWarning(
         Twine("unsupported object file type: ") + Obj.getFileName(), DMO);
 
   if (ValidRelocs.empty())
@@ -2579,6 +2595,28 @@ bool DwarfLinker::link(const DebugMap &Map) {
       Options.TheAccelTableKind = AccelTableKind::Apple;
   }
 
+  // Scanning the relocations only touches per-object state, so when we have
+  // threads to spare do it for all objects at once instead of in the serial
+  // loop below.
+  if (Options.Threads > 1 && LLVM_LIKELY(!Options.Update)) {
+    ThreadPool Pool(std::min<unsigned>(Options.Threads, NumObjects));
+    for (LinkContext &LinkContext : ObjectContexts) {
+      // Paper trail objects are skipped by the serial loop.
+      if (!LinkContext.ObjectFile ||
+          (!LinkContext.DMO.getWarnings().empty() && LinkContext.DMO.empty()))
+        continue;
+      // Warnings are emitted by the serial loop, so that they still come out
+      // in object order and don't interleave.
+      LinkContext.ScannedRelocs = true;
+      LinkContext.RelocMgr.deferWarnings();
+      Pool.async([&LinkContext]() {
+        LinkContext.RelocMgr.findValidRelocsInDebugInfo(
+            *LinkContext.ObjectFile, LinkContext.DMO);
+      });
+    }
+    Pool.wait();
+  }
+
   for (LinkContext &LinkContext : ObjectContexts) {
     if (Options.Verbose)
       outs() << "DEBUG MAP OBJECT: " << LinkContext.DMO.getObjectFilename()
@@ -2627,10 +2665,14 @@ bool DwarfLinker::link(const DebugMap &Map) {
       continue;
 
     // Look for relocations that correspond to debug map entries.
+    if (LinkContext.ScannedRelocs)
+      LinkContext.RelocMgr.reportDeferredWarnings(LinkContext.DMO);
 
     if (LLVM_LIKELY(!Options.Update) &&
-        !LinkContext.RelocMgr.findValidRelocsInDebugInfo(
-            *LinkContext.ObjectFile, LinkContext.DMO)) {
+        !(LinkContext.ScannedRelocs
+              ? LinkContext.RelocMgr.hasValidRelocs()
+              : LinkContext.RelocMgr.findValidRelocsInDebugInfo(
+                    *LinkContext.ObjectFile, LinkContext.DMO))) {
       if (Options.Verbose)
         outs() << "No valid relocations found. Skipping.\n";
 
@@ -108,11 +108,24 @@ private:
     /// cheap lookup during the root DIE selection and during DIE cloning.
     unsigned NextValidReloc = 0;
 
+    /// Warnings found while the relocations were scanned on a worker thread.
+    std::vector<std::string> DeferredWarnings;
+    bool DeferWarnings = false;
+
+    void reportWarning(const Twine &Warning, const DebugMapObject &DMO);
+
   public:
     RelocationManager(DwarfLinker &Linker) : Linker(Linker) {}
 
     bool hasValidRelocs() const { return !ValidRelocs.empty(); }
 
+    /// Keep warnings instead of printing them until reportDeferredWarnings()
+    /// is called.
+    void deferWarnings() { DeferWarnings = true; }
+
+    /// Print the warnings kept since deferWarnings() and stop deferring.
+    void reportDeferredWarnings(const DebugMapObject &DMO);
+
     /// Reset the NextValidReloc counter.
     void resetValidRelocs() { NextValidReloc = 0; }
 
@@ -147,6 +160,8 @@ private:
     std::unique_ptr<DWARFContext> DwarfContext;
     RangesTy Ranges;
     UnitListTy CompileUnits;
+    /// Whether RelocMgr was already filled in ahead of the serial loop.
+    bool ScannedRelocs = false;
 
     LinkContext(const DebugMap &Map, DwarfLinker &Linker, DebugMapObject &DMO)
         : DMO(DMO), RelocMgr(Linker) {
@@ -28,6 +28,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <list>
 #include <map>
@@ -865,9 +866,12 @@ static std::unique_ptr<LTO> createLTO(IndexWriteCallback OnIndexWrite,
   if (options::thinlto_index_only) {
     std::string OldPrefix, NewPrefix;
     getThinLTOOldAndNewPrefix(OldPrefix, NewPrefix);
+    unsigned Jobs = options::Parallelism ? options::Parallelism
+                                         : heavyweight_hardware_concurrency();
     Backend = createWriteIndexesThinBackend(OldPrefix, NewPrefix,
                                             options::thinlto_emit_imports_files,
-                                            LinkedObjectsFile, OnIndexWrite);
+                                            LinkedObjectsFile, OnIndexWrite,
+                                            Jobs);
   }
 
   Conf.OverrideTriple = options::triple;
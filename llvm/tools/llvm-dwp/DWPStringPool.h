@@ -4,6 +4,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/MC/MCSection.h"
 #include "llvm/MC/MCStreamer.h"
+#include "llvm/Support/StringSaver.h"
 #include <cassert>
 
 namespace llvm {
@@ -34,6 +35,10 @@ class DWPStringPool {
   MCSection *Sec;
   DenseMap<const char *, uint32_t, CStrDenseMapInfo> Pool;
   uint32_t Offset = 0;
+  // Owns the keys of Pool, so the inputs the strings came from can be
+  // released as soon as they are processed.
+  BumpPtrAllocator Alloc;
+  StringSaver Saver{Alloc};
 
 public:
   DWPStringPool(MCStreamer &Out, MCSection *Sec) : Out(Out), Sec(Sec) {}
@@ -41,14 +46,17 @@ public:
   uint32_t getOffset(const char *Str, unsigned Length) {
     assert(strlen(Str) + 1 == Length && "Ensure length hint is correct");
 
-    auto Pair = Pool.insert(std::make_pair(Str, Offset));
-    if (Pair.second) {
-      Out.SwitchSection(Sec);
-      Out.EmitBytes(StringRef(Str, Length));
-      Offset += Length;
-    }
+    auto I = Pool.find(Str);
+    if (I != Pool.end())
+      return I->second;
 
-    return Pair.first->second;
+    StringRef Saved = Saver.save(StringRef(Str, Length - 1));
+    Pool.insert(std::make_pair(Saved.data(), Offset));
+    Out.SwitchSection(Sec);
+    Out.EmitBytes(StringRef(Saved.data(), Length));
+    uint32_t StrOffset = Offset;
+    Offset += Length;
+    return StrOffset;
   }
 };
 }
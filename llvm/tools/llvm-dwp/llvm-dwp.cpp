@@ -526,18 +526,18 @@ static Error write(MCStreamer &Out, ArrayRef<std::string> Inputs) {
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
-  std::deque<SmallString<32>> UncompressedSections;
-
   for (const auto &Input : Inputs) {
+    // Everything that outlives this iteration is copied out of the input (the
+    // streamer copies emitted bytes and the string pool saves its strings),
+    // so each input and its decompressed sections are released before the
+    // next one is opened. This bounds memory use by the output rather than by
+    // the sum of all inputs.
     auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
     if (!ErrOrObj)
       return ErrOrObj.takeError();
 
     auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+    std::deque<SmallString<32>> UncompressedSections;
 
     UnitIndexEntry CurEntry = {};
 
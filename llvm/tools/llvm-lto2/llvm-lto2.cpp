@@ -23,6 +23,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/Threading.h"
 
@@ -49,6 +50,12 @@ static cl::opt<std::string> OutputFilename("o", cl::Required,
 static cl::opt<std::string> CacheDir("cache-dir", cl::desc("Cache Directory"),
                                      cl::value_desc("directory"));
 
+static cl::opt<std::string> RemoteCacheDir(
+    "remote-cache-dir",
+    cl::desc("Directory used as the remote cache behind -cache-dir, such as "
+             "a directory on a shared file system"),
+    cl::value_desc("directory"));
+
 static cl::opt<std::string> OptPipeline("opt-pipeline",
                                         cl::desc("Optimizer Pipeline"),
                                         cl::value_desc("pipeline"));
@@ -169,6 +176,57 @@ static int usage() {
   return 1;
 }
 
+// Returns callbacks that use -remote-cache-dir as a remote cache, or no
+// callbacks if the option is not given.
+static lto::RemoteCache createRemoteCache() {
+  lto::RemoteCache Remote;
+  if (RemoteCacheDir.empty())
+    return Remote;
+  check(sys::fs::create_directories(RemoteCacheDir),
+        "failed to create remote cache");
+
+  auto getEntryPath = [](StringRef Key) {
+    SmallString<64> Path;
+    sys::path::append(Path, RemoteCacheDir, "llvmcache-" + Key);
+    return Path;
+  };
+
+  Remote.Fetch = [=](StringRef Key) -> std::unique_ptr<MemoryBuffer> {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+        MemoryBuffer::getFile(getEntryPath(Key), /*FileSize=*/-1,
+                              /*RequiresNullTerminator=*/false);
+    if (!MBOrErr)
+      return nullptr;
+    return std::move(*MBOrErr);
+  };
+
+  // Write to a temporary file and rename it, so that a concurrent Fetch never
+  // sees a partially written object.
+  Remote.Store = [=](StringRef Key, MemoryBufferRef Object) {
+    SmallString<64> TempFilenameModel;
+    sys::path::append(TempFilenameModel, RemoteCacheDir, "Thin-%%%%%%.tmp.o");
+    Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+        TempFilenameModel, sys::fs::owner_read | sys::fs::owner_write);
+    if (!Temp) {
+      consumeError(Temp.takeError());
+      return;
+    }
+    raw_fd_ostream OS(Temp->FD, /*ShouldClose=*/false);
+    OS << Object.getBuffer();
+    OS.flush();
+    if (OS.has_error()) {
+      OS.clear_error();
+      consumeError(Temp->discard());
+      return;
+    }
+    if (Error E = Temp->keep(getEntryPath(Key))) {
+      consumeError(std::move(E));
+      consumeError(Temp->discard());
+    }
+  };
+  return Remote;
+}
+
 static int run(int argc, char **argv) {
   cl::ParseCommandLineOptions(argc, argv, "Resolution-based LTO test harness");
 
@@ -277,7 +335,7 @@ static int run(int argc, char **argv) {
                                             /* NewPrefix */ "",
                                             /* ShouldEmitImportsFiles */ true,
                                             /* LinkedObjectsFile */ nullptr,
-                                            /* OnWrite */ {});
+                                            /* OnWrite */ {}, Threads);
   else
     Backend = createInProcessThinBackend(Threads);
   LTO Lto(std::move(Conf), std::move(Backend));
@@ -336,7 +394,8 @@ static int run(int argc, char **argv) {
 
   NativeObjectCache Cache;
   if (!CacheDir.empty())
-    Cache = check(localCache(CacheDir, AddBuffer), "failed to create cache");
+    Cache = check(localCache(CacheDir, AddBuffer, createRemoteCache()),
+                  "failed to create cache");
 
   check(Lto.run(AddStream, Cache), "LTO::run failed");
   return 0;
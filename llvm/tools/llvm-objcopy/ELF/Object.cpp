@@ -20,6 +20,7 @@
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileOutputBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include <algorithm>
 #include <cstddef>
@@ -432,13 +433,24 @@ void ELFSectionWriter<ELFT>::visit(const DecompressedSection &Sec) {
 
   SmallVector<char, 128> DecompressedContent;
   if (Error E = zlib::uncompress(CompressedContent, DecompressedContent,
-                                 static_cast<size_t>(Sec.Size)))
-    reportError(Sec.Name, std::move(E));
+                                 static_cast<size_t>(Sec.Size))) {
+    std::lock_guard<std::mutex> Lock(ErrorsMutex);
+    Errors.emplace(Sec.Index,
+                   std::make_pair(StringRef(Sec.Name), std::move(E)));
+    return;
+  }
 
   uint8_t *Buf = Out.getBufferStart() + Sec.Offset;
   std::copy(DecompressedContent.begin(), DecompressedContent.end(), Buf);
 }
 
+template <class ELFT> void ELFSectionWriter<ELFT>::checkErrors() {
+  if (Errors.empty())
+    return;
+  auto &First = Errors.begin()->second;
+  reportError(First.first, std::move(First.second));
+}
+
 void BinarySectionWriter::visit(const DecompressedSection &Sec) {
   error("cannot write compressed section '" + Sec.Name + "' ");
 }
@@ -1758,12 +1770,21 @@ template <class ELFT> void ELFWriter<ELFT>::writeShdrs() {
 }
 
 template <class ELFT> void ELFWriter<ELFT>::writeSectionData() {
-  for (SectionBase &Sec : Obj.sections())
-    // Segments are responsible for writing their contents, so only write the
-    // section data if the section is not in a segment. Note that this renders
-    // sections in segments effectively immutable.
+  // Segments are responsible for writing their contents, so only write the
+  // section data if the section is not in a segment. Note that this renders
+  // sections in segments effectively immutable.
+  std::vector<const SectionBase *> ToWrite;
+  for (const SectionBase &Sec : Obj.sections())
     if (Sec.ParentSegment == nullptr)
-      Sec.accept(*SecWriter);
+      ToWrite.push_back(&Sec);
+
+  // Sections outside of segments are laid out at disjoint offsets, and the
+  // section writers only touch their own section's bytes, so the sections can
+  // be written concurrently. This mostly helps with large debug sections that
+  // are copied or decompressed.
+  parallel::for_each(parallel::par, ToWrite.begin(), ToWrite.end(),
+                     [&](const SectionBase *Sec) { Sec->accept(*SecWriter); });
+  SecWriter->checkErrors();
 }
 
 template <class ELFT> void ELFWriter<ELFT>::writeSegmentData() {
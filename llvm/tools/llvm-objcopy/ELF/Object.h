@@ -22,7 +22,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -142,7 +144,17 @@ public:
   void visit(const CompressedSection &Sec) override;
   void visit(const DecompressedSection &Sec) override;
 
+  // Reports the error of the section with the lowest index, if any section
+  // failed to be written.
+  void checkErrors();
+
   explicit ELFSectionWriter(Buffer &Buf) : SectionWriter(Buf) {}
+
+private:
+  // Sections may be written on worker threads, which must not call
+  // reportError(). Errors are kept here by section index instead.
+  std::mutex ErrorsMutex;
+  std::map<uint32_t, std::pair<StringRef, Error>> Errors;
 };
 
 template <class ELFT> class ELFSectionSizer : public MutableSectionVisitor {
@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -226,6 +228,92 @@ static void overlapInput(const std::string &BaseFilename,
   }
 }
 
+/// Record \p E, hit while reading \p Filename, as the pending hard error of
+/// \p WC unless it already has one.
+static void setLoadError(WriterContext *WC, Error E, StringRef Filename) {
+  std::unique_lock<std::mutex> CtxGuard{WC->Lock};
+  if (WC->Err) {
+    consumeError(std::move(E));
+    return;
+  }
+  WC->Err = std::move(E);
+  WC->ErrWhence = Filename;
+}
+
+/// Load an input, adding each function to the shard picked by a hash of its
+/// name. Every shard holds a disjoint set of functions, so the memory used
+/// does not grow with the number of threads and the shards never need to be
+/// merged record by record. File-level errors are reported through the first
+/// shard.
+static void loadInputSharded(const WeightedFile &Input,
+                             SymbolRemapper *Remapper,
+                             ArrayRef<std::unique_ptr<WriterContext>> Shards) {
+  WriterContext *FileWC = Shards[0].get();
+  {
+    // If there's a pending hard error, don't do more work.
+    std::unique_lock<std::mutex> CtxGuard{FileWC->Lock};
+    if (FileWC->Err)
+      return;
+  }
+
+  auto ReaderOrErr = InstrProfReader::create(Input.Filename);
+  if (Error E = ReaderOrErr.takeError()) {
+    // Skip the empty profiles by returning sliently.
+    instrprof_error IPE = InstrProfError::take(std::move(E));
+    if (IPE != instrprof_error::empty_raw_profile)
+      setLoadError(FileWC, make_error<InstrProfError>(IPE), Input.Filename);
+    return;
+  }
+
+  auto Reader = std::move(ReaderOrErr.get());
+  bool IsIRProfile = Reader->isIRLevelProfile();
+  bool HasCSIRProfile = Reader->hasCSIRLevelProfile();
+  for (const std::unique_ptr<WriterContext> &WC : Shards) {
+    std::unique_lock<std::mutex> CtxGuard{WC->Lock};
+    if (Error E =
+            WC->Writer.setIsIRLevelProfile(IsIRProfile, HasCSIRProfile)) {
+      consumeError(std::move(E));
+      CtxGuard.unlock();
+      setLoadError(FileWC,
+                   make_error<StringError>(
+                       "Merge IR generated profile with Clang generated "
+                       "profile.",
+                       std::error_code()),
+                   Input.Filename);
+      return;
+    }
+  }
+
+  for (auto &I : *Reader) {
+    if (Remapper)
+      I.Name = (*Remapper)(I.Name);
+    const StringRef FuncName = I.Name;
+    WriterContext *WC = Shards[hash_value(FuncName) % Shards.size()].get();
+    std::unique_lock<std::mutex> CtxGuard{WC->Lock};
+    bool Reported = false;
+    WC->Writer.addRecord(std::move(I), Input.Weight, [&](Error E) {
+      if (Reported) {
+        consumeError(std::move(E));
+        return;
+      }
+      Reported = true;
+      // Only show hint the first time an error occurs.
+      instrprof_error IPE = InstrProfError::take(std::move(E));
+      std::unique_lock<std::mutex> ErrGuard{WC->ErrLock};
+      bool firstTime = WC->WriterErrorCodes.insert(IPE).second;
+      handleMergeWriterError(make_error<InstrProfError>(IPE), Input.Filename,
+                             FuncName, firstTime);
+    });
+  }
+  if (Reader->hasError()) {
+    if (Error E = Reader->getError()) {
+      instrprof_error IPE = InstrProfError::take(std::move(E));
+      if (isFatalError(IPE))
+        setLoadError(FileWC, make_error<InstrProfError>(IPE), Input.Filename);
+    }
+  }
+}
+
 /// Load an input into a writer context.
 static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
                       WriterContext *WC) {
@@ -325,9 +413,12 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
     NumThreads =
         std::min(hardware_concurrency(), unsigned((Inputs.size() + 1) / 2));
 
-  // Initialize the writer contexts.
+  // Initialize the writer contexts. With several threads, the contexts are
+  // shards of the function name space rather than per-thread copies of the
+  // whole profile; use more shards than threads to keep lock contention low.
+  unsigned NumContexts = NumThreads == 1 ? 1 : NumThreads * 4;
   SmallVector<std::unique_ptr<WriterContext>, 4> Contexts;
-  for (unsigned I = 0; I < NumThreads; ++I)
+  for (unsigned I = 0; I < NumContexts; ++I)
     Contexts.emplace_back(llvm::make_unique<WriterContext>(
         OutputSparse, ErrorLock, WriterErrorCodes));
 
@@ -338,30 +429,20 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
     ThreadPool Pool(NumThreads);
 
     // Load the inputs in parallel (N/NumThreads serial steps).
-    unsigned Ctx = 0;
-    for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Remapper, Contexts[Ctx].get());
-      Ctx = (Ctx + 1) % NumThreads;
-    }
+    ArrayRef<std::unique_ptr<WriterContext>> Shards = Contexts;
+    for (const auto &Input : Inputs)
+      Pool.async(loadInputSharded, Input, Remapper, Shards);
     Pool.wait();
 
-    // Merge the writer contexts together (~ lg(NumThreads) serial steps).
-    unsigned Mid = Contexts.size() / 2;
-    unsigned End = Contexts.size();
-    assert(Mid > 0 && "Expected more than one context");
-    do {
-      for (unsigned I = 0; I < Mid; ++I)
-        Pool.async(mergeWriterContexts, Contexts[I].get(),
-                   Contexts[I + Mid].get());
-      Pool.wait();
-      if (End & 1) {
-        Pool.async(mergeWriterContexts, Contexts[0].get(),
-                   Contexts[End - 1].get());
-        Pool.wait();
-      }
-      End = Mid;
-      Mid /= 2;
-    } while (Mid > 0);
+    // The shards are disjoint, so this only moves the records over. Free
+    // each shard as soon as it has been merged so that peak memory stays
+    // close to one copy of the merged profile. Load errors are only ever
+    // recorded in the first shard, so nothing is lost.
+    for (unsigned I = 1; I < NumContexts; ++I) {
+      mergeWriterContexts(Contexts[0].get(), Contexts[I].get());
+      Contexts[I].reset();
+    }
+    Contexts.resize(1);
   }
 
   // Handle deferred hard errors encountered during merging.
@@ -0,0 +1,160 @@
+//===- llvm/unittest/ADT/FlatHashMapTest.cpp - FlatHashMap unit tests -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/FlatHashMap.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+TEST(FlatHashMapTest, EmptyMap) {
+  FlatHashMap<int, int> M;
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ(0u, M.size());
+  EXPECT_TRUE(M.begin() == M.end());
+  EXPECT_EQ(0u, M.count(0));
+  EXPECT_TRUE(M.find(0) == M.end());
+  EXPECT_EQ(0, M.lookup(0));
+  EXPECT_FALSE(M.erase(0));
+  M.clear();
+  EXPECT_TRUE(M.empty());
+}
+
+TEST(FlatHashMapTest, InsertFindErase) {
+  FlatHashMap<int, int> M;
+  EXPECT_TRUE(M.insert({1, 10}).second);
+  EXPECT_FALSE(M.insert({1, 20}).second);
+  EXPECT_EQ(10, M.lookup(1));
+  EXPECT_TRUE(M.try_emplace(2, 20).second);
+  M[3] = 30;
+  EXPECT_EQ(3u, M.size());
+  EXPECT_EQ(30, M.find(3)->second);
+
+  EXPECT_TRUE(M.erase(1));
+  EXPECT_FALSE(M.erase(1));
+  EXPECT_EQ(0u, M.count(1));
+  M.erase(M.find(2));
+  EXPECT_EQ(1u, M.size());
+  EXPECT_EQ(30, M.lookup(3));
+}
+
+// DenseMap reserves the empty and tombstone keys, FlatHashMap doesn't.
+TEST(FlatHashMapTest, AllKeysUsable) {
+  FlatHashMap<unsigned, int> M;
+  M[DenseMapInfo<unsigned>::getEmptyKey()] = 1;
+  M[DenseMapInfo<unsigned>::getTombstoneKey()] = 2;
+  EXPECT_EQ(1, M.lookup(DenseMapInfo<unsigned>::getEmptyKey()));
+  EXPECT_EQ(2, M.lookup(DenseMapInfo<unsigned>::getTombstoneKey()));
+}
+
+TEST(FlatHashMapTest, Iteration) {
+  FlatHashMap<int, int> M;
+  for (int I = 0; I < 100; ++I)
+    M[I] = I * 2;
+  std::map<int, int> Seen;
+  for (const auto &KV : M)
+    EXPECT_TRUE(Seen.insert({KV.first, KV.second}).second);
+  EXPECT_EQ(100u, Seen.size());
+  for (const auto &KV : Seen)
+    EXPECT_EQ(KV.first * 2, KV.second);
+
+  const FlatHashMap<int, int> &CM = M;
+  FlatHashMap<int, int>::const_iterator CI = M.begin();
+  EXPECT_TRUE(CI == CM.begin());
+}
+
+TEST(FlatHashMapTest, Reserve) {
+  FlatHashMap<int, int> M(1000);
+  size_t Size = M.getMemorySize();
+  for (int I = 0; I < 1000; ++I)
+    M[I] = I;
+  EXPECT_EQ(Size, M.getMemorySize());
+}
+
+TEST(FlatHashMapTest, CopyAndMove) {
+  FlatHashMap<int, std::string> M;
+  for (int I = 0; I < 50; ++I)
+    M[I] = std::to_string(I);
+
+  FlatHashMap<int, std::string> Copy(M);
+  EXPECT_EQ(50u, Copy.size());
+  EXPECT_EQ("42", Copy.lookup(42));
+
+  FlatHashMap<int, std::string> Moved(std::move(Copy));
+  EXPECT_EQ(50u, Moved.size());
+  EXPECT_EQ("7", Moved.lookup(7));
+
+  Copy = Moved;
+  Moved.clear();
+  EXPECT_TRUE(Moved.empty());
+  EXPECT_EQ("13", Copy.lookup(13));
+}
+
+TEST(FlatHashMapTest, DestroysValues) {
+  auto Shared = std::make_shared<int>(0);
+  {
+    FlatHashMap<int, std::shared_ptr<int>> M;
+    for (int I = 0; I < 100; ++I)
+      M[I] = Shared;
+    EXPECT_EQ(101, Shared.use_count());
+    for (int I = 0; I < 50; ++I)
+      M.erase(I);
+    EXPECT_EQ(51, Shared.use_count());
+  }
+  EXPECT_EQ(1, Shared.use_count());
+}
+
+// Mix of inserts and erases, checked against std::map. Many erases leave
+// tombstones behind, which insertions must reuse or rehash away.
+TEST(FlatHashMapTest, RandomOperations) {
+  std::mt19937 Rand(0);
+  FlatHashMap<unsigned, unsigned> M;
+  std::map<unsigned, unsigned> Ref;
+  for (unsigned I = 0; I < 100000; ++I) {
+    unsigned Key = Rand() % 2000;
+    if (Rand() % 3 == 0) {
+      EXPECT_EQ(Ref.erase(Key) == 1, M.erase(Key));
+    } else {
+      auto R = Ref.insert({Key, I});
+      EXPECT_EQ(R.second, M.insert({Key, I}).second);
+    }
+  }
+  EXPECT_EQ(Ref.size(), M.size());
+  for (const auto &KV : Ref)
+    EXPECT_EQ(KV.second, M.lookup(KV.first));
+  unsigned Count = 0;
+  for (const auto &KV : M) {
+    EXPECT_EQ(Ref[KV.first], KV.second);
+    ++Count;
+  }
+  EXPECT_EQ(Ref.size(), Count);
+}
+
+// Keys that all share a hash still work, though slowly.
+struct CollidingInfo {
+  static unsigned getHashValue(int) { return 0; }
+  static bool isEqual(int LHS, int RHS) { return LHS == RHS; }
+};
+
+TEST(FlatHashMapTest, Collisions) {
+  FlatHashMap<int, int, CollidingInfo> M;
+  for (int I = 0; I < 200; ++I)
+    M[I] = I;
+  for (int I = 0; I < 200; I += 2)
+    M.erase(I);
+  EXPECT_EQ(100u, M.size());
+  for (int I = 0; I < 200; ++I)
+    EXPECT_EQ(I % 2, int(M.count(I)));
+}
+
+} // namespace
@@ -9,6 +9,8 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
+#include <thread>
+#include <vector>
 using namespace llvm;
 
 using OptionalStatistic = Optional<std::pair<StringRef, unsigned>>;
@@ -17,6 +19,9 @@ namespace {
 #define DEBUG_TYPE "unittest"
 STATISTIC(Counter, "Counts things");
 STATISTIC(Counter2, "Counts other things");
+ALWAYS_ON_STATISTIC(AlwaysOnCounter, "Counts things in release builds");
+ALWAYS_ON_STATISTIC(NumTimed, "Counts timed scopes");
+ALWAYS_ON_STATISTIC(TimedNS, "Estimated time in timed scopes");
 
 #if LLVM_ENABLE_STATS
 static void
@@ -156,4 +161,47 @@ TEST(StatisticTest, API) {
 #endif
 }
 
+TEST(StatisticTest, AlwaysOn) {
+  uint64_t Start = AlwaysOnCounter.getValue();
+  ++AlwaysOnCounter;
+  AlwaysOnCounter += 2;
+  EXPECT_EQ(Start + 3, AlwaysOnCounter.getValue());
+
+  // Threads count into their own slots; getValue() sums them up, including
+  // those of threads that have exited.
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I < 4; ++I)
+    Threads.emplace_back([] {
+      for (unsigned J = 0; J < 1000; ++J)
+        ++AlwaysOnCounter;
+    });
+  for (std::thread &T : Threads)
+    T.join();
+  EXPECT_EQ(Start + 4003, AlwaysOnCounter.getValue());
+
+  ResetStatistics();
+  EXPECT_EQ(0u, AlwaysOnCounter.getValue());
+  ++AlwaysOnCounter;
+  EXPECT_EQ(1u, AlwaysOnCounter.getValue());
+
+  std::string JSON;
+  raw_string_ostream OS(JSON);
+  PrintStatisticsJSON(OS);
+  EXPECT_NE(OS.str().find("\"unittest.AlwaysOnCounter\": 1"),
+            std::string::npos);
+}
+
+TEST(StatisticTest, SampledScopedTimer) {
+  uint64_t Start = NumTimed.getValue();
+  for (unsigned I = 0; I < 10; ++I)
+    SampledScopedTimer T(NumTimed, TimedNS, /*SampleRate=*/1);
+  EXPECT_EQ(Start + 10, NumTimed.getValue());
+  EXPECT_NE(0u, TimedNS.getValue());
+
+  // With a high sample rate, few of the entries are timed but all are counted.
+  for (unsigned I = 0; I < 1000; ++I)
+    SampledScopedTimer T(NumTimed, TimedNS);
+  EXPECT_EQ(Start + 1010, NumTimed.getValue());
+}
+
 } // end anonymous namespace
@@ -1583,3 +1583,32 @@ TEST_F(MemorySSATest, TestAddedEdgeToBlockWithNoPhiAddNewPhis) {
   MemoryPhi *MPE = MSSA.getMemoryAccess(EBlock);
   EXPECT_EQ(MPD, MPE->getIncomingValueForBlock(DBlock));
 }
+
+// Test that a batch walker gives the same answers as the regular one.
+TEST_F(MemorySSATest, BatchWalker) {
+  F = Function::Create(FunctionType::get(B.getVoidTy(), {}, false),
+                       GlobalValue::ExternalLinkage, "F", &M);
+  B.SetInsertPoint(BasicBlock::Create(C, "", F));
+  Type *Int8 = Type::getInt8Ty(C);
+  Value *A = B.CreateAlloca(Int8, ConstantInt::get(Int8, 1), "A");
+  Value *Bp = B.CreateAlloca(Int8, ConstantInt::get(Int8, 1), "B");
+  StoreInst *SA1 = B.CreateStore(ConstantInt::get(Int8, 0), A);
+  StoreInst *SB1 = B.CreateStore(ConstantInt::get(Int8, 1), Bp);
+  StoreInst *SA2 = B.CreateStore(ConstantInt::get(Int8, 2), A);
+  StoreInst *SB2 = B.CreateStore(ConstantInt::get(Int8, 3), Bp);
+  LoadInst *LA = B.CreateLoad(Int8, A);
+
+  setupAnalyses();
+  MemorySSA &MSSA = *Analyses->MSSA;
+  BatchAAResults BatchAA(Analyses->AA);
+  std::unique_ptr<MemorySSAWalker> Walker = MSSA.getBatchWalker(BatchAA);
+
+  EXPECT_EQ(Walker->getClobberingMemoryAccess(SA2), MSSA.getMemoryAccess(SA1));
+  EXPECT_EQ(Walker->getClobberingMemoryAccess(SB2), MSSA.getMemoryAccess(SB1));
+  EXPECT_EQ(Walker->getClobberingMemoryAccess(LA), MSSA.getMemoryAccess(SA2));
+  for (Instruction *I : {cast<Instruction>(SA1), cast<Instruction>(SB1),
+                         cast<Instruction>(SA2), cast<Instruction>(SB2),
+                         cast<Instruction>(LA)})
+    EXPECT_EQ(Walker->getClobberingMemoryAccess(I),
+              Analyses->Walker->getClobberingMemoryAccess(I));
+}
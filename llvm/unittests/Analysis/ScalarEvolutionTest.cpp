@@ -1678,5 +1678,43 @@ TEST_F(ScalarEvolutionsTest, SCEVExpanderShlNSW) {
                "} ");
 }
 
+TEST_F(ScalarEvolutionsTest, CostBudget) {
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(
+      "define void @f(i32 %n) { "
+      "entry: "
+      "  br label %loop "
+      "loop: "
+      "  %i = phi i32 [ 0, %entry ], [ %i.inc, %loop ] "
+      "  %i.inc = add nuw nsw i32 %i, 1 "
+      "  %cond = icmp ult i32 %i.inc, 100 "
+      "  br i1 %cond, label %loop, label %exit "
+      "exit: "
+      "  ret void "
+      "} ",
+      Err, C);
+  ASSERT_TRUE(M && "Could not parse module?");
+
+  // Without a budget, both the IV and the trip count are analyzable.
+  runWithSE(*M, "f", [&](Function &F, LoopInfo &LI, ScalarEvolution &SE) {
+    auto *I = getInstructionByName(F, "i");
+    const Loop *L = LI.getLoopFor(I->getParent());
+    EXPECT_TRUE(isa<SCEVAddRecExpr>(SE.getSCEV(I)));
+    EXPECT_TRUE(isa<SCEVConstant>(SE.getBackedgeTakenCount(L)));
+    EXPECT_GT(SE.getCost(), 0u);
+  });
+
+  // Once the budget is spent, queries give up instead of doing more work.
+  runWithSE(*M, "f", [&](Function &F, LoopInfo &LI, ScalarEvolution &SE) {
+    SE.setCostBudget(1);
+    auto *I = getInstructionByName(F, "i");
+    const Loop *L = LI.getLoopFor(I->getParent());
+    EXPECT_FALSE(isa<SCEVAddRecExpr>(SE.getSCEV(I)));
+    EXPECT_TRUE(isa<SCEVCouldNotCompute>(SE.getBackedgeTakenCount(L)));
+    EXPECT_EQ(SE.getCost(), 1u);
+  });
+}
+
 }  // end anonymous namespace
 }  // end namespace llvm
@@ -0,0 +1,117 @@
+//===--------- LLJITTest.cpp - Unit tests for LLJIT and LLJITBuilder ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "OrcTestCommon.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "gtest/gtest.h"
+
+#include <mutex>
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class LLJITExecutionTest : public testing::Test, public OrcExecutionTest {};
+
+// Keeps a copy of every compiled object, keyed by module identifier. The
+// default compilers may call it from several compile threads.
+class TestObjectCache : public ObjectCache {
+public:
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    ++NumCompiled;
+    Objects[M->getModuleIdentifier()] =
+        MemoryBuffer::getMemBufferCopy(Obj.getBuffer());
+  }
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    auto I = Objects.find(M->getModuleIdentifier());
+    if (I == Objects.end())
+      return nullptr;
+    ++NumHits;
+    return MemoryBuffer::getMemBufferCopy(I->second->getBuffer());
+  }
+
+  unsigned NumCompiled = 0;
+  unsigned NumHits = 0;
+
+private:
+  std::mutex CacheMutex;
+  StringMap<std::unique_ptr<MemoryBuffer>> Objects;
+};
+
+// Returns a module named Name holding "int f() { return RetVal; }".
+ThreadSafeModule createModule(const TargetMachine &TM, StringRef Name,
+                              int RetVal) {
+  auto Ctx = llvm::make_unique<LLVMContext>();
+  ModuleBuilder MB(*Ctx, TM.getTargetTriple().str(), Name);
+  MB.getModule()->setDataLayout(TM.createDataLayout());
+  Function *F = MB.createFunctionDecl(
+      FunctionType::get(Type::getInt32Ty(*Ctx), {}, false), "f");
+  IRBuilder<> B(BasicBlock::Create(*Ctx, "entry", F));
+  B.CreateRet(ConstantInt::get(Type::getInt32Ty(*Ctx), RetVal));
+  return ThreadSafeModule(MB.takeModule(), std::move(Ctx));
+}
+
+// Adds TSM to a new JIT that uses Cache, and runs its f().
+int runWithCache(ObjectCache &Cache, unsigned NumCompileThreads,
+                 ThreadSafeModule TSM) {
+  auto J = cantFail(LLJITBuilder()
+                        .setObjectCache(&Cache)
+                        .setNumCompileThreads(NumCompileThreads)
+                        .create());
+  cantFail(J->addIRModule(std::move(TSM)));
+  auto F = cantFail(J->lookup("f"));
+  return ((int (*)())F.getAddress())();
+}
+
+void testObjectCache(const TargetMachine &TM, unsigned NumCompileThreads) {
+  TestObjectCache Cache;
+
+  // A module that isn't cached yet is compiled, and the cache is told.
+  EXPECT_EQ(runWithCache(Cache, NumCompileThreads,
+                         createModule(TM, "cached", 42)),
+            42);
+  EXPECT_EQ(Cache.NumCompiled, 1U);
+  EXPECT_EQ(Cache.NumHits, 0U);
+
+  // A module with the same identifier is taken from the cache without being
+  // compiled, so the old body runs.
+  EXPECT_EQ(runWithCache(Cache, NumCompileThreads,
+                         createModule(TM, "cached", 7)),
+            42);
+  EXPECT_EQ(Cache.NumCompiled, 1U);
+  EXPECT_EQ(Cache.NumHits, 1U);
+
+  // Other modules are still compiled.
+  EXPECT_EQ(runWithCache(Cache, NumCompileThreads,
+                         createModule(TM, "uncached", 7)),
+            7);
+  EXPECT_EQ(Cache.NumCompiled, 2U);
+  EXPECT_EQ(Cache.NumHits, 1U);
+}
+
+TEST_F(LLJITExecutionTest, ObjectCache) {
+  if (!SupportsJIT)
+    return;
+  testObjectCache(*TM, /*NumCompileThreads=*/0);
+}
+
+TEST_F(LLJITExecutionTest, ObjectCacheWithCompileThreads) {
+  if (!SupportsJIT)
+    return;
+  testObjectCache(*TM, /*NumCompileThreads=*/2);
+}
+
+} // namespace
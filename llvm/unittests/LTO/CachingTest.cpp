@@ -0,0 +1,103 @@
+//===- CachingTest.cpp - Unit tests for the ThinLTO cache -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/LTO/Caching.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "gtest/gtest.h"
+#include <map>
+
+using namespace llvm;
+using namespace llvm::lto;
+
+namespace {
+
+class LTOCachingTest : public testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(sys::fs::createUniqueDirectory("lto-cache-test", CacheDir));
+  }
+
+  void TearDown() override { sys::fs::remove_directories(CacheDir); }
+
+  NativeObjectCache createCache(RemoteCache Remote) {
+    AddBufferFn AddBuffer = [&](unsigned Task,
+                                std::unique_ptr<MemoryBuffer> MB) {
+      Added[Task] = MB->getBuffer();
+    };
+    Expected<NativeObjectCache> Cache =
+        localCache(CacheDir, AddBuffer, std::move(Remote));
+    EXPECT_TRUE(bool(Cache));
+    if (!Cache) {
+      consumeError(Cache.takeError());
+      return nullptr;
+    }
+    return std::move(*Cache);
+  }
+
+  SmallString<128> CacheDir;
+  std::map<unsigned, std::string> Added;
+};
+
+TEST_F(LTOCachingTest, RemoteHitIsCopiedToLocalCache) {
+  unsigned Fetches = 0;
+  RemoteCache Remote;
+  Remote.Fetch = [&](StringRef Key) -> std::unique_ptr<MemoryBuffer> {
+    ++Fetches;
+    EXPECT_EQ("0123abcd", Key);
+    return MemoryBuffer::getMemBufferCopy("remote object");
+  };
+  Remote.Store = [](StringRef, MemoryBufferRef) {
+    ADD_FAILURE() << "a remote hit must not be stored again";
+  };
+  NativeObjectCache Cache = createCache(std::move(Remote));
+  ASSERT_TRUE(bool(Cache));
+
+  // A miss in the local directory is served by the remote cache.
+  EXPECT_FALSE(Cache(0, "0123abcd"));
+  EXPECT_EQ(1u, Fetches);
+  EXPECT_EQ("remote object", Added[0]);
+
+  // The fetched object was added to the local cache directory, so the next
+  // lookup doesn't go to the remote cache.
+  EXPECT_FALSE(Cache(1, "0123abcd"));
+  EXPECT_EQ(1u, Fetches);
+  EXPECT_EQ("remote object", Added[1]);
+}
+
+TEST_F(LTOCachingTest, CompiledObjectIsStoredRemotely) {
+  std::map<std::string, std::string> Stored;
+  RemoteCache Remote;
+  Remote.Fetch = [](StringRef) -> std::unique_ptr<MemoryBuffer> {
+    return nullptr;
+  };
+  Remote.Store = [&](StringRef Key, MemoryBufferRef Object) {
+    Stored[Key] = Object.getBuffer();
+  };
+  NativeObjectCache Cache = createCache(std::move(Remote));
+  ASSERT_TRUE(bool(Cache));
+
+  // A miss in both caches returns a stream to compile the object into.
+  AddStreamFn AddStream = Cache(0, "4567cdef");
+  ASSERT_TRUE(bool(AddStream));
+  *AddStream(0)->OS << "compiled object";
+
+  // Committing the stream adds the object to the link and publishes it.
+  EXPECT_EQ("compiled object", Added[0]);
+  EXPECT_EQ(1u, Stored.size());
+  EXPECT_EQ("compiled object", Stored["4567cdef"]);
+
+  // The object is now a local hit.
+  EXPECT_FALSE(Cache(1, "4567cdef"));
+  EXPECT_EQ("compiled object", Added[1]);
+  EXPECT_EQ(1u, Stored.size());
+}
+
+} // end anonymous namespace
@@ -65,6 +65,38 @@ TEST(CompressionTest, Zlib) {
   TestZlibCompression(BinaryDataStr, zlib::DefaultCompression);
 }
 
+TEST(CompressionTest, ZlibShards) {
+  std::string Input;
+  for (size_t I = 0; I < 3000; ++I)
+    Input += "abcdefgh"[I % 7 + (I / 100) % 2];
+
+  // Compress three shards independently and concatenate them together with
+  // a zlib header and the combined checksum.
+  StringRef Shards[] = {StringRef(Input).substr(0, 1000),
+                        StringRef(Input).substr(1000, 1000),
+                        StringRef(Input).substr(2000)};
+  SmallString<32> Compressed("\x78\x01");
+  uint32_t Checksum = 1;
+  for (size_t I = 0; I < 3; ++I) {
+    SmallString<32> Out;
+    Error E = zlib::compressShard(Shards[I], Out, I == 2);
+    EXPECT_FALSE(E);
+    consumeError(std::move(E));
+    Compressed += Out;
+    Checksum = zlib::adler32Combine(Checksum, zlib::adler32(1, Shards[I]),
+                                    Shards[I].size());
+  }
+  EXPECT_EQ(zlib::adler32(1, Input), Checksum);
+  for (int Shift : {24, 16, 8, 0})
+    Compressed.push_back(Checksum >> Shift);
+
+  SmallString<32> Uncompressed;
+  Error E = zlib::uncompress(Compressed, Uncompressed, Input.size());
+  EXPECT_FALSE(E);
+  consumeError(std::move(E));
+  EXPECT_EQ(Input, Uncompressed);
+}
+
 TEST(CompressionTest, ZlibCRC32) {
   EXPECT_EQ(
       0x414FA339U,
@@ -0,0 +1,77 @@
+//===- llvm/unittest/Support/ConcurrentStringSaverTest.cpp ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ConcurrentStringSaver.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(ConcurrentStringSaverTest, Unique) {
+  ConcurrentUniqueStringSaver Saver;
+  std::string Foo = "foo";
+  StringRef S1 = Saver.save(Foo);
+  StringRef S2 = Saver.save(StringRef("foo"));
+  StringRef S3 = Saver.save(Twine("f") + "oo");
+  EXPECT_EQ("foo", S1);
+  EXPECT_NE(Foo.data(), S1.data());
+  EXPECT_EQ(S1.data(), S2.data());
+  EXPECT_EQ(S1.data(), S3.data());
+  EXPECT_EQ('\0', *S1.end());
+
+  StringRef Empty = Saver.save("");
+  EXPECT_TRUE(Empty.empty());
+  EXPECT_EQ(Empty.data(), Saver.save(StringRef()).data());
+  EXPECT_NE(S1.data(), Saver.save("bar").data());
+  EXPECT_EQ(3u, Saver.size());
+}
+
+TEST(ConcurrentStringSaverTest, Growth) {
+  ConcurrentUniqueStringSaver Saver;
+  std::vector<StringRef> Saved;
+  for (unsigned I = 0; I < 10000; ++I)
+    Saved.push_back(Saver.save(std::to_string(I)));
+  EXPECT_EQ(10000u, Saver.size());
+  for (unsigned I = 0; I < 10000; ++I) {
+    EXPECT_EQ(std::to_string(I), Saved[I]);
+    EXPECT_EQ(Saved[I].data(), Saver.save(std::to_string(I)).data());
+  }
+}
+
+// Threads save overlapping sets of strings; every thread must get the same
+// pointer for the same string.
+TEST(ConcurrentStringSaverTest, Threads) {
+  const unsigned NumThreads = 8, NumStrings = 5000;
+  ConcurrentUniqueStringSaver Saver;
+  std::vector<std::vector<const char *>> Results(NumThreads);
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T < NumThreads; ++T)
+    Threads.emplace_back([&, T] {
+      Results[T].resize(NumStrings);
+      for (unsigned I = 0; I < NumStrings; ++I) {
+        // Each thread goes through the strings in a different order.
+        unsigned N = (I * 7 + T * 1013) % NumStrings;
+        Results[T][N] = Saver.save("string" + std::to_string(N)).data();
+      }
+    });
+  for (std::thread &T : Threads)
+    T.join();
+
+  EXPECT_EQ(NumStrings, Saver.size());
+  for (unsigned I = 0; I < NumStrings; ++I) {
+    EXPECT_EQ("string" + std::to_string(I), Results[0][I]);
+    for (unsigned T = 1; T < NumThreads; ++T)
+      EXPECT_EQ(Results[0][I], Results[T][I]);
+  }
+}
+
+} // namespace
@@ -14,6 +14,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
+#include <thread>
 
 using namespace llvm;
 using namespace llvm::sys;
@@ -121,4 +122,45 @@ TEST(FileOutputBuffer, Test) {
   // Clean up.
   ASSERT_NO_ERROR(fs::remove(TestDirectory.str()));
 }
+
+TEST(FileOutputBuffer, ConcurrentRegions) {
+  SmallString<128> TestDirectory;
+  ASSERT_NO_ERROR(
+      fs::createUniqueDirectory("FileOutputBuffer-regions", TestDirectory));
+  SmallString<128> File(TestDirectory);
+  File.append("/file");
+
+  const unsigned NumWriters = 4;
+  const size_t RegionSize = 100000;
+  {
+    Expected<std::unique_ptr<FileOutputBuffer>> BufferOrErr =
+        FileOutputBuffer::create(File, NumWriters * RegionSize);
+    ASSERT_NO_ERROR(errorToErrorCode(BufferOrErr.takeError()));
+    std::unique_ptr<FileOutputBuffer> &Buffer = *BufferOrErr;
+    std::vector<std::thread> Writers;
+    for (unsigned I = 0; I < NumWriters; ++I)
+      Writers.emplace_back([&, I] {
+        raw_region_ostream OS(makeMutableArrayRef(
+            Buffer->getBufferStart() + I * RegionSize, RegionSize));
+        while (OS.tell() < RegionSize)
+          OS << char('a' + I);
+      });
+    for (std::thread &T : Writers)
+      T.join();
+    ASSERT_NO_ERROR(errorToErrorCode(Buffer->commit()));
+  }
+
+  {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+        MemoryBuffer::getFile(File);
+    ASSERT_NO_ERROR(BufOrErr.getError());
+    StringRef Contents = (*BufOrErr)->getBuffer();
+    ASSERT_EQ(NumWriters * RegionSize, Contents.size());
+    for (unsigned I = 0; I < NumWriters; ++I)
+      EXPECT_EQ(std::string(RegionSize, 'a' + I),
+                Contents.substr(I * RegionSize, RegionSize));
+  }
+  ASSERT_NO_ERROR(fs::remove(File.str()));
+  ASSERT_NO_ERROR(fs::remove(TestDirectory.str()));
+}
 } // anonymous namespace
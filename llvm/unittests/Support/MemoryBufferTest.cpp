@@ -88,6 +88,40 @@ TEST_F(MemoryBufferTest, NullTerminator4K) {
   EXPECT_EQ('\0', BufData[4096]);
 }
 
+TEST_F(MemoryBufferTest, getFiles) {
+  // A small file that is read, a large one that is mapped, and a missing one.
+  int SmallFD, LargeFD;
+  SmallString<64> SmallPath, LargePath;
+  sys::fs::createTemporaryFile("MemoryBufferTest_GetFilesSmall", "temp",
+                               SmallFD, SmallPath);
+  FileRemover SmallCleanup(SmallPath);
+  sys::fs::createTemporaryFile("MemoryBufferTest_GetFilesLarge", "temp",
+                               LargeFD, LargePath);
+  FileRemover LargeCleanup(LargePath);
+  {
+    raw_fd_ostream OF(SmallFD, true);
+    OF << "small";
+  }
+  {
+    raw_fd_ostream OF(LargeFD, true);
+    for (int i = 0; i < 60000; ++i)
+      OF << "0123456789";
+  }
+  SmallString<64> MissingPath(SmallPath);
+  MissingPath += ".missing";
+
+  std::vector<std::string> Paths = {SmallPath.str(), LargePath.str(),
+                                    MissingPath.str()};
+  auto Bufs = MemoryBuffer::getFiles(Paths, /*RequiresNullTerminator=*/false);
+  ASSERT_EQ(3u, Bufs.size());
+  ASSERT_TRUE(bool(Bufs[0]));
+  EXPECT_EQ("small", (*Bufs[0])->getBuffer());
+  ASSERT_TRUE(bool(Bufs[1]));
+  EXPECT_EQ(600000u, (*Bufs[1])->getBufferSize());
+  EXPECT_EQ("0123456789", (*Bufs[1])->getBuffer().take_back(10));
+  EXPECT_EQ(std::errc::no_such_file_or_directory, Bufs[2].getError());
+}
+
 TEST_F(MemoryBufferTest, copy) {
   // copy with no name
   OwningBuffer MBC1(MemoryBuffer::getMemBufferCopy(data));
@@ -14,6 +14,7 @@
 #include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
 #include <random>
 
 uint32_t array[1024 * 1024];
@@ -49,4 +50,16 @@ TEST(Parallel, parallel_for) {
   ASSERT_EQ(range[2049], 1u);
 }
 
+TEST(Parallel, nested_for_each) {
+  // Inner loops run in parallel too, and must not deadlock even if every
+  // worker is waiting for an inner loop to finish.
+  std::atomic<unsigned> Count{0};
+  for_each_n(parallel::par, 0, 64, [&](size_t) {
+    for_each_n(parallel::par, 0, 2048, [&](size_t) {
+      for_each_n(parallel::par, 0, 4, [&](size_t) { ++Count; });
+    });
+  });
+  ASSERT_EQ(Count, 64u * 2048u * 4u);
+}
+
 #endif
@@ -0,0 +1,52 @@
+//===- unittests/TimeProfilerTest.cpp - Time profiler tests ---------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+TEST(TimeProfiler, SummaryKey) {
+  EXPECT_EQ("Struct", timeTraceSummaryKey("Struct<int>"));
+  EXPECT_EQ("std::vector::push_back",
+            timeTraceSummaryKey("std::vector<std::pair<int, int>>::push_back"));
+  EXPECT_EQ("operator<", timeTraceSummaryKey("operator<"));
+  EXPECT_EQ("S::operator<<", timeTraceSummaryKey("S<int>::operator<<<char>"));
+  EXPECT_EQ("S::operator->", timeTraceSummaryKey("S<T>::operator->"));
+  EXPECT_EQ("f", timeTraceSummaryKey("f"));
+}
+
+TEST(TimeProfiler, SummaryOnly) {
+  timeTraceProfilerInitialize(/*TimeTraceGranularity=*/0,
+                              /*SummaryLimit=*/1, /*SummaryOnly=*/true);
+  timeTraceProfilerBegin("InstantiateClass", StringRef("S<int>"));
+  timeTraceProfilerEnd();
+  timeTraceProfilerBegin("InstantiateClass", StringRef("S<float>"));
+  timeTraceProfilerEnd();
+  timeTraceProfilerBegin("InstantiateClass", StringRef("T<int>"));
+  timeTraceProfilerEnd();
+
+  SmallString<1024> Buffer;
+  raw_svector_ostream OS(Buffer);
+  timeTraceProfilerWrite(OS);
+  timeTraceProfilerCleanup();
+
+  StringRef Output = Buffer;
+  EXPECT_EQ(StringRef::npos, Output.find("\"name\":\"InstantiateClass\""));
+  EXPECT_NE(StringRef::npos, Output.find("\"name\":\"Total InstantiateClass\""));
+  EXPECT_NE(StringRef::npos,
+            Output.find("\"name\":\"Summary InstantiateClass\""));
+  // Only the most expensive key is written.
+  EXPECT_EQ(1u, Output.count("Summary InstantiateClass"));
+}
+
+} // namespace
@@ -336,6 +336,56 @@ TEST(raw_ostreamTest, FormattedHexBytes) {
             format_bytes_with_ascii_str(B.take_front(12), 0, 7, 1));
 }
 
+TEST(raw_region_ostreamTest, WritesInPlace) {
+  uint8_t Region[8] = {};
+  raw_region_ostream OS(Region);
+  OS << "abc" << 42;
+  EXPECT_EQ(5u, OS.tell());
+  // The region is the stream's buffer, the bytes are there before a flush.
+  EXPECT_EQ("abc42", StringRef(reinterpret_cast<char *>(Region), 5));
+  OS.flush();
+  OS << "xyz";
+  EXPECT_FALSE(OS.overflowed());
+  EXPECT_EQ("abc42xyz", StringRef(reinterpret_cast<char *>(Region), 8));
+}
+
+TEST(raw_region_ostreamTest, Overflow) {
+  uint8_t Region[4] = {};
+  raw_region_ostream OS(Region);
+  OS << "ab" << "cdefgh";
+  OS.write('i');
+  OS << std::string(100, 'j');
+  EXPECT_EQ(109u, OS.tell());
+  EXPECT_TRUE(OS.overflowed());
+  EXPECT_EQ("abcd", StringRef(reinterpret_cast<char *>(Region), 4));
+  EXPECT_EQ("efghi" + std::string(100, 'j'), OS.getOverflow());
+
+  // pwrite can patch across the end of the region.
+  OS.pwrite("XYZ", 3, 2);
+  EXPECT_EQ("abXY", StringRef(reinterpret_cast<char *>(Region), 4));
+  EXPECT_EQ("Zfghi", OS.getOverflow().take_front(5));
+
+  raw_region_ostream Empty(MutableArrayRef<uint8_t>{});
+  Empty << "abc";
+  EXPECT_EQ("abc", Empty.getOverflow());
+}
+
+TEST(raw_region_ostreamTest, LargeWrite) {
+  // A write larger than the remaining space goes past the buffer directly.
+  uint8_t Region[16] = {};
+  std::string Data = "0123456789abcdefghij";
+  {
+    raw_region_ostream OS(Region);
+    OS << 'x';
+    OS.flush();
+    OS << Data;
+    EXPECT_EQ(21u, OS.tell());
+    EXPECT_EQ("fghij", OS.getOverflow());
+  }
+  EXPECT_EQ("x0123456789abcde",
+            StringRef(reinterpret_cast<char *>(Region), 16));
+}
+
 TEST(raw_fd_ostreamTest, multiple_raw_fd_ostream_to_stdout) {
   std::error_code EC;
 
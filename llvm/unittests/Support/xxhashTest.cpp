@@ -8,6 +8,7 @@
 
 #include "llvm/Support/xxhash.h"
 #include "gtest/gtest.h"
+#include <vector>
 
 using namespace llvm;
 
@@ -17,3 +18,53 @@ TEST(xxhashTest, Basic) {
   EXPECT_EQ(0x69196c1b3af0bff9U,
             xxHash64("0123456789abcdefghijklmnopqrstuvwxyz"));
 }
+
+TEST(xxhashTest, xxh3) {
+  EXPECT_EQ(0xab6e5f64077e7d8aU, xxh3_64bits("foo"));
+  EXPECT_EQ(0xd463c860a032d362U, xxh3_64bits("bar"));
+  EXPECT_EQ(0xffb92a87c6306d55U,
+            xxh3_64bits("0123456789abcdefghijklmnopqrstuvwxyz"));
+
+  // Lengths on both sides of each of the implementation's size classes,
+  // checked against the reference XXH3_64bits.
+  std::vector<uint8_t> Data(4096);
+  uint32_t X = 1;
+  for (uint8_t &C : Data) {
+    X = X * 1103515245 + 12345;
+    C = uint8_t(X >> 16);
+  }
+  struct {
+    size_t Len;
+    uint64_t Hash;
+  } Tests[] = {
+      {0, 0x2d06800538d394c2U},
+      {1, 0xe5e62017e96f839cU},
+      {2, 0xe99f8ba75698ec0fU},
+      {3, 0xd3bcc83c6f14e70fU},
+      {4, 0xc7f159f34b126cb4U},
+      {8, 0x0f25a2a1cc43dda2U},
+      {9, 0x1e3be9699baa50cfU},
+      {16, 0x9ec324145cea1dcbU},
+      {17, 0x48f3651d7436310aU},
+      {32, 0x3ecd923442085a0dU},
+      {33, 0x0afebb54eff3a3b5U},
+      {64, 0x7abe508541644d25U},
+      {65, 0xda2a9fa52b7fadf5U},
+      {96, 0x014dbb30ecd7c670U},
+      {97, 0x7b0a9dae42e89ff6U},
+      {128, 0x5d813d42c0005ea8U},
+      {129, 0xc61639b552225575U},
+      {160, 0x1a272864fbc79765U},
+      {240, 0x7d85b8d4f8b10c82U},
+      {241, 0x5c56141c894cd97eU},
+      {512, 0xae0027cc0d8eacd9U},
+      {1024, 0x0551dea22e104ea8U},
+      {1025, 0xdbe2ed3c377d9922U},
+      {2048, 0x0e137a69a82b62c0U},
+      {2049, 0x2ba993b30fe87e40U},
+      {4096, 0x869423345af97371U},
+  };
+  for (const auto &T : Tests)
+    EXPECT_EQ(T.Hash, xxh3_64bits(makeArrayRef(Data.data(), T.Len)))
+        << "length " << T.Len;
+}
@@ -0,0 +1,106 @@
+//===- SplitModuleTest.cpp - Unit tests for SplitModule -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/Utils/SplitModule.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+// Returns the names of the functions defined in each partition of M.
+static std::vector<std::vector<std::string>>
+splitAndCollect(std::unique_ptr<Module> M, unsigned N) {
+  std::vector<std::vector<std::string>> Partitions;
+  SplitModule(std::move(M), N, [&](std::unique_ptr<Module> MPart) {
+    Partitions.emplace_back();
+    for (Function &F : *MPart)
+      if (!F.isDeclaration())
+        Partitions.back().push_back(F.getName());
+  });
+  return Partitions;
+}
+
+static int findPartition(const std::vector<std::vector<std::string>> &Parts,
+                         StringRef Name) {
+  for (size_t I = 0; I < Parts.size(); ++I)
+    if (is_contained(Parts[I], Name))
+      return I;
+  return -1;
+}
+
+TEST(SplitModule, BalancesByInstructionCount) {
+  LLVMContext Ctx;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(R"(
+    define i32 @big(i32 %x) {
+      %a = add i32 %x, 1
+      %b = add i32 %a, 2
+      %c = add i32 %b, 3
+      %d = add i32 %c, 4
+      %e = add i32 %d, 5
+      %f = add i32 %e, 6
+      %g = add i32 %f, 7
+      %h = add i32 %g, 8
+      ret i32 %h
+    }
+    define void @s1() {
+      ret void
+    }
+    define void @s2() {
+      ret void
+    }
+    define void @s3() {
+      ret void
+    }
+    define void @s4() {
+      ret void
+    }
+  )", Err, Ctx);
+  ASSERT_TRUE(M);
+
+  auto Parts = splitAndCollect(std::move(M), 2);
+  ASSERT_EQ(2u, Parts.size());
+  int Big = findPartition(Parts, "big");
+  ASSERT_NE(-1, Big);
+  // The small functions together are cheaper than @big, so they all go to
+  // the other partition.
+  EXPECT_EQ(1u, Parts[Big].size());
+  EXPECT_EQ(4u, Parts[1 - Big].size());
+}
+
+TEST(SplitModule, KeepsCallGraphCyclesTogether) {
+  LLVMContext Ctx;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(R"(
+    define void @r1() {
+      call void @r2()
+      ret void
+    }
+    define void @r2() {
+      call void @r1()
+      ret void
+    }
+    define void @leaf() {
+      ret void
+    }
+  )", Err, Ctx);
+  ASSERT_TRUE(M);
+
+  auto Parts = splitAndCollect(std::move(M), 2);
+  int R1 = findPartition(Parts, "r1");
+  ASSERT_NE(-1, R1);
+  EXPECT_EQ(R1, findPartition(Parts, "r2"));
+  EXPECT_NE(R1, findPartition(Parts, "leaf"));
+}
+
+} // end anonymous namespace
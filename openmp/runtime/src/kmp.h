@@ -2181,8 +2181,8 @@ struct kmp_dephash_entry {
 typedef struct kmp_dephash {
   kmp_dephash_entry_t **buckets;
   size_t size;
-#ifdef KMP_DEBUG
   kmp_uint32 nelements;
+#ifdef KMP_DEBUG
   kmp_uint32 nconflicts;
 #endif
 } kmp_dephash_t;
@@ -0,0 +1,46 @@
+// RUN: %libomp-compile-and-run
+
+// Tests task dependences on many distinct addresses. The dependence hash of
+// the generating task starts with 997 buckets and has to be grown several
+// times while the tasks below are created. Dependences recorded before a
+// resize must still be found afterwards.
+#include <stdio.h>
+#include <omp.h>
+
+#define N 3000
+
+int a[N], b[N];
+
+int main() {
+  int i, errs = 0;
+
+  #pragma omp parallel num_threads(4)
+  #pragma omp single
+  {
+    for (i = 0; i < N; ++i) {
+      #pragma omp task firstprivate(i) depend(out: a[i])
+      a[i] = i;
+    }
+    // These look up the dependences of the tasks created above, after the
+    // hash has been rebuilt.
+    for (i = 0; i < N; ++i) {
+      #pragma omp task firstprivate(i) depend(inout: a[i])
+      a[i] += 1;
+    }
+    for (i = 0; i < N; ++i) {
+      #pragma omp task firstprivate(i) depend(in: a[i])
+      b[i] = a[i];
+    }
+  }
+
+  for (i = 0; i < N; ++i) {
+    if (b[i] != i + 1) {
+      if (errs < 10)
+        printf("Error: b[%d] = %d, expected %d\n", i, b[i], i + 1);
+      errs++;
+    }
+  }
+  if (errs == 0)
+    printf("passed\n");
+  return errs != 0;
+}